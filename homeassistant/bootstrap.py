@@ -15,14 +15,25 @@ from typing import TYPE_CHECKING, Any
 import voluptuous as vol
 import yarl
 
-from homeassistant import config as conf_util, config_entries, core, loader
+from homeassistant import (
+    config as conf_util,
+    config_entries,
+    core,
+    loader,
+    requirements,
+)
 from homeassistant.components import http
 from homeassistant.const import (
     REQUIRED_NEXT_PYTHON_HA_RELEASE,
     REQUIRED_NEXT_PYTHON_VER,
 )
 from homeassistant.exceptions import HomeAssistantError
-from homeassistant.helpers import area_registry, device_registry, entity_registry
+from homeassistant.helpers import (
+    area_registry,
+    device_registry,
+    entity_registry,
+    storage,
+)
 from homeassistant.helpers.dispatcher import async_dispatcher_send
 from homeassistant.helpers.typing import ConfigType
 from homeassistant.setup import (
@@ -47,6 +58,9 @@ ERROR_LOG_FILENAME = "home-assistant.log"
 # hass.data key for logging information.
 DATA_LOGGING = "logging"
 
+# hass.data key for what gated the setup of each integration during startup.
+DATA_SETUP_CRITICAL_PATH = "setup_critical_path"
+
 LOG_SLOW_STARTUP_INTERVAL = 60
 SLOW_STARTUP_CHECK_INTERVAL = 1
 SIGNAL_BOOTSTRAP_INTEGRATONS = "bootstrap_integrations"
@@ -205,6 +219,10 @@ async def async_from_config_dict(
     """
     start = monotonic()
 
+    storage.async_enable_write_batching(hass)
+    await loader.async_setup_manifest_cache(hass)
+    await requirements.async_setup_requirements_cache(hass)
+
     hass.config_entries = config_entries.ConfigEntries(hass, config)
     await hass.config_entries.async_initialize()
 
@@ -446,6 +464,104 @@ async def async_setup_multi_components(
         )
 
 
+@core.callback
+def _async_schedule_setups(
+    hass: core.HomeAssistant,
+    domains: set[str],
+    integration_cache: dict[str, loader.Integration],
+    config: dict[str, Any],
+    priority_domains: set[str],
+) -> dict[str, asyncio.Task[None]]:
+    """Set up each domain as soon as the domains it comes after are done.
+
+    A domain waits for its dependencies and after dependencies that are set
+    up in this run, priority domains only for other priority domains. The
+    components are imported in the executor up front, a few at a time.
+
+    Which domain a setup waited for last and when it was ready and done is
+    stored in DATA_SETUP_CRITICAL_PATH.
+    """
+    start = monotonic()
+    critical_path: dict[str, dict[str, Any]] = hass.data.setdefault(
+        DATA_SETUP_CRITICAL_PATH, {}
+    )
+    done = {domain: asyncio.Event() for domain in domains}
+    import_semaphore = asyncio.Semaphore(MAX_LOAD_CONCURRENTLY)
+    imported = hass.data.setdefault(loader.DATA_COMPONENTS, {})
+
+    async def _async_import(integration: loader.Integration) -> None:
+        """Import a component ahead of its setup."""
+        async with import_semaphore:
+            try:
+                await hass.async_add_executor_job(integration.get_component)
+            except Exception:  # pylint: disable=broad-except
+                # The setup imports it again and reports the error
+                _LOGGER.debug(
+                    "Unable to import %s ahead of setup",
+                    integration.domain,
+                    exc_info=True,
+                )
+
+    async def _async_setup_when_ready(
+        domain: str, import_task: asyncio.Task[None] | None
+    ) -> None:
+        """Set up a domain after the domains it waits for."""
+        waits_for: list[str] = []
+        if (integration := integration_cache.get(domain)) is not None:
+            waits_for = [
+                dep
+                for dep in (*integration.dependencies, *integration.after_dependencies)
+                if dep in done
+                and dep != domain
+                and (domain not in priority_domains or dep in priority_domains)
+            ]
+
+        gated_by = None
+        for dep in waits_for:
+            if not done[dep].is_set():
+                await done[dep].wait()
+                gated_by = dep
+        if import_task is not None:
+            await import_task
+
+        ready = monotonic()
+        try:
+            await async_setup_component(hass, domain, config)
+        except Exception:  # pylint: disable=broad-except
+            _LOGGER.exception(
+                "Error setting up integration %s - received exception", domain
+            )
+        finally:
+            critical_path[domain] = {
+                "gated_by": gated_by,
+                "ready": ready - start,
+                "done": monotonic() - start,
+            }
+            done[domain].set()
+
+    # Priority domains are scheduled and imported first
+    tasks: dict[str, asyncio.Task[None]] = {}
+    for domain in sorted(domains, key=lambda domain: domain not in priority_domains):
+        import_task = None
+        if (
+            integration := integration_cache.get(domain)
+        ) is not None and domain not in imported:
+            import_task = hass.async_create_task(_async_import(integration))
+        tasks[domain] = hass.async_create_task(
+            _async_setup_when_ready(domain, import_task)
+        )
+    return tasks
+
+
+def _critical_path(critical_path: dict[str, dict[str, Any]], domain: str) -> list[str]:
+    """Return the chain of setups that gated the setup of a domain."""
+    path = [domain]
+    while (gated_by := critical_path[path[-1]]["gated_by"]) is not None:
+        path.append(gated_by)
+    path.reverse()
+    return path
+
+
 async def _async_set_up_integrations(
     hass: core.HomeAssistant, config: dict[str, Any]
 ) -> None:
@@ -498,6 +614,9 @@ async def _async_set_up_integrations(
 
     _LOGGER.info("Domains to be set up: %s", domains_to_setup)
 
+    # Check the requirements of all integrations at once
+    await requirements.async_verify_requirements(hass, integration_cache.values())
+
     # Load logging as soon as possible
     if logging_domains := domains_to_setup & LOGGING_INTEGRATIONS:
         _LOGGER.info("Setting up logging: %s", logging_domains)
@@ -538,19 +657,38 @@ async def _async_set_up_integrations(
         area_registry.async_load(hass),
     )
 
-    # Start setup
+    # Start setup, stage 2 domains do not wait for stage 1 to finish but
+    # only for the domains they come after
+    setup_tasks = _async_schedule_setups(
+        hass,
+        stage_1_domains | stage_2_domains,
+        integration_cache,
+        config,
+        stage_1_domains,
+    )
+
     if stage_1_domains:
         _LOGGER.info("Setting up stage 1: %s", stage_1_domains)
         try:
             async with hass.timeout.async_timeout(
                 STAGE_1_TIMEOUT, cool_down=COOLDOWN_TIME
             ):
-                await async_setup_multi_components(hass, stage_1_domains, config)
+                await asyncio.wait([setup_tasks[domain] for domain in stage_1_domains])
         except asyncio.TimeoutError:
             _LOGGER.warning("Setup timed out for stage 1 - moving forward")
 
-    # Enables after dependencies
-    async_set_domains_to_be_loaded(hass, stage_2_domains)
+    # Enables after dependencies once stage 1 is done so stage 1 domains
+    # do not wait for them, the stage 2 domains set up in the meantime
+    # have been marked done already
+    setup_started = hass.data.get(DATA_SETUP, {})
+    async_set_domains_to_be_loaded(
+        hass,
+        {
+            domain
+            for domain in stage_2_domains
+            if domain not in setup_started or not setup_started[domain].done()
+        },
+    )
 
     if stage_2_domains:
         _LOGGER.info("Setting up stage 2: %s", stage_2_domains)
@@ -558,7 +696,7 @@ async def _async_set_up_integrations(
             async with hass.timeout.async_timeout(
                 STAGE_2_TIMEOUT, cool_down=COOLDOWN_TIME
             ):
-                await async_setup_multi_components(hass, stage_2_domains, config)
+                await asyncio.wait(setup_tasks.values())
         except asyncio.TimeoutError:
             _LOGGER.warning("Setup timed out for stage 2 - moving forward")
 
@@ -582,3 +720,15 @@ async def _async_set_up_integrations(
             )
         },
     )
+
+    if critical_path := hass.data[DATA_SETUP_CRITICAL_PATH]:
+        last_domain = max(
+            critical_path, key=lambda domain: critical_path[domain]["done"]
+        )
+        _LOGGER.debug(
+            "Integration setup was gated by: %s",
+            " -> ".join(
+                f"{domain} ({critical_path[domain]['done']:.2f}s)"
+                for domain in _critical_path(critical_path, last_domain)
+            ),
+        )
@@ -22,6 +22,7 @@ from homeassistant.const import (
     URL_API_DISCOVERY_INFO,
     URL_API_ERROR_LOG,
     URL_API_EVENTS,
+    URL_API_METRICS,
     URL_API_SERVICES,
     URL_API_STATES,
     URL_API_STREAM,
@@ -63,6 +64,7 @@ async def async_setup(hass, config):
     hass.http.register_view(APIDomainServicesView)
     hass.http.register_view(APIComponentsView)
     hass.http.register_view(APITemplateView)
+    hass.http.register_view(APIMetricsView)
 
     if DATA_LOGGING in hass.data:
         hass.http.register_view(APIErrorLog)
@@ -103,9 +105,6 @@ class APIEventStream(HomeAssistantView):
 
         async def forward_events(event):
             """Forward events to the open request."""
-            if event.event_type == EVENT_TIME_CHANGED:
-                return
-
             if restrict and event.event_type not in restrict:
                 return
 
@@ -122,7 +121,9 @@ class APIEventStream(HomeAssistantView):
         response.content_type = "text/event-stream"
         await response.prepare(request)
 
-        unsub_stream = hass.bus.async_listen(MATCH_ALL, forward_events)
+        unsub_stream = hass.bus.async_listen(
+            MATCH_ALL, forward_events, exclude_event_types=[EVENT_TIME_CHANGED]
+        )
 
         try:
             _LOGGER.debug("STREAM %s ATTACHED", id(stop_obj))
@@ -420,6 +421,24 @@ class APIErrorLog(HomeAssistantView):
         return web.FileResponse(request.app["hass"].data[DATA_LOGGING])
 
 
+class APIMetricsView(HomeAssistantView):
+    """View to fetch the metrics in the Prometheus text format."""
+
+    url = URL_API_METRICS
+    name = "api:metrics"
+
+    @ha.callback
+    def get(self, request):
+        """Retrieve the metrics, the first call enables all of them."""
+        # pylint: disable=no-self-use
+        if not request["hass_user"].is_admin:
+            raise Unauthorized()
+        return web.Response(
+            body=request.app["hass"].metrics.render_prometheus().encode(),
+            headers={"Content-Type": "text/plain; version=0.0.4; charset=utf-8"},
+        )
+
+
 async def async_services_json(hass):
     """Generate services data to JSONify."""
     descriptions = await async_get_all_descriptions(hass)
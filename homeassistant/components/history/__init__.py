@@ -28,6 +28,7 @@ from homeassistant.helpers.entityfilter import (
     CONF_ENTITY_GLOBS,
     INCLUDE_EXCLUDE_BASE_FILTER_SCHEMA,
 )
+from homeassistant.helpers.json import json_dumps
 import homeassistant.util.dt as dt_util
 
 # mypy: allow-untyped-defs, no-check-untyped-defs
@@ -37,6 +38,13 @@ _LOGGER = logging.getLogger(__name__)
 DOMAIN = "history"
 CONF_ORDER = "use_include_order"
 
+# Number of states per page of the history/history_during_period command
+DEFAULT_PAGE_SIZE = 1000
+MAX_PAGE_SIZE = 10000
+
+# Compact response of per entity columns instead of a list of states
+FORMAT_COLUMNAR = "columnar"
+
 GLOB_TO_SQL_CHARS = {
     42: "%",  # *
     46: "_",  # .
@@ -96,6 +104,8 @@ async def async_setup(hass, config):
 
     use_include_order = conf.get(CONF_ORDER)
 
+    hass.data[DOMAIN] = filters
+
     hass.http.register_view(HistoryPeriodView(filters, use_include_order))
     hass.components.frontend.async_register_built_in_panel(
         "history", "history", "hass:chart-box"
@@ -104,6 +114,7 @@ async def async_setup(hass, config):
         ws_get_statistics_during_period
     )
     hass.components.websocket_api.async_register_command(ws_get_list_statistic_ids)
+    hass.components.websocket_api.async_register_command(ws_get_history_during_period)
 
     return True
 
@@ -177,6 +188,131 @@ async def ws_get_list_statistic_ids(
     connection.send_result(msg["id"], statistic_ids)
 
 
+@websocket_api.websocket_command(
+    {
+        vol.Required("type"): "history/history_during_period",
+        vol.Required("start_time"): str,
+        vol.Optional("end_time"): str,
+        vol.Optional("entity_ids"): [cv.entity_id],
+        vol.Optional("include_start_time_state", default=True): bool,
+        vol.Optional("significant_changes_only", default=True): bool,
+        vol.Optional("minimal_response", default=False): bool,
+        vol.Optional("page_size", default=DEFAULT_PAGE_SIZE): vol.All(
+            vol.Coerce(int), vol.Range(min=1, max=MAX_PAGE_SIZE)
+        ),
+        vol.Optional("after"): {
+            vol.Required("entity_id"): cv.entity_id,
+            vol.Required("last_updated"): str,
+            vol.Required("state_id"): int,
+        },
+    }
+)
+@websocket_api.async_response
+async def ws_get_history_during_period(
+    hass: HomeAssistant, connection: websocket_api.ActiveConnection, msg: dict
+) -> None:
+    """Fetch one page of history.
+
+    The result holds the states of the page by entity id and the position
+    to pass as after to fetch the next page, or None on the last page. The
+    states at the start time are all on the first page.
+    """
+    start_time = dt_util.parse_datetime(msg["start_time"])
+    if start_time:
+        start_time = dt_util.as_utc(start_time)
+    else:
+        connection.send_error(msg["id"], "invalid_start_time", "Invalid start_time")
+        return
+
+    if end_time_str := msg.get("end_time"):
+        end_time = dt_util.parse_datetime(end_time_str)
+        if end_time:
+            end_time = dt_util.as_utc(end_time)
+        else:
+            connection.send_error(msg["id"], "invalid_end_time", "Invalid end_time")
+            return
+    else:
+        end_time = None
+
+    after = None
+    if after_msg := msg.get("after"):
+        after_last_updated = dt_util.parse_datetime(after_msg["last_updated"])
+        if after_last_updated is None:
+            connection.send_error(msg["id"], "invalid_after", "Invalid after")
+            return
+        after = (
+            after_msg["entity_id"],
+            dt_util.as_utc(after_last_updated),
+            after_msg["state_id"],
+        )
+
+    connection.send_result(
+        msg["id"],
+        await hass.async_add_executor_job(
+            _history_page,
+            hass,
+            start_time,
+            end_time,
+            msg.get("entity_ids"),
+            hass.data[DOMAIN],
+            msg["include_start_time_state"],
+            msg["significant_changes_only"],
+            msg["minimal_response"],
+            msg["page_size"],
+            after,
+        ),
+    )
+
+
+def _history_page(
+    hass,
+    start_time,
+    end_time,
+    entity_ids,
+    filters,
+    include_start_time_state,
+    significant_changes_only,
+    minimal_response,
+    page_size,
+    after,
+):
+    """Collect one page of history from the stream."""
+    states: dict[str, list] = {}
+    count = 0
+    next_page = None
+    with session_scope(hass=hass, read_only=True) as session:
+        stream = history.stream_significant_states_with_session(
+            hass,
+            session,
+            start_time,
+            end_time,
+            entity_ids,
+            filters,
+            include_start_time_state,
+            significant_changes_only,
+            minimal_response,
+            chunk_size=page_size,
+            after=after,
+            start_states_first=True,
+        )
+        for entity_id, chunk, position in stream:
+            states.setdefault(entity_id, []).extend(chunk)
+            count += len(chunk)
+            last_updated, state_id = position
+            # A page can only end after a row to resume the stream after
+            if count >= page_size and last_updated is not None:
+                next_page = {
+                    "entity_id": entity_id,
+                    "last_updated": history_models.process_timestamp_to_utc_isoformat(
+                        last_updated
+                    ),
+                    "state_id": state_id,
+                }
+                break
+
+    return {"states": states, "next": next_page}
+
+
 class HistoryPeriodView(HomeAssistantView):
     """Handle history period requests."""
 
@@ -191,7 +327,7 @@ class HistoryPeriodView(HomeAssistantView):
 
     async def get(
         self, request: web.Request, datetime: str | None = None
-    ) -> web.Response:
+    ) -> web.StreamResponse:
         """Return history over a period of time."""
         datetime_ = None
         if datetime:
@@ -231,6 +367,10 @@ class HistoryPeriodView(HomeAssistantView):
 
         minimal_response = "minimal_response" in request.query
 
+        response_format = request.query.get("format")
+        if response_format not in (None, FORMAT_COLUMNAR):
+            return self.json_message("Invalid format", HTTPStatus.BAD_REQUEST)
+
         hass = request.app["hass"]
 
         if (
@@ -240,6 +380,36 @@ class HistoryPeriodView(HomeAssistantView):
         ):
             return self.json([])
 
+        if response_format == FORMAT_COLUMNAR:
+            return cast(
+                web.Response,
+                await hass.async_add_executor_job(
+                    self._columnar_significant_states_json,
+                    hass,
+                    start_time,
+                    end_time,
+                    entity_ids,
+                    include_start_time_state,
+                    significant_changes_only,
+                    minimal_response,
+                ),
+            )
+
+        if "stream" in request.query:
+            # Write the states while they are read instead of
+            # holding the whole response in memory
+            return await self.async_stream_json(
+                request,
+                self._stream_significant_states_json,
+                hass,
+                start_time,
+                end_time,
+                entity_ids,
+                include_start_time_state,
+                significant_changes_only,
+                minimal_response,
+            )
+
         return cast(
             web.Response,
             await hass.async_add_executor_job(
@@ -267,7 +437,7 @@ class HistoryPeriodView(HomeAssistantView):
         """Fetch significant stats from the database as json."""
         timer_start = time.perf_counter()
 
-        with session_scope(hass=hass) as session:
+        with session_scope(hass=hass, read_only=True) as session:
             result = history.get_significant_states_with_session(
                 hass,
                 session,
@@ -300,6 +470,100 @@ class HistoryPeriodView(HomeAssistantView):
 
         return self.json(result)
 
+    def _columnar_significant_states_json(
+        self,
+        hass,
+        start_time,
+        end_time,
+        entity_ids,
+        include_start_time_state,
+        significant_changes_only,
+        minimal_response,
+    ):
+        """Fetch significant states from the database as columnar json."""
+        timer_start = time.perf_counter()
+
+        with session_scope(hass=hass, read_only=True) as session:
+            result = history.get_significant_states_columnar_with_session(
+                hass,
+                session,
+                start_time,
+                end_time,
+                entity_ids,
+                self.filters,
+                include_start_time_state,
+                significant_changes_only,
+                minimal_response,
+            )
+
+        if _LOGGER.isEnabledFor(logging.DEBUG):
+            elapsed = time.perf_counter() - timer_start
+            _LOGGER.debug(
+                "Extracted columns of %d entities in %fs", len(result), elapsed
+            )
+
+        # Optionally reorder the result to respect the ordering given
+        # by any entities explicitly included in the configuration.
+        if self.filters and self.use_include_order:
+            result = {
+                **{
+                    order_entity: result[order_entity]
+                    for order_entity in self.filters.included_entities
+                    if order_entity in result
+                },
+                **result,
+            }
+
+        return self.json(result)
+
+    def _stream_significant_states_json(
+        self,
+        writer,
+        hass,
+        start_time,
+        end_time,
+        entity_ids,
+        include_start_time_state,
+        significant_changes_only,
+        minimal_response,
+    ):
+        """Write significant states from the database to a stream.
+
+        The response has the same shape as the regular one but entities
+        are ordered by entity_id.
+        """
+        timer_start = time.perf_counter()
+        writer.write("[")
+        count = 0
+        current_entity_id = None
+
+        with session_scope(hass=hass, read_only=True) as session:
+            for entity_id, states, _ in history.stream_significant_states_with_session(
+                hass,
+                session,
+                start_time,
+                end_time,
+                entity_ids,
+                self.filters,
+                include_start_time_state,
+                significant_changes_only,
+                minimal_response,
+            ):
+                if entity_id != current_entity_id:
+                    writer.write("[" if current_entity_id is None else "],[")
+                    current_entity_id = entity_id
+                else:
+                    writer.write(",")
+                # Strip the brackets so chunks join into one array per entity
+                writer.write(json_dumps(states, allow_nan=False)[1:-1])
+                count += len(states)
+
+        writer.write("]" if current_entity_id is None else "]]")
+
+        if _LOGGER.isEnabledFor(logging.DEBUG):
+            elapsed = time.perf_counter() - timer_start
+            _LOGGER.debug("Streamed %d states in %fs", count, elapsed)
+
 
 def sqlalchemy_filter_from_include_exclude_conf(conf):
     """Build a sql filter from config."""
@@ -363,23 +627,29 @@ class Filters:
 
         baked_query += lambda q: q.filter(self.entity_filter())
 
-    def entity_filter(self):
-        """Generate the entity filter query."""
+    def entity_filter(self, table=None):
+        """Generate the entity filter query.
+
+        The columns of the states table are used unless a table with
+        domain and entity_id columns is given.
+        """
+        if table is None:
+            table = history_models.States
         includes = []
         if self.included_domains:
-            includes.append(history_models.States.domain.in_(self.included_domains))
+            includes.append(table.domain.in_(self.included_domains))
         if self.included_entities:
-            includes.append(history_models.States.entity_id.in_(self.included_entities))
+            includes.append(table.entity_id.in_(self.included_entities))
         for glob in self.included_entity_globs:
-            includes.append(_glob_to_like(glob))
+            includes.append(_glob_to_like(glob, table))
 
         excludes = []
         if self.excluded_domains:
-            excludes.append(history_models.States.domain.in_(self.excluded_domains))
+            excludes.append(table.domain.in_(self.excluded_domains))
         if self.excluded_entities:
-            excludes.append(history_models.States.entity_id.in_(self.excluded_entities))
+            excludes.append(table.entity_id.in_(self.excluded_entities))
         for glob in self.excluded_entity_globs:
-            excludes.append(_glob_to_like(glob))
+            excludes.append(_glob_to_like(glob, table))
 
         if not includes and not excludes:
             return None
@@ -393,9 +663,9 @@ class Filters:
         return or_(*includes) & not_(or_(*excludes))
 
 
-def _glob_to_like(glob_str):
+def _glob_to_like(glob_str, table):
     """Translate glob to sql."""
-    return history_models.States.entity_id.like(glob_str.translate(GLOB_TO_SQL_CHARS))
+    return table.entity_id.like(glob_str.translate(GLOB_TO_SQL_CHARS))
 
 
 def _entities_may_have_state_changes_after(
@@ -4,11 +4,10 @@ from __future__ import annotations
 import asyncio
 from collections.abc import Awaitable, Callable
 from http import HTTPStatus
-import json
 import logging
 from typing import Any
 
-from aiohttp import web
+from aiohttp import hdrs, web
 from aiohttp.typedefs import LooseHeaders
 from aiohttp.web_exceptions import (
     HTTPBadRequest,
@@ -21,12 +20,15 @@ import voluptuous as vol
 from homeassistant import exceptions
 from homeassistant.const import CONTENT_TYPE_JSON, HTTP_OK
 from homeassistant.core import Context, is_callback
-from homeassistant.helpers.json import JSONEncoder
+from homeassistant.helpers.json import json_dumps
 
 from .const import KEY_AUTHENTICATED, KEY_HASS
 
 _LOGGER = logging.getLogger(__name__)
 
+# Bytes of JSON to collect before writing them to a streamed response
+STREAM_WRITE_SIZE = 65536
+
 
 class HomeAssistantView:
     """Base view for all views."""
@@ -54,7 +56,7 @@ class HomeAssistantView:
     ) -> web.Response:
         """Return a JSON response."""
         try:
-            msg = json.dumps(result, cls=JSONEncoder, allow_nan=False).encode("UTF-8")
+            msg = json_dumps(result, allow_nan=False).encode("UTF-8")
         except (ValueError, TypeError) as err:
             _LOGGER.error("Unable to serialize to JSON: %s\n%s", err, result)
             raise HTTPInternalServerError from err
@@ -67,6 +69,32 @@ class HomeAssistantView:
         response.enable_compression()
         return response
 
+    @staticmethod
+    async def async_stream_json(
+        request: web.Request, write_json: Callable[..., None], *args: Any
+    ) -> web.StreamResponse:
+        """Stream JSON to a response while it is generated in the executor.
+
+        write_json is called with a JSONStreamWriter followed by args and
+        writes the JSON to it in parts. When write_json raises, the
+        connection is dropped. Ending the body normally would make the
+        JSON written so far look complete, while the unterminated chunked
+        response shows the client that it was cut off.
+        """
+        hass = request.app[KEY_HASS]
+        response = web.StreamResponse(headers={hdrs.CONTENT_TYPE: CONTENT_TYPE_JSON})
+        response.enable_compression()
+        await response.prepare(request)
+        writer = JSONStreamWriter(hass.loop, response)
+        try:
+            await hass.async_add_executor_job(writer.run, write_json, *args)
+        except Exception:
+            if (transport := request.transport) is not None:
+                transport.abort()
+            raise
+        await response.write_eof()
+        return response
+
     def json_message(
         self,
         message: str,
@@ -104,6 +132,42 @@ class HomeAssistantView:
             app["allow_cors"](route)
 
 
+class JSONStreamWriter:
+    """Collect JSON generated in the executor and write it to a response."""
+
+    def __init__(
+        self, loop: asyncio.AbstractEventLoop, response: web.StreamResponse
+    ) -> None:
+        """Initialize the writer."""
+        self._loop = loop
+        self._response = response
+        self._parts: list[str] = []
+        self._size = 0
+
+    def run(self, write_json: Callable[..., None], *args: Any) -> None:
+        """Call write_json with the writer and write what is left."""
+        write_json(self, *args)
+        self.flush()
+
+    def write(self, data: str) -> None:
+        """Add JSON to the response, it is written once enough is collected."""
+        self._parts.append(data)
+        self._size += len(data)
+        if self._size >= STREAM_WRITE_SIZE:
+            self.flush()
+
+    def flush(self) -> None:
+        """Wait for the event loop to write the collected JSON."""
+        if not self._parts:
+            return
+        data = "".join(self._parts).encode("UTF-8")
+        self._parts.clear()
+        self._size = 0
+        asyncio.run_coroutine_threadsafe(
+            self._response.write(data), self._loop
+        ).result()
+
+
 def request_handler_factory(
     view: HomeAssistantView, handler: Callable
 ) -> Callable[[web.Request], Awaitable[web.StreamResponse]]:
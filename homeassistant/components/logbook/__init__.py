@@ -3,7 +3,6 @@ from contextlib import suppress
 from datetime import timedelta
 from http import HTTPStatus
 from itertools import groupby
-import json
 import re
 
 import sqlalchemy
@@ -14,9 +13,14 @@ import voluptuous as vol
 from homeassistant.components.automation import EVENT_AUTOMATION_TRIGGERED
 from homeassistant.components.history import sqlalchemy_filter_from_include_exclude_conf
 from homeassistant.components.http import HomeAssistantView
+from homeassistant.components.recorder.const import DATA_INSTANCE
+from homeassistant.components.recorder.logbook_states import CONTINUOUS_DOMAINS
 from homeassistant.components.recorder.models import (
     Events,
+    LogbookStates,
+    StateAttributes,
     States,
+    process_timestamp,
     process_timestamp_to_utc_isoformat,
 )
 from homeassistant.components.recorder.util import session_scope
@@ -45,6 +49,7 @@ from homeassistant.helpers.entityfilter import (
 from homeassistant.helpers.integration_platform import (
     async_process_integration_platforms,
 )
+from homeassistant.helpers.json import json_dumps, json_loads
 from homeassistant.loader import bind_hass
 import homeassistant.util.dt as dt_util
 
@@ -54,8 +59,6 @@ DOMAIN_JSON_EXTRACT = re.compile('"domain": ?"([^"]+)"')
 ICON_JSON_EXTRACT = re.compile('"icon": ?"([^"]+)"')
 ATTR_MESSAGE = "message"
 
-CONTINUOUS_DOMAINS = ["proximity", "sensor"]
-
 DOMAIN = "logbook"
 
 GROUP_BY_MINUTES = 15
@@ -94,6 +97,19 @@ EVENT_COLUMNS = [
     Events.context_parent_id,
 ]
 
+LOGBOOK_STATES_COLUMNS = [
+    literal(value=EVENT_STATE_CHANGED, type_=sqlalchemy.String).label("event_type"),
+    literal(value=EMPTY_JSON_OBJECT, type_=sqlalchemy.Text).label("event_data"),
+    LogbookStates.time_fired,
+    LogbookStates.context_id,
+    LogbookStates.context_user_id,
+    LogbookStates.context_parent_id,
+    LogbookStates.state,
+    LogbookStates.entity_id,
+    LogbookStates.domain,
+    LogbookStates.attributes,
+]
+
 SCRIPT_AUTOMATION_EVENTS = [EVENT_AUTOMATION_TRIGGERED, EVENT_SCRIPT_STARTED]
 
 LOG_MESSAGE_SCHEMA = vol.Schema(
@@ -238,24 +254,40 @@ class LogbookView(HomeAssistantView):
                 "Can't combine entity with context_id", HTTPStatus.BAD_REQUEST
             )
 
+        events_args = (
+            hass,
+            start_day,
+            end_day,
+            entity_ids,
+            self.filters,
+            self.entities_filter,
+            entity_matches_only,
+            context_id,
+        )
+
+        if "stream" in request.query:
+            # Write the entries while they are read instead of
+            # holding the whole response in memory
+            return await self.async_stream_json(request, _stream_events_json, *events_args)
+
         def json_events():
             """Fetch events and generate JSON."""
-            return self.json(
-                _get_events(
-                    hass,
-                    start_day,
-                    end_day,
-                    entity_ids,
-                    self.filters,
-                    self.entities_filter,
-                    entity_matches_only,
-                    context_id,
-                )
-            )
+            return self.json(_get_events(*events_args))
 
         return await hass.async_add_executor_job(json_events)
 
 
+def _stream_events_json(writer, hass, *args):
+    """Write the logbook entries from the database to a stream."""
+    writer.write("[")
+    with session_scope(hass=hass, read_only=True) as session:
+        for count, entry in enumerate(_iter_events(hass, session, *args)):
+            if count:
+                writer.write(",")
+            writer.write(json_dumps(entry, allow_nan=False))
+    writer.write("]")
+
+
 def humanify(hass, events, entity_attr_cache, context_lookup):
     """Generate a converted list of events into Entry objects.
 
@@ -421,6 +453,34 @@ def _get_events(
     context_id=None,
 ):
     """Get events for a period of time."""
+    with session_scope(hass=hass, read_only=True) as session:
+        return list(
+            _iter_events(
+                hass,
+                session,
+                start_day,
+                end_day,
+                entity_ids,
+                filters,
+                entities_filter,
+                entity_matches_only,
+                context_id,
+            )
+        )
+
+
+def _iter_events(
+    hass,
+    session,
+    start_day,
+    end_day,
+    entity_ids,
+    filters,
+    entities_filter,
+    entity_matches_only,
+    context_id,
+):
+    """Yield the logbook entries for a period of time."""
     assert not (
         entity_ids and context_id
     ), "can't pass in both entity_ids and context_id"
@@ -443,47 +503,89 @@ def _get_events(
     if entity_ids is not None:
         entities_filter = generate_filter([], entity_ids, [], [])
 
-    with session_scope(hass=hass) as session:
+    # State changes recorded before the logbook states are read from
+    # the states table
+    logbook_states_since = hass.data[DATA_INSTANCE].logbook_states_since
+    if (
+        logbook_states_since is not None
+        and process_timestamp(start_day) >= logbook_states_since
+    ):
+        query = _generate_logbook_states_events_query(
+            hass, session, start_day, end_day, context_id
+        )
+        if entity_ids is not None and entity_matches_only:
+            # When entity_matches_only is provided, contexts and events that do not
+            # contain the entity_ids are not included in the logbook response.
+            query = _apply_event_entity_id_matchers(query, entity_ids)
+        query = query.union_all(
+            _generate_logbook_states_query(
+                session, start_day, end_day, entity_ids, filters, context_id
+            )
+        )
+    elif entity_ids is not None:
         old_state = aliased(States, name="old_state")
+        query = _generate_events_query_without_states(session)
+        query = _apply_event_time_filter(query, start_day, end_day)
+        query = _apply_event_types_filter(
+            hass, query, ALL_EVENT_TYPES_EXCEPT_STATE_CHANGED
+        )
+        if entity_matches_only:
+            # When entity_matches_only is provided, contexts and events that do not
+            # contain the entity_ids are not included in the logbook response.
+            query = _apply_event_entity_id_matchers(query, entity_ids)
 
-        if entity_ids is not None:
-            query = _generate_events_query_without_states(session)
-            query = _apply_event_time_filter(query, start_day, end_day)
-            query = _apply_event_types_filter(
-                hass, query, ALL_EVENT_TYPES_EXCEPT_STATE_CHANGED
-            )
-            if entity_matches_only:
-                # When entity_matches_only is provided, contexts and events that do not
-                # contain the entity_ids are not included in the logbook response.
-                query = _apply_event_entity_id_matchers(query, entity_ids)
-
-            query = query.union_all(
-                _generate_states_query(
-                    session, start_day, end_day, old_state, entity_ids
-                )
-            )
-        else:
-            query = _generate_events_query(session)
-            query = _apply_event_time_filter(query, start_day, end_day)
-            query = _apply_events_types_and_states_filter(
-                hass, query, old_state
-            ).filter(
-                (States.last_updated == States.last_changed)
-                | (Events.event_type != EVENT_STATE_CHANGED)
+        query = query.union_all(
+            _generate_states_query(session, start_day, end_day, old_state, entity_ids)
+        )
+    else:
+        old_state = aliased(States, name="old_state")
+        query = _generate_events_query(session)
+        query = _apply_event_time_filter(query, start_day, end_day)
+        query = _apply_events_types_and_states_filter(hass, query, old_state).filter(
+            (States.last_updated == States.last_changed)
+            | (Events.event_type != EVENT_STATE_CHANGED)
+        )
+        if filters:
+            query = query.filter(
+                filters.entity_filter() | (Events.event_type != EVENT_STATE_CHANGED)
             )
-            if filters:
-                query = query.filter(
-                    filters.entity_filter() | (Events.event_type != EVENT_STATE_CHANGED)
-                )
 
-            if context_id is not None:
-                query = query.filter(Events.context_id == context_id)
+        if context_id is not None:
+            query = query.filter(Events.context_id == context_id)
 
-        query = query.order_by(Events.time_fired)
+    query = query.order_by(Events.time_fired)
 
-        return list(
-            humanify(hass, yield_events(query), entity_attr_cache, context_lookup)
-        )
+    yield from humanify(hass, yield_events(query), entity_attr_cache, context_lookup)
+
+
+def _generate_logbook_states_events_query(
+    hass, session, start_day, end_day, context_id
+):
+    """Return the query for the events that are not state changes."""
+    query = _generate_events_query_without_states(session)
+    query = _apply_event_time_filter(query, start_day, end_day)
+    query = _apply_event_types_filter(hass, query, ALL_EVENT_TYPES_EXCEPT_STATE_CHANGED)
+    if context_id is not None:
+        query = query.filter(Events.context_id == context_id)
+    return query
+
+
+def _generate_logbook_states_query(
+    session, start_day, end_day, entity_ids, filters, context_id
+):
+    """Return the query for the state changes recorded for the logbook."""
+    query = session.query(*LOGBOOK_STATES_COLUMNS).filter(
+        (LogbookStates.time_fired > start_day) & (LogbookStates.time_fired < end_day)
+    )
+    if entity_ids is not None:
+        query = query.filter(LogbookStates.entity_id.in_(entity_ids))
+    elif filters:
+        entity_filter = filters.entity_filter(LogbookStates)
+        if entity_filter is not None:
+            query = query.filter(entity_filter)
+    if context_id is not None:
+        query = query.filter(LogbookStates.context_id == context_id)
+    return query
 
 
 def _generate_events_query(session):
@@ -492,7 +594,11 @@ def _generate_events_query(session):
         States.state,
         States.entity_id,
         States.domain,
-        States.attributes,
+        # Rows written since schema version 23 share their attributes
+        # through the state_attributes table
+        sqlalchemy.func.coalesce(
+            States.attributes, StateAttributes.shared_attrs
+        ).label("attributes"),
     )
 
 
@@ -511,6 +617,9 @@ def _generate_states_query(session, start_day, end_day, old_state, entity_ids):
         _generate_events_query(session)
         .outerjoin(Events, (States.event_id == Events.event_id))
         .outerjoin(old_state, (States.old_state_id == old_state.state_id))
+        .outerjoin(
+            StateAttributes, (States.attributes_id == StateAttributes.attributes_id)
+        )
         .filter(_missing_state_matcher(old_state))
         .filter(_continuous_entity_matcher())
         .filter((States.last_updated > start_day) & (States.last_updated < end_day))
@@ -525,6 +634,9 @@ def _apply_events_types_and_states_filter(hass, query, old_state):
     events_query = (
         query.outerjoin(States, (Events.event_id == States.event_id))
         .outerjoin(old_state, (States.old_state_id == old_state.state_id))
+        .outerjoin(
+            StateAttributes, (States.attributes_id == StateAttributes.attributes_id)
+        )
         .filter(
             (Events.event_type != EVENT_STATE_CHANGED)
             | _missing_state_matcher(old_state)
@@ -554,7 +666,11 @@ def _continuous_entity_matcher():
     #
     return sqlalchemy.or_(
         sqlalchemy.not_(States.domain.in_(CONTINUOUS_DOMAINS)),
-        sqlalchemy.not_(States.attributes.contains(UNIT_OF_MEASUREMENT_JSON)),
+        sqlalchemy.not_(
+            sqlalchemy.func.coalesce(
+                States.attributes, StateAttributes.shared_attrs
+            ).contains(UNIT_OF_MEASUREMENT_JSON)
+        ),
     )
 
 
@@ -745,7 +861,7 @@ class LazyEventPartialState:
             ):
                 self._attributes = {}
             else:
-                self._attributes = json.loads(self._row.attributes)
+                self._attributes = json_loads(self._row.attributes)
         return self._attributes
 
     @property
@@ -755,7 +871,7 @@ class LazyEventPartialState:
             if self._row.event_data == EMPTY_JSON_OBJECT:
                 self._event_data = {}
             else:
-                self._event_data = json.loads(self._row.event_data)
+                self._event_data = json_loads(self._row.event_data)
         return self._event_data
 
     @property
@@ -90,6 +90,7 @@ DATA_MQTT = "mqtt"
 SERVICE_PUBLISH = "publish"
 SERVICE_DUMP = "dump"
 
+CONF_COALESCE_WINDOW = "coalesce_window"
 CONF_DISCOVERY_PREFIX = "discovery_prefix"
 CONF_KEEPALIVE = "keepalive"
 CONF_CERTIFICATE = "certificate"
@@ -104,6 +105,7 @@ CONF_TOPIC = "topic"
 PROTOCOL_31 = "3.1"
 
 DEFAULT_PORT = 1883
+DEFAULT_COALESCE_WINDOW = 0.0
 DEFAULT_KEEPALIVE = 60
 DEFAULT_PROTOCOL = PROTOCOL_311
 DEFAULT_TLS_PROTOCOL = "auto"
@@ -188,6 +190,11 @@ CONFIG_SCHEMA = vol.Schema(
                         CONF_BIRTH_MESSAGE, default=DEFAULT_BIRTH
                     ): MQTT_WILL_BIRTH_SCHEMA,
                     vol.Optional(CONF_DISCOVERY, default=DEFAULT_DISCOVERY): cv.boolean,
+                    # Seconds to hold messages for subscriptions that only need
+                    # the latest payload of a topic, 0 delivers all messages.
+                    vol.Optional(
+                        CONF_COALESCE_WINDOW, default=DEFAULT_COALESCE_WINDOW
+                    ): vol.All(vol.Coerce(float), vol.Range(min=0, max=5)),
                     # discovery_prefix must be a valid publish topic because if no
                     # state topic is specified, it will be created with the given prefix.
                     vol.Optional(
@@ -329,9 +336,14 @@ async def async_subscribe(
     | AsyncDeprecatedMessageCallbackType,
     qos: int = DEFAULT_QOS,
     encoding: str | None = "utf-8",
+    coalesce: bool = False,
 ):
     """Subscribe to an MQTT topic.
 
+    Set coalesce if the callback only needs the latest message of a topic,
+    a burst of messages is then delivered as the last one when a coalescing
+    window is configured.
+
     Call the return value to unsubscribe.
     """
     # Count callback parameters which don't have a default value
@@ -366,6 +378,8 @@ async def async_subscribe(
         ),
         qos,
         encoding,
+        # Only passed when set so the calls of other subscribers stay the same
+        **({"coalesce": True} if coalesce else {}),
     )
     return async_remove
 
@@ -546,10 +560,10 @@ class Subscription:
     """Class to hold data about an active subscription."""
 
     topic: str = attr.ib()
-    matcher: Any = attr.ib()
     job: HassJob = attr.ib()
     qos: int = attr.ib(default=0)
     encoding: str | None = attr.ib(default="utf-8")
+    coalesce: bool = attr.ib(default=False)
 
 
 class MQTT:
@@ -564,12 +578,25 @@ class MQTT:
         """Initialize Home Assistant MQTT client."""
         # We don't import on the top because some integrations
         # should be able to optionally rely on MQTT.
-        import paho.mqtt.client as mqtt  # pylint: disable=import-outside-toplevel
+        # pylint: disable=import-outside-toplevel
+        import paho.mqtt.client as mqtt
+        from paho.mqtt.matcher import MQTTMatcher
 
         self.hass = hass
         self.config_entry = config_entry
         self.conf = conf
         self.subscriptions: list[Subscription] = []
+        # Subscriptions by topic filter. Most filters are plain topics which
+        # are looked up directly, only the ones with wildcards are matched
+        # through the shared topic trie.
+        self._simple_subscriptions: dict[str, list[Subscription]] = {}
+        self._wildcard_subscriptions = MQTTMatcher()
+        # Latest message for each coalescing subscription and topic, delivered
+        # when the coalescing window ends
+        self._coalesced_messages: dict[
+            tuple[int, str], tuple[Subscription, ReceiveMessage]
+        ] = {}
+        self._coalesce_flush: asyncio.TimerHandle | None = None
         self.connected = False
         self._ha_started = asyncio.Event()
         self._last_subscribe = time.time()
@@ -730,6 +757,7 @@ class MQTT:
             self._mqttc.loop_stop()
 
         await self.hass.async_add_executor_job(stop)
+        self._async_flush_coalesced_messages()
 
     async def async_subscribe(
         self,
@@ -737,6 +765,7 @@ class MQTT:
         msg_callback: MessageCallbackType,
         qos: int,
         encoding: str | None = None,
+        coalesce: bool = False,
     ) -> Callable[[], None]:
         """Set up a subscription to a topic with the provided qos.
 
@@ -746,9 +775,10 @@ class MQTT:
             raise HomeAssistantError("Topic needs to be a string!")
 
         subscription = Subscription(
-            topic, _matcher_for_topic(topic), HassJob(msg_callback), qos, encoding
+            topic, HassJob(msg_callback), qos, encoding, coalesce
         )
         self.subscriptions.append(subscription)
+        self._topic_subscriptions(topic, create=True).append(subscription)
         self._matching_subscriptions.cache_clear()
 
         # Only subscribe if currently connected.
@@ -763,17 +793,48 @@ class MQTT:
                 raise HomeAssistantError("Can't remove subscription twice")
             self.subscriptions.remove(subscription)
             self._matching_subscriptions.cache_clear()
-
-            if any(other.topic == topic for other in self.subscriptions):
+            if subscription.coalesce and self._coalesced_messages:
+                for key in [
+                    key
+                    for key in self._coalesced_messages
+                    if key[0] == id(subscription)
+                ]:
+                    del self._coalesced_messages[key]
+
+            topic_subscriptions = self._topic_subscriptions(topic)
+            topic_subscriptions.remove(subscription)
+            if topic_subscriptions:
                 # Other subscriptions on topic remaining - don't unsubscribe.
                 return
 
+            if _is_wildcard_topic(topic):
+                del self._wildcard_subscriptions[topic]
+            else:
+                del self._simple_subscriptions[topic]
+
             # Only unsubscribe if currently connected.
             if self.connected:
                 self.hass.async_create_task(self._async_unsubscribe(topic))
 
         return async_remove
 
+    def _topic_subscriptions(
+        self, topic: str, create: bool = False
+    ) -> list[Subscription]:
+        """Return the subscriptions to a topic filter."""
+        if not _is_wildcard_topic(topic):
+            if create:
+                return self._simple_subscriptions.setdefault(topic, [])
+            return self._simple_subscriptions[topic]
+        subscriptions: list[Subscription]
+        try:
+            subscriptions = self._wildcard_subscriptions[topic]
+        except KeyError:
+            if not create:
+                raise
+            subscriptions = self._wildcard_subscriptions[topic] = []
+        return subscriptions
+
     async def _async_unsubscribe(self, topic: str) -> None:
         """Unsubscribe from a topic.
 
@@ -857,10 +918,19 @@ class MQTT:
 
     @lru_cache(2048)
     def _matching_subscriptions(self, topic):
-        subscriptions = []
-        for subscription in self.subscriptions:
-            if subscription.matcher(topic):
-                subscriptions.append(subscription)
+        subscriptions = list(self._simple_subscriptions.get(topic, ()))
+        sources = 1 if subscriptions else 0
+        for wildcard_subscriptions in self._wildcard_subscriptions.iter_match(topic):
+            subscriptions.extend(wildcard_subscriptions)
+            sources += 1
+        if sources > 1:
+            # Run the callbacks in the order the subscriptions were made
+            matching = {id(subscription) for subscription in subscriptions}
+            subscriptions = [
+                subscription
+                for subscription in self.subscriptions
+                if id(subscription) in matching
+            ]
         return subscriptions
 
     @callback
@@ -874,35 +944,68 @@ class MQTT:
         timestamp = dt_util.utcnow()
 
         subscriptions = self._matching_subscriptions(msg.topic)
+        # The payload is decoded once for each encoding, None if it failed
+        decoded_payloads: dict[str, str | None] = {}
+        coalesce_window: float = self.conf.get(CONF_COALESCE_WINDOW, 0)
 
         for subscription in subscriptions:
 
             payload: SubscribePayloadType = msg.payload
-            if subscription.encoding is not None:
-                try:
-                    payload = msg.payload.decode(subscription.encoding)
-                except (AttributeError, UnicodeDecodeError):
+            if (encoding := subscription.encoding) is not None:
+                if encoding not in decoded_payloads:
+                    try:
+                        decoded_payloads[encoding] = msg.payload.decode(encoding)
+                    except (AttributeError, UnicodeDecodeError):
+                        decoded_payloads[encoding] = None
+                if (decoded_payload := decoded_payloads[encoding]) is None:
                     _LOGGER.warning(
                         "Can't decode payload %s on %s with encoding %s (for %s)",
                         msg.payload[0:8192],
                         msg.topic,
-                        subscription.encoding,
+                        encoding,
                         subscription.job,
                     )
                     continue
+                payload = decoded_payload
 
-            self.hass.async_run_hass_job(
-                subscription.job,
-                ReceiveMessage(
-                    msg.topic,
-                    payload,
-                    msg.qos,
-                    msg.retain,
-                    subscription.topic,
-                    timestamp,
-                ),
+            message = ReceiveMessage(
+                msg.topic,
+                payload,
+                msg.qos,
+                msg.retain,
+                subscription.topic,
+                timestamp,
+            )
+            if subscription.coalesce and coalesce_window:
+                self._async_coalesce_message(subscription, message, coalesce_window)
+                continue
+            self.hass.async_run_hass_job(subscription.job, message)
+
+    @callback
+    def _async_coalesce_message(
+        self, subscription: Subscription, msg: ReceiveMessage, window: float
+    ) -> None:
+        """Hold a message until the window ends, it replaces older ones."""
+        key = (id(subscription), msg.topic)
+        # Messages are delivered in the order their latest message arrived
+        self._coalesced_messages.pop(key, None)
+        self._coalesced_messages[key] = (subscription, msg)
+        if self._coalesce_flush is None:
+            self._coalesce_flush = self.hass.loop.call_later(
+                window, self._async_flush_coalesced_messages
             )
 
+    @callback
+    def _async_flush_coalesced_messages(self) -> None:
+        """Deliver the latest message of each coalesced topic."""
+        if self._coalesce_flush is not None:
+            self._coalesce_flush.cancel()
+            self._coalesce_flush = None
+        messages = self._coalesced_messages
+        self._coalesced_messages = {}
+        for subscription, msg in messages.values():
+            self.hass.async_run_hass_job(subscription.job, msg)
+
     def _mqtt_on_callback(self, _mqttc, _userdata, mid, _granted_qos=None) -> None:
         """Publish / Subscribe / Unsubscribe callback."""
         self.hass.add_job(self._mqtt_handle_mid, mid)
@@ -973,14 +1076,9 @@ def _raise_on_error(result_code: int | None) -> None:
         )
 
 
-def _matcher_for_topic(subscription: str) -> Any:
-    # pylint: disable=import-outside-toplevel
-    from paho.mqtt.matcher import MQTTMatcher
-
-    matcher = MQTTMatcher()
-    matcher[subscription] = True
-
-    return lambda topic: next(matcher.iter_match(topic), False)
+def _is_wildcard_topic(topic: str) -> bool:
+    """Return if a topic filter contains wildcards."""
+    return "+" in topic or "#" in topic
 
 
 @websocket_api.websocket_command(
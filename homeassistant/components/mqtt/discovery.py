@@ -65,6 +65,9 @@ MQTT_DISCOVERY_NEW = "mqtt_discovery_new_{}_{}"
 MQTT_DISCOVERY_DONE = "mqtt_discovery_done_{}"
 LAST_DISCOVERY = "mqtt_last_discovery"
 
+# Seconds to collect retained discovery messages before handling them as a batch
+RETAINED_BACKLOG_DELAY = 0.1
+
 TOPIC_BASE = "~"
 
 
@@ -87,10 +90,47 @@ async def async_start(  # noqa: C901
 ) -> None:
     """Start MQTT Discovery."""
     mqtt_integrations = {}
+    # Latest retained config for each discovery hash that is not handled yet
+    retained_backlog = {}
 
     async def async_discovery_message_received(msg):
         """Process the received message."""
         hass.data[LAST_DISCOVERY] = time.time()
+        if (discovery := parse_discovery_message(msg)) is None:
+            return
+
+        component, discovery_id, payload = discovery
+        discovery_hash = (component, discovery_id)
+        if msg.retain:
+            # The retained configs arrive as a backlog after (re)connecting
+            if not retained_backlog:
+                hass.async_create_task(async_process_retained_backlog())
+            retained_backlog[discovery_hash] = payload
+            return
+
+        # A newer config replaces a retained one which is not handled yet
+        retained_backlog.pop(discovery_hash, None)
+        await async_handle_discovery_payload(component, discovery_id, payload)
+
+    async def async_process_retained_backlog():
+        """Handle the retained configs received in a short while as a batch."""
+        await asyncio.sleep(RETAINED_BACKLOG_DELAY)
+
+        # Set up every platform once before the configs are dispatched, so the
+        # configs don't have to wait for each other on the setup lock
+        components = {key[0] for key, payload in retained_backlog.items() if payload}
+        await asyncio.gather(
+            *(async_setup_discovery_platform(component) for component in components)
+        )
+        # The configs stay in the backlog until they are dispatched, so a
+        # config received in the meantime replaces the one of its hash
+        while retained_backlog:
+            discovery_hash = next(iter(retained_backlog))
+            payload = retained_backlog.pop(discovery_hash)
+            await async_handle_discovery_payload(*discovery_hash, payload)
+
+    def parse_discovery_message(msg):
+        """Return the component, discovery id and config of a discovery message."""
         payload = msg.payload
         topic = msg.topic
         topic_trimmed = topic.replace(f"{discovery_topic}/", "", 1)
@@ -101,20 +141,20 @@ async def async_start(  # noqa: C901
                 _LOGGER.warning(
                     "Received message on illegal discovery topic '%s'", topic
                 )
-            return
+            return None
 
         component, node_id, object_id = match.groups()
 
         if component not in SUPPORTED_COMPONENTS:
             _LOGGER.warning("Integration %s is not supported", component)
-            return
+            return None
 
         if payload:
             try:
                 payload = json.loads(payload)
             except ValueError:
                 _LOGGER.warning("Unable to parse JSON %s: '%s'", object_id, payload)
-                return
+                return None
 
         payload = MQTTConfig(payload)
 
@@ -155,6 +195,11 @@ async def async_start(  # noqa: C901
 
             payload[CONF_PLATFORM] = "mqtt"
 
+        return component, discovery_id, payload
+
+    async def async_handle_discovery_payload(component, discovery_id, payload):
+        """Process a discovery config or queue it behind the pending one."""
+        discovery_hash = (component, discovery_id)
         if discovery_hash in hass.data[PENDING_DISCOVERED]:
             pending = hass.data[PENDING_DISCOVERED][discovery_hash]["pending"]
             pending.appendleft(payload)
@@ -210,26 +255,7 @@ async def async_start(  # noqa: C901
             _LOGGER.info("Found new component: %s %s", component, discovery_id)
             hass.data[ALREADY_DISCOVERED][discovery_hash] = None
 
-            config_entries_key = f"{component}.mqtt"
-            async with hass.data[DATA_CONFIG_ENTRY_LOCK]:
-                if config_entries_key not in hass.data[CONFIG_ENTRY_IS_SETUP]:
-                    if component == "device_automation":
-                        # Local import to avoid circular dependencies
-                        # pylint: disable=import-outside-toplevel
-                        from . import device_automation
-
-                        await device_automation.async_setup_entry(hass, config_entry)
-                    elif component == "tag":
-                        # Local import to avoid circular dependencies
-                        # pylint: disable=import-outside-toplevel
-                        from . import tag
-
-                        await tag.async_setup_entry(hass, config_entry)
-                    else:
-                        await hass.config_entries.async_forward_entry_setup(
-                            config_entry, component
-                        )
-                    hass.data[CONFIG_ENTRY_IS_SETUP].add(config_entries_key)
+            await async_setup_discovery_platform(component)
 
             async_dispatcher_send(
                 hass, MQTT_DISCOVERY_NEW.format(component, "mqtt"), payload
@@ -240,6 +266,32 @@ async def async_start(  # noqa: C901
                 hass, MQTT_DISCOVERY_DONE.format(discovery_hash), None
             )
 
+    async def async_setup_discovery_platform(component):
+        """Set up the MQTT platform of a component if not done yet."""
+        config_entries_key = f"{component}.mqtt"
+        if config_entries_key in hass.data[CONFIG_ENTRY_IS_SETUP]:
+            return
+
+        async with hass.data[DATA_CONFIG_ENTRY_LOCK]:
+            if config_entries_key not in hass.data[CONFIG_ENTRY_IS_SETUP]:
+                if component == "device_automation":
+                    # Local import to avoid circular dependencies
+                    # pylint: disable=import-outside-toplevel
+                    from . import device_automation
+
+                    await device_automation.async_setup_entry(hass, config_entry)
+                elif component == "tag":
+                    # Local import to avoid circular dependencies
+                    # pylint: disable=import-outside-toplevel
+                    from . import tag
+
+                    await tag.async_setup_entry(hass, config_entry)
+                else:
+                    await hass.config_entries.async_forward_entry_setup(
+                        config_entry, component
+                    )
+                hass.data[CONFIG_ENTRY_IS_SETUP].add(config_entries_key)
+
     hass.data[DATA_CONFIG_ENTRY_LOCK] = asyncio.Lock()
     hass.data[DATA_CONFIG_FLOW_LOCK] = asyncio.Lock()
     hass.data[CONFIG_ENTRY_IS_SETUP] = set()
@@ -251,6 +251,7 @@ class MqttAttributes(Entity):
                     "topic": self._attributes_config.get(CONF_JSON_ATTRS_TOPIC),
                     "msg_callback": attributes_message_received,
                     "qos": self._attributes_config.get(CONF_QOS),
+                    "coalesce": True,
                 }
             },
         )
@@ -339,6 +340,7 @@ class MqttAvailability(Entity):
                 "topic": topic,
                 "msg_callback": availability_message_received,
                 "qos": self._avail_config[CONF_QOS],
+                "coalesce": True,
             }
             for topic in self._avail_topics
         }
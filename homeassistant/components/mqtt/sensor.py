@@ -227,6 +227,7 @@ class MqttSensor(MqttEntity, SensorEntity):
             "topic": self._config[CONF_STATE_TOPIC],
             "msg_callback": message_received,
             "qos": self._config[CONF_QOS],
+            "coalesce": True,
         }
 
         @callback
@@ -25,6 +25,7 @@ class EntitySubscription:
     unsubscribe_callback: Callable[[], None] | None = attr.ib()
     qos: int = attr.ib(default=0)
     encoding: str = attr.ib(default="utf-8")
+    coalesce: bool = attr.ib(default=False)
 
     async def resubscribe_if_necessary(self, hass, other):
         """Re-subscribe to the new topic if necessary."""
@@ -47,7 +48,12 @@ class EntitySubscription:
         debug_info.add_subscription(self.hass, self.message_callback, self.topic)
 
         self.unsubscribe_callback = await mqtt.async_subscribe(
-            hass, self.topic, self.message_callback, self.qos, self.encoding
+            hass,
+            self.topic,
+            self.message_callback,
+            self.qos,
+            self.encoding,
+            self.coalesce,
         )
 
     def _should_resubscribe(self, other):
@@ -55,10 +61,11 @@ class EntitySubscription:
         if other is None:
             return True
 
-        return (self.topic, self.qos, self.encoding) != (
+        return (self.topic, self.qos, self.encoding, self.coalesce) != (
             other.topic,
             other.qos,
             other.encoding,
+            other.coalesce,
         )
 
 
@@ -87,6 +94,7 @@ async def async_subscribe_topics(
             unsubscribe_callback=None,
             qos=value.get("qos", DEFAULT_QOS),
             encoding=value.get("encoding", "utf-8"),
+            coalesce=value.get("coalesce", False),
             hass=hass,
         )
         # Get the current subscription state
@@ -66,10 +66,6 @@ async def async_setup(hass, config):
         if event.origin != EventOrigin.local:
             return
 
-        # Events to ignore
-        if event.event_type in ignore_event:
-            return
-
         # Filter out the events that were triggered by publishing
         # to the MQTT topic, or you will end up in an infinite loop.
         if (
@@ -86,7 +82,10 @@ async def async_setup(hass, config):
 
     # Only listen for local events if you are going to publish them.
     if pub_topic:
-        hass.bus.async_listen(MATCH_ALL, _event_publisher)
+        # Ignored events are never delivered to the publisher
+        hass.bus.async_listen(
+            MATCH_ALL, _event_publisher, exclude_event_types=ignore_event
+        )
 
     # Process events from a remote server that are received on a queue.
     @callback
@@ -5,6 +5,7 @@ import asyncio
 from collections.abc import Callable
 import concurrent.futures
 from datetime import datetime, timedelta
+from functools import partial
 import logging
 import queue
 import sqlite3
@@ -16,7 +17,7 @@ from sqlalchemy import create_engine, event as sqlalchemy_event, exc, func, sele
 from sqlalchemy.exc import SQLAlchemyError
 from sqlalchemy.orm import scoped_session, sessionmaker
 from sqlalchemy.orm.session import Session
-from sqlalchemy.pool import StaticPool
+from sqlalchemy.pool import QueuePool, StaticPool
 import voluptuous as vol
 
 from homeassistant.components import persistent_notification
@@ -50,17 +51,29 @@ from homeassistant.helpers.typing import ConfigType
 from homeassistant.loader import bind_hass
 import homeassistant.util.dt as dt_util
 
-from . import history, migration, purge, statistics, websocket_api
-from .const import CONF_DB_INTEGRITY_CHECK, DATA_INSTANCE, DOMAIN, SQLITE_URL_PREFIX
+from . import history, migration, partitions, purge, statistics, websocket_api
+from .bulk_insert import BulkInsertWriter, bulk_insert_supported
+from .const import (
+    CONF_DB_INTEGRITY_CHECK,
+    DATA_INSTANCE,
+    DOMAIN,
+    PURGE_SLICE_SECONDS,
+    SQLITE_URL_PREFIX,
+)
+from .logbook_states import get_logbook_states_start, logbook_state_columns
 from .models import (
     Base,
     Events,
+    LogbookStates,
     RecorderRuns,
+    StateAttributes,
     States,
     StatisticsRuns,
     process_timestamp,
 )
-from .pool import RecorderPool
+from .pool import RecorderPool, connect_sqlite_read_only
+from .state_attributes import StateAttributesManager
+from .statistics_states import StatisticsStates
 from .util import (
     dburl_to_path,
     end_incomplete_runs,
@@ -113,6 +126,9 @@ DEFAULT_DB_MAX_RETRIES = 10
 DEFAULT_DB_RETRY_WAIT = 3
 DEFAULT_COMMIT_INTERVAL = 1
 KEEPALIVE_TIME = 30
+# Reads outside the recorder thread that run at once on a separate read
+# connection pool, more reads wait for a connection
+READ_POOL_SIZE = 4
 
 # Controls how often we clean up
 # States and Events objects
@@ -120,12 +136,15 @@ EXPIRE_AFTER_COMMITS = 120
 
 CONF_AUTO_PURGE = "auto_purge"
 CONF_DB_URL = "db_url"
+CONF_DB_READ_URL = "db_read_url"
 CONF_DB_MAX_RETRIES = "db_max_retries"
 CONF_DB_RETRY_WAIT = "db_retry_wait"
 CONF_PURGE_KEEP_DAYS = "purge_keep_days"
 CONF_PURGE_INTERVAL = "purge_interval"
 CONF_EVENT_TYPES = "event_types"
 CONF_COMMIT_INTERVAL = "commit_interval"
+CONF_BULK_INSERT = "bulk_insert"
+CONF_PARTITION_BY_DAY = "partition_by_day"
 
 INVALIDATED_ERR = "Database connection invalidated"
 CONNECTIVITY_ERR = "Error in database connectivity during commit"
@@ -151,6 +170,7 @@ CONFIG_SCHEMA = vol.Schema(
                     ),
                     vol.Optional(CONF_PURGE_INTERVAL, default=1): cv.positive_int,
                     vol.Optional(CONF_DB_URL): cv.string,
+                    vol.Optional(CONF_DB_READ_URL): cv.string,
                     vol.Optional(
                         CONF_COMMIT_INTERVAL, default=DEFAULT_COMMIT_INTERVAL
                     ): cv.positive_int,
@@ -163,6 +183,8 @@ CONFIG_SCHEMA = vol.Schema(
                     vol.Optional(
                         CONF_DB_INTEGRITY_CHECK, default=DEFAULT_DB_INTEGRITY_CHECK
                     ): cv.boolean,
+                    vol.Optional(CONF_BULK_INSERT, default=False): cv.boolean,
+                    vol.Optional(CONF_PARTITION_BY_DAY, default=False): cv.boolean,
                 }
             ),
         )
@@ -255,10 +277,13 @@ async def async_setup(hass: HomeAssistant, config: ConfigType) -> bool:
         keep_days=keep_days,
         commit_interval=commit_interval,
         uri=db_url,
+        read_uri=conf.get(CONF_DB_READ_URL),
         db_max_retries=db_max_retries,
         db_retry_wait=db_retry_wait,
         entity_filter=entity_filter,
         exclude_t=exclude_t,
+        bulk_insert=conf[CONF_BULK_INSERT],
+        partition_by_day=conf[CONF_PARTITION_BY_DAY],
     )
     instance.async_initialize()
     instance.start()
@@ -343,6 +368,14 @@ class PurgeTask(NamedTuple):
     purge_before: datetime
     repack: bool
     apply_filter: bool
+    # The old events and states were purged off the recorder thread
+    old_data_purged: bool = False
+
+
+class PurgeAttributesTask(NamedTuple):
+    """Object to store the shared attributes a purge may have left unused."""
+
+    attributes_ids: set[int]
 
 
 class PurgeEntitiesTask(NamedTuple):
@@ -365,6 +398,14 @@ class WaitTask:
     """An object to insert into the recorder queue to tell it set the _queue_watch event."""
 
 
+class CommitTask:
+    """An object to insert into the recorder queue to commit the event session."""
+
+
+class KeepAliveTask:
+    """An object to insert into the recorder queue to send a keep alive."""
+
+
 class Recorder(threading.Thread):
     """A threaded recorder class."""
 
@@ -379,6 +420,9 @@ class Recorder(threading.Thread):
         db_retry_wait: int,
         entity_filter: Callable[[str], bool],
         exclude_t: list[str],
+        bulk_insert: bool = False,
+        read_uri: str | None = None,
+        partition_by_day: bool = False,
     ) -> None:
         """Initialize the recorder."""
         threading.Thread.__init__(self, name="Recorder")
@@ -390,6 +434,7 @@ class Recorder(threading.Thread):
         self.queue: Any = queue.SimpleQueue()
         self.recording_start = dt_util.utcnow()
         self.db_url = uri
+        self.db_read_url = read_uri
         self.db_max_retries = db_max_retries
         self.db_retry_wait = db_retry_wait
         self.async_db_ready: asyncio.Future = asyncio.Future()
@@ -400,14 +445,27 @@ class Recorder(threading.Thread):
 
         self.entity_filter = entity_filter
         self.exclude_t = exclude_t
+        self.bulk_insert = bulk_insert
+        self.partition_by_day = partition_by_day
 
-        self._timechanges_seen = 0
         self._commits_without_expire = 0
-        self._keepalive_count = 0
         self._old_states: dict[str, States] = {}
         self._pending_expunge: list[States] = []
+        self._state_attributes = StateAttributesManager()
+        self.statistics_states = StatisticsStates()
+        self.statistics_summary = statistics.ShortTermStatisticsSummary()
+        self._bulk_writer: BulkInsertWriter | None = None
+        self._partitioned = False
+        self._commit_seconds = hass.metrics.histogram(
+            "recorder_commit_seconds", "Time the recorder spent committing"
+        )
+        self._purge_worker: purge.PurgeWorker | None = None
+        # Start of the logbook states, None until the schema has them
+        self.logbook_states_since: datetime | None = None
         self.event_session = None
         self.get_session = None
+        self.read_engine: Any = None
+        self.get_read_session = None
         self._completed_first_database_setup = None
         self._event_listener = None
         self.async_migration_event = asyncio.Event()
@@ -423,13 +481,66 @@ class Recorder(threading.Thread):
     @callback
     def async_initialize(self):
         """Initialize the recorder."""
-        self._event_listener = self.hass.bus.async_listen(
-            MATCH_ALL, self.event_listener, event_filter=self._async_event_filter
+        self.hass.metrics.gauge(
+            "recorder_queue_depth",
+            "Items waiting to be processed by the recorder",
+            self.queue.qsize,
         )
+        # State changes are received through a batch listener so a
+        # batch of state_changed events is queued as a single item
+        unsubs = [
+            self.hass.bus.async_listen(
+                MATCH_ALL,
+                self.event_listener,
+                event_filter=self._async_event_filter,
+                exclude_event_types=[
+                    *self.exclude_t,
+                    EVENT_STATE_CHANGED,
+                    EVENT_TIME_CHANGED,
+                ],
+            ),
+            # The commits and keep alives run from loop timers so the
+            # recorder does not need EVENT_TIME_CHANGED every second
+            async_track_time_interval(
+                self.hass, self._async_keep_alive, timedelta(seconds=KEEPALIVE_TIME)
+            ),
+        ]
+        if self.commit_interval:
+            unsubs.append(
+                async_track_time_interval(
+                    self.hass,
+                    self._async_commit,
+                    timedelta(seconds=self.commit_interval),
+                )
+            )
+        if EVENT_STATE_CHANGED not in self.exclude_t:
+            unsubs.append(
+                self.hass.bus.async_listen_batch(
+                    EVENT_STATE_CHANGED, self._async_state_changed_listener
+                )
+            )
+
+        @callback
+        def _async_remove_event_listeners():
+            """Remove the event listeners."""
+            for unsub in unsubs:
+                unsub()
+
+        self._event_listener = _async_remove_event_listeners
         self._queue_watcher = async_track_time_interval(
             self.hass, self._async_check_queue, timedelta(minutes=10)
         )
 
+    @callback
+    def _async_keep_alive(self, now):
+        """Queue a keep alive."""
+        self.queue.put(KeepAliveTask())
+
+    @callback
+    def _async_commit(self, now):
+        """Queue a commit."""
+        self.queue.put(CommitTask())
+
     @callback
     def _async_check_queue(self, *_):
         """Periodic check of the queue size to ensure we do not exaust memory.
@@ -458,10 +569,11 @@ class Recorder(threading.Thread):
 
     @callback
     def _async_event_filter(self, event) -> bool:
-        """Filter events."""
-        if event.event_type in self.exclude_t:
-            return False
+        """Filter events by entity_id.
 
+        Excluded event types are never delivered since they are
+        removed from the event bus dispatch index.
+        """
         entity_id = event.data.get(ATTR_ENTITY_ID)
 
         if entity_id is None:
@@ -479,6 +591,15 @@ class Recorder(threading.Thread):
         # Unknown what it is.
         return True
 
+    @callback
+    def _async_state_changed_listener(self, events):
+        """Put a batch of recorded state changes in the process queue."""
+        events = [event for event in events if self._async_event_filter(event)]
+        if len(events) == 1:
+            self.queue.put(events[0])
+        elif events:
+            self.queue.put(events)
+
     def do_adhoc_purge(self, **kwargs):
         """Trigger an adhoc purge retaining keep_days worth of data."""
         keep_days = kwargs.get(ATTR_KEEP_DAYS, self.keep_days)
@@ -659,6 +780,9 @@ class Recorder(threading.Thread):
                 self._shutdown()
                 return
 
+        if self._partitioned:
+            self._setup_partitions()
+
         _LOGGER.debug("Recorder processing the queue")
         self.hass.add_job(self._async_recorder_ready)
         self._run_event_loop()
@@ -669,10 +793,14 @@ class Recorder(threading.Thread):
         # with a commit every time the event time
         # has changed. This reduces the disk io.
         while event := self.queue.get():
-            try:
-                self._process_one_event_or_recover(event)
-            except Exception as err:  # pylint: disable=broad-except
-                _LOGGER.exception("Error while processing event %s: %s", event, err)
+            # A list is a batch of state_changed events
+            for queued_event in event if isinstance(event, list) else (event,):
+                try:
+                    self._process_one_event_or_recover(queued_event)
+                except Exception as err:  # pylint: disable=broad-except
+                    _LOGGER.exception(
+                        "Error while processing event %s: %s", queued_event, err
+                    )
 
         self._shutdown()
 
@@ -748,27 +876,89 @@ class Recorder(threading.Thread):
             self.migration_in_progress = False
             persistent_notification.dismiss(self.hass, "recorder_database_migration")
 
-    def _run_purge(self, purge_before, repack, apply_filter):
+    def _run_purge(self, purge_before, repack, apply_filter, old_data_purged=False):
         """Purge the database."""
-        if purge.purge_old_data(self, purge_before, repack, apply_filter):
-            # We always need to do the db cleanups after a purge
-            # is finished to ensure the WAL checkpoint and other
-            # tasks happen after a vacuum.
-            perodic_db_cleanups(self)
+        if not old_data_purged and not self._using_memory_sqlite:
+            # The bulk of the old data is purged off the recorder thread, the
+            # rest of the purge is queued back once that is done. Pending
+            # states are committed first so the states they link to as old
+            # state are known.
+            self._commit_event_session_or_retry()
+            if self._partitioned:
+                # Whole days of old data are dropped at once
+                purge.drop_old_partitions(self, purge_before)
+            self.statistics_states.purge(purge_before)
+            if self._purge_worker is None:
+                self._purge_worker = purge.PurgeWorker(self)
+                self._purge_worker.start()
+            self._purge_worker.queue.put(
+                purge.OldDataPurge(
+                    purge_before, repack, apply_filter, purge.protected_state_ids(self)
+                )
+            )
+            return
+        deadline = time.monotonic() + PURGE_SLICE_SECONDS
+        while not purge.purge_old_data(self, purge_before, repack, apply_filter):
+            if time.monotonic() >= deadline:
+                # Schedule a new purge task if this one didn't finish, the
+                # events queued in the meantime are recorded first
+                self.queue.put(
+                    PurgeTask(purge_before, repack, apply_filter, old_data_purged)
+                )
+                return
+        # We always need to do the db cleanups after a purge
+        # is finished to ensure the WAL checkpoint and other
+        # tasks happen after a vacuum.
+        self._run_periodic_cleanups()
+
+    def _run_periodic_cleanups(self):
+        """Run the database cleanups and add the partitions for the next days."""
+        if self._partitioned:
+            with session_scope(session=self.get_session()) as session:
+                partitions.create_future_partitions(session)
+        perodic_db_cleanups(self)
+
+    def _setup_partitions(self):
+        """Partition the tables by day unless they already are."""
+        try:
+            with session_scope(session=self.get_session()) as session:
+                partitions.setup_partitions(session, self.keep_days)
+        except SQLAlchemyError:
+            _LOGGER.exception("Error partitioning the tables, purging rows instead")
+            self._partitioned = False
+
+    def _run_purge_attributes(self, attributes_ids):
+        """Purge shared attributes no state refers to anymore."""
+        if purge.purge_unused_attributes(self, attributes_ids):
             return
         # Schedule a new purge task if this one didn't finish
-        self.queue.put(PurgeTask(purge_before, repack, apply_filter))
+        self.queue.put(PurgeAttributesTask(attributes_ids))
 
     def _run_purge_entities(self, entity_filter):
         """Purge entities from the database."""
-        if purge.purge_entity_data(self, entity_filter):
-            return
-        # Schedule a new purge task if this one didn't finish
-        self.queue.put(PurgeEntitiesTask(entity_filter))
+        deadline = time.monotonic() + PURGE_SLICE_SECONDS
+        while not purge.purge_entity_data(self, entity_filter):
+            if time.monotonic() >= deadline:
+                # Schedule a new purge task if this one didn't finish
+                self.queue.put(PurgeEntitiesTask(entity_filter))
+                return
+
+    def queue_purge_remaining(self, purge_before, repack, apply_filter):
+        """Queue the rest of a purge once its old data was purged off thread."""
+        self.queue.put(
+            PurgeTask(purge_before, repack, apply_filter, old_data_purged=True)
+        )
+
+    def queue_purge_unused_attributes(self, attributes_ids):
+        """Queue deleting the shared attributes a purge off thread left unused."""
+        self.queue.put(PurgeAttributesTask(attributes_ids))
 
     def _run_statistics(self, start):
         """Run statistics task."""
-        if statistics.compile_statistics(self, start):
+        compiled = statistics.compile_statistics(self, start)
+        # A retry reads the states of the period from the database
+        self.statistics_states.prune(start + timedelta(minutes=5))
+        if compiled:
             return
         # Schedule a new statistics task if this one didn't finish
         self.queue.put(StatisticsTask(start))
@@ -776,13 +966,21 @@ class Recorder(threading.Thread):
     def _process_one_event(self, event):
         """Process one event."""
         if isinstance(event, PurgeTask):
-            self._run_purge(event.purge_before, event.repack, event.apply_filter)
+            self._run_purge(
+                event.purge_before,
+                event.repack,
+                event.apply_filter,
+                event.old_data_purged,
+            )
+            return
+        if isinstance(event, PurgeAttributesTask):
+            self._run_purge_attributes(event.attributes_ids)
             return
         if isinstance(event, PurgeEntitiesTask):
             self._run_purge_entities(event.entity_filter)
             return
         if isinstance(event, PerodicCleanupTask):
-            perodic_db_cleanups(self)
+            self._run_periodic_cleanups()
             return
         if isinstance(event, StatisticsTask):
             self._run_statistics(event.start)
@@ -798,21 +996,47 @@ class Recorder(threading.Thread):
         if isinstance(event, WaitTask):
             self._queue_watch.set()
             return
-        if event.event_type == EVENT_TIME_CHANGED:
-            self._keepalive_count += 1
-            if self._keepalive_count >= KEEPALIVE_TIME:
-                self._keepalive_count = 0
-                self._send_keep_alive()
-            if self.commit_interval:
-                self._timechanges_seen += 1
-                if self._timechanges_seen >= self.commit_interval:
-                    self._timechanges_seen = 0
-                    self._commit_event_session_or_retry()
+        if isinstance(event, KeepAliveTask):
+            self._send_keep_alive()
+            return
+        if isinstance(event, CommitTask):
+            self._commit_event_session_or_retry()
             return
 
         if not self.enabled:
             return
 
+        if self._bulk_writer is not None:
+            self._add_event_to_bulk_writer(event)
+        else:
+            self._add_event_to_session(event)
+
+        # If they do not have a commit interval
+        # than we commit right away
+        if not self.commit_interval:
+            self._commit_event_session_or_retry()
+
+    def _add_event_to_bulk_writer(self, event):
+        """Buffer the rows for an event until the next commit."""
+        try:
+            event_id = self._bulk_writer.add_event(event)
+        except (TypeError, ValueError):
+            _LOGGER.warning("Event is not JSON serializable: %s", event)
+            return
+
+        if event.event_type == EVENT_STATE_CHANGED:
+            try:
+                self._bulk_writer.add_state(self.event_session, event, event_id)
+            except (TypeError, ValueError):
+                _LOGGER.warning(
+                    "State is not JSON serializable: %s",
+                    event.data.get("new_state"),
+                )
+            else:
+                self.statistics_states.add_event(event)
+
+    def _add_event_to_session(self, event):
+        """Add the ORM objects for an event to the event session."""
         try:
             if event.event_type == EVENT_STATE_CHANGED:
                 dbevent = Events.from_event(event, event_data="{}")
@@ -828,7 +1052,8 @@ class Recorder(threading.Thread):
             try:
                 dbstate = States.from_event(event)
                 has_new_state = event.data.get("new_state")
-                if dbstate.entity_id in self._old_states:
+                has_old_state = dbstate.entity_id in self._old_states
+                if has_old_state:
                     old_state = self._old_states.pop(dbstate.entity_id)
                     if old_state.state_id:
                         dbstate.old_state_id = old_state.state_id
@@ -836,22 +1061,42 @@ class Recorder(threading.Thread):
                         dbstate.old_state = old_state
                 if not has_new_state:
                     dbstate.state = None
+                self._link_shared_attributes(dbstate)
                 dbstate.event = dbevent
                 dbstate.created = event.time_fired
                 self.event_session.add(dbstate)
                 if has_new_state:
                     self._old_states[dbstate.entity_id] = dbstate
                     self._pending_expunge.append(dbstate)
+                if (columns := logbook_state_columns(event, has_old_state)) is not None:
+                    self.event_session.add(LogbookStates(event=dbevent, **columns))
             except (TypeError, ValueError):
                 _LOGGER.warning(
                     "State is not JSON serializable: %s",
                     event.data.get("new_state"),
                 )
-
-        # If they do not have a commit interval
-        # than we commit right away
-        if not self.commit_interval:
-            self._commit_event_session_or_retry()
+            else:
+                self.statistics_states.add_event(event)
+
+    def _link_shared_attributes(self, dbstate):
+        """Point the state at a shared attributes row instead of a copy."""
+        shared_attrs = dbstate.attributes
+        dbstate.attributes = None
+        attr_hash = StateAttributes.hash_shared_attrs(shared_attrs)
+        state_attributes = self._state_attributes
+        if (
+            attributes_id := state_attributes.get_id(
+                self.event_session, attr_hash, shared_attrs
+            )
+        ) is not None:
+            dbstate.attributes_id = attributes_id
+        elif (pending := state_attributes.get_pending(attr_hash)) is not None:
+            dbstate.state_attributes = pending
+        else:
+            dbattrs = StateAttributes(hash=attr_hash, shared_attrs=shared_attrs)
+            self.event_session.add(dbattrs)
+            state_attributes.add_pending(dbattrs)
+            dbstate.state_attributes = dbattrs
 
     def _handle_database_error(self, err):
         """Handle a database error that may result in moving away the corrupt db."""
@@ -865,7 +1110,11 @@ class Recorder(threading.Thread):
 
     def _commit_event_session_or_retry(self):
         """Commit the event session if there is work to do."""
-        if not self.event_session.new and not self.event_session.dirty:
+        if (
+            not self.event_session.new
+            and not self.event_session.dirty
+            and not (self._bulk_writer and self._bulk_writer.has_pending)
+        ):
             return
         tries = 1
         while tries <= self.db_max_retries:
@@ -886,6 +1135,15 @@ class Recorder(threading.Thread):
                 time.sleep(self.db_retry_wait)
 
     def _commit_event_session(self):
+        if not self.hass.metrics.enabled:
+            self._write_event_session()
+            return
+        start = time.perf_counter()
+        self._write_event_session()
+        self._commit_seconds.observe(time.perf_counter() - start)
+
+    def _write_event_session(self):
+        """Write the pending changes and commit the event session."""
         self._commits_without_expire += 1
 
         if self._pending_expunge:
@@ -896,7 +1154,12 @@ class Recorder(threading.Thread):
                 if dbstate in self.event_session:
                     self.event_session.expunge(dbstate)
             self._pending_expunge = []
+        if self._bulk_writer:
+            self._bulk_writer.write(self.event_session)
         self.event_session.commit()
+        if self._bulk_writer:
+            self._bulk_writer.clear()
+        self._state_attributes.post_commit()
 
         # Expire is an expensive operation (frequently more expensive
         # than the flush and commit itself) so we only
@@ -916,6 +1179,8 @@ class Recorder(threading.Thread):
     def _close_event_session(self):
         """Close the event session."""
         self._old_states = {}
+        # States of the rolled back commits are not in the database
+        self.statistics_states.reset(None)
 
         if not self.event_session:
             return
@@ -937,6 +1202,10 @@ class Recorder(threading.Thread):
         """Open the event session."""
         self.event_session = self.get_session()
         self.event_session.expire_on_commit = False
+        self._state_attributes.reset()
+        self.statistics_states.reset(dt_util.utcnow())
+        if self._bulk_writer:
+            self._bulk_writer.reset(self.event_session)
 
     def _send_keep_alive(self):
         """Send a keep alive to keep the db connection open."""
@@ -963,6 +1232,8 @@ class Recorder(threading.Thread):
         self._queue_watch.clear()
         self.queue.put(WaitTask())
         self._queue_watch.wait()
+        if self._purge_worker is not None:
+            self._purge_worker.block_till_done()
 
     def _setup_connection(self):
         """Ensure database is ready to fly."""
@@ -978,7 +1249,7 @@ class Recorder(threading.Thread):
             )
             self._completed_first_database_setup = True
 
-        if self.db_url == SQLITE_URL_PREFIX or ":memory:" in self.db_url:
+        if self._using_memory_sqlite:
             kwargs["connect_args"] = {"check_same_thread": False}
             kwargs["poolclass"] = StaticPool
             kwargs["pool_reset_on_return"] = None
@@ -994,10 +1265,70 @@ class Recorder(threading.Thread):
 
         sqlalchemy_event.listen(self.engine, "connect", setup_recorder_connection)
 
+        self._bulk_writer = None
+        if self.bulk_insert:
+            if bulk_insert_supported(self.engine.dialect.name):
+                self._bulk_writer = BulkInsertWriter(self._state_attributes)
+            else:
+                _LOGGER.warning(
+                    "Bulk insert is not supported with %s, using the default write path",
+                    self.engine.dialect.name,
+                )
+
+        self._partitioned = False
+        if self.partition_by_day:
+            if partitions.partitions_supported(self.engine.dialect.name):
+                self._partitioned = True
+            else:
+                _LOGGER.warning(
+                    "Daily partitions are not supported with %s, purging rows instead",
+                    self.engine.dialect.name,
+                )
+
         Base.metadata.create_all(self.engine)
         self.get_session = scoped_session(sessionmaker(bind=self.engine))
+        self._setup_read_connection()
         _LOGGER.debug("Connected to recorder database")
 
+    def _setup_read_connection(self):
+        """Set up the connection pool for reads outside the recorder thread."""
+        if self.db_read_url:
+            # Read replica of a database server
+            self.read_engine = create_engine(
+                self.db_read_url, pool_size=READ_POOL_SIZE, max_overflow=0
+            )
+        elif self._using_file_sqlite:
+            self.read_engine = create_engine(
+                SQLITE_URL_PREFIX,
+                creator=partial(connect_sqlite_read_only, dburl_to_path(self.db_url)),
+                poolclass=QueuePool,
+                pool_size=READ_POOL_SIZE,
+                max_overflow=0,
+            )
+        else:
+            # In memory databases have a single connection and the engine
+            # of a database server already pools its connections
+            self.read_engine = None
+            self.get_read_session = self.get_session
+            return
+
+        dialect_name = self.read_engine.dialect.name
+
+        def setup_read_connection(dbapi_connection, connection_record):
+            """Dbapi specific connection settings."""
+            setup_connection_for_dialect(dialect_name, dbapi_connection, False)
+
+        sqlalchemy_event.listen(self.read_engine, "connect", setup_read_connection)
+        self.get_read_session = scoped_session(sessionmaker(bind=self.read_engine))
+
+    @property
+    def _using_memory_sqlite(self):
+        """Short version to check if we are using an in memory sqlite3 database.
+
+        Its single connection is shared by all threads.
+        """
+        return self.db_url == SQLITE_URL_PREFIX or ":memory:" in self.db_url
+
     @property
     def _using_file_sqlite(self):
         """Short version to check if we are using sqlite3 as a file."""
@@ -1007,6 +1338,13 @@ class Recorder(threading.Thread):
 
     def _close_connection(self):
         """Close the connection."""
+        if self._purge_worker is not None:
+            self._purge_worker.stop()
+            self._purge_worker = None
+        if self.read_engine is not None:
+            self.read_engine.dispose()
+            self.read_engine = None
+        self.get_read_session = None
         self.engine.dispose()
         self.engine = None
         self.get_session = None
@@ -1021,6 +1359,7 @@ class Recorder(threading.Thread):
             session.flush()
             session.expunge(self.run_info)
             self._schedule_compile_missing_statistics(session)
+            self.logbook_states_since = get_logbook_states_start(session)
 
         self._open_event_session()
 
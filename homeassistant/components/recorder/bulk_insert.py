@@ -0,0 +1,251 @@
+"""Bulk insert write path for the recorder."""
+from __future__ import annotations
+
+import logging
+from typing import Any
+
+from sqlalchemy import func
+from sqlalchemy.orm.session import Session
+
+from homeassistant.const import EVENT_STATE_CHANGED
+from homeassistant.core import Event, split_entity_id
+from homeassistant.helpers.json import json_dumps
+
+from .logbook_states import logbook_state_columns
+from .models import Events, LogbookStates, StateAttributes, States
+from .state_attributes import StateAttributesManager
+
+_LOGGER = logging.getLogger(__name__)
+
+# Dialects where we can safely assign the primary keys ourselves.
+# PostgreSQL identity sequences would not be advanced by explicit ids
+# so other dialects use the ORM write path.
+BULK_INSERT_DIALECTS = {"sqlite", "mysql", "mariadb"}
+
+EVENTS_COLUMNS = (
+    "event_id",
+    "event_type",
+    "event_data",
+    "origin",
+    "time_fired",
+    "created",
+    "context_id",
+    "context_user_id",
+    "context_parent_id",
+)
+
+STATES_COLUMNS = (
+    "state_id",
+    "domain",
+    "entity_id",
+    "state",
+    "attributes",
+    "event_id",
+    "last_changed",
+    "last_updated",
+    "created",
+    "old_state_id",
+    "attributes_id",
+)
+
+STATE_ATTRIBUTES_COLUMNS = (
+    "attributes_id",
+    "hash",
+    "shared_attrs",
+)
+
+
+def bulk_insert_supported(dialect_name: str) -> bool:
+    """Return if the bulk insert write path can be used with the dialect."""
+    return dialect_name in BULK_INSERT_DIALECTS
+
+
+class BulkInsertWriter:
+    """Buffer events and states as rows and insert them per commit.
+
+    The recorder is the only writer of the events and states tables so
+    primary keys are assigned here. This avoids a round trip per row to
+    learn the generated id, which is needed to link the state to its
+    event and to the previous state of the same entity.
+
+    This class must only be used from the recorder thread.
+    """
+
+    def __init__(self, state_attributes: StateAttributesManager) -> None:
+        """Initialize the writer."""
+        self.old_state_ids: dict[str, int] = {}
+        self._state_attributes = state_attributes
+        self._event_rows: list[tuple[Any, ...]] = []
+        self._state_rows: list[tuple[Any, ...]] = []
+        self._attributes_rows: list[tuple[Any, ...]] = []
+        self._logbook_rows: list[dict[str, Any]] = []
+        self._last_event_id = 0
+        self._last_state_id = 0
+        self._last_attributes_id = 0
+
+    @property
+    def has_pending(self) -> bool:
+        """Return if there are rows waiting to be inserted."""
+        return bool(self._event_rows)
+
+    def reset(self, session: Session) -> None:
+        """Drop any pending rows and resync the ids with the database."""
+        self.old_state_ids = {}
+        self._event_rows = []
+        self._state_rows = []
+        self._attributes_rows = []
+        self._logbook_rows = []
+        self._last_event_id = session.query(func.max(Events.event_id)).scalar() or 0
+        self._last_state_id = session.query(func.max(States.state_id)).scalar() or 0
+        self._last_attributes_id = (
+            session.query(func.max(StateAttributes.attributes_id)).scalar() or 0
+        )
+
+    def add_event(self, event: Event) -> int:
+        """Buffer an event and return the id it will be inserted with.
+
+        Raises TypeError or ValueError if the event data
+        is not JSON serializable.
+        """
+        if event.event_type == EVENT_STATE_CHANGED:
+            event_data = "{}"
+        else:
+            event_data = json_dumps(event.data, compact=True)
+
+        self._last_event_id += 1
+        context = event.context
+        self._event_rows.append(
+            (
+                self._last_event_id,
+                event.event_type,
+                event_data,
+                str(event.origin.value),
+                event.time_fired,
+                event.time_fired,
+                context.id,
+                context.user_id,
+                context.parent_id,
+            )
+        )
+        return self._last_event_id
+
+    def add_state(self, session: Session, event: Event, event_id: int) -> None:
+        """Buffer the state of a state_changed event.
+
+        The previous state of the entity is linked through the
+        in memory map of old state ids.
+
+        Raises TypeError or ValueError if the state attributes
+        are not JSON serializable.
+        """
+        state_row = self._state_row(event)
+        entity_id = state_row[1]
+        attributes_id = self._attributes_id(session, state_row[3])
+        self._last_state_id += 1
+        state_id = self._last_state_id
+        old_state_id = self.old_state_ids.pop(entity_id, None)
+        if state_row[2] is not None:
+            self.old_state_ids[entity_id] = state_id
+        self._state_rows.append(
+            (
+                state_id,
+                *state_row[:3],
+                None,
+                event_id,
+                *state_row[4:],
+                old_state_id,
+                attributes_id,
+            )
+        )
+        if (
+            columns := logbook_state_columns(event, old_state_id is not None)
+        ) is not None:
+            columns["event_id"] = event_id
+            self._logbook_rows.append(columns)
+
+    def _attributes_id(self, session: Session, shared_attrs: str) -> int:
+        """Return the id of the shared attributes, buffering a new row if needed."""
+        attr_hash = StateAttributes.hash_shared_attrs(shared_attrs)
+        attributes_id = self._state_attributes.get_id(session, attr_hash, shared_attrs)
+        if attributes_id is None:
+            self._last_attributes_id += 1
+            attributes_id = self._last_attributes_id
+            self._attributes_rows.append((attributes_id, attr_hash, shared_attrs))
+            self._state_attributes.add_pending_id(attr_hash, attributes_id)
+        return attributes_id
+
+    @staticmethod
+    def _state_row(event: Event) -> tuple[Any, ...]:
+        """Build the state columns from a state_changed event.
+
+        The row is (domain, entity_id, state, attributes, last_changed,
+        last_updated, created) to match States.from_event.
+        """
+        entity_id = event.data["entity_id"]
+        if (state := event.data.get("new_state")) is None:
+            # State got deleted
+            return (
+                split_entity_id(entity_id)[0],
+                entity_id,
+                None,
+                "{}",
+                event.time_fired,
+                event.time_fired,
+                event.time_fired,
+            )
+        return (
+            state.domain,
+            entity_id,
+            state.state,
+            json_dumps(dict(state.attributes), compact=True),
+            state.last_changed,
+            state.last_updated,
+            event.time_fired,
+        )
+
+    def write(self, session: Session) -> None:
+        """Insert the pending rows with one executemany per table.
+
+        The rows are kept until clear is called after the commit
+        succeeded so a failed commit can be retried.
+        """
+        if self._event_rows:
+            session.execute(
+                Events.__table__.insert(),
+                [dict(zip(EVENTS_COLUMNS, row)) for row in self._event_rows],
+            )
+        if self._attributes_rows:
+            session.execute(
+                StateAttributes.__table__.insert(),
+                [
+                    dict(zip(STATE_ATTRIBUTES_COLUMNS, row))
+                    for row in self._attributes_rows
+                ],
+            )
+        if self._state_rows:
+            session.execute(
+                States.__table__.insert(),
+                [dict(zip(STATES_COLUMNS, row)) for row in self._state_rows],
+            )
+        if self._logbook_rows:
+            session.execute(LogbookStates.__table__.insert(), self._logbook_rows)
+        _LOGGER.debug(
+            "Inserted %s events, %s states, %s state attributes and %s logbook states",
+            len(self._event_rows),
+            len(self._state_rows),
+            len(self._attributes_rows),
+            len(self._logbook_rows),
+        )
+
+    def clear(self) -> None:
+        """Drop the rows once they are committed."""
+        self._event_rows = []
+        self._state_rows = []
+        self._attributes_rows = []
+        self._logbook_rows = []
+
+    def evict_purged_states(self, purged_state_ids: set[int]) -> None:
+        """Forget old state ids that were purged from the database."""
+        for entity_id, state_id in list(self.old_state_ids.items()):
+            if state_id in purged_state_ids:
+                del self.old_state_ids[entity_id]
@@ -13,3 +13,10 @@ CONF_DB_INTEGRITY_CHECK = "db_integrity_check"
 # We can increase this back to 1000 once most
 # have upgraded their sqlite version
 MAX_ROWS_TO_PURGE = 998
+
+# The maximum number of ids we look up in one IN query
+MAX_IDS_PER_QUERY = MAX_ROWS_TO_PURGE
+
+# The recorder thread purges for up to this many seconds before it records
+# the events queued in the meantime
+PURGE_SLICE_SECONDS = 1
@@ -2,6 +2,7 @@
 from __future__ import annotations
 
 from collections import defaultdict
+from datetime import timedelta
 from itertools import groupby
 import logging
 import time
@@ -11,13 +12,17 @@ from sqlalchemy.ext import baked
 
 from homeassistant.components import recorder
 from homeassistant.components.recorder.models import (
+    StateAttributes,
     States,
+    process_timestamp,
     process_timestamp_to_utc_isoformat,
 )
 from homeassistant.components.recorder.util import execute, session_scope
 from homeassistant.core import split_entity_id
+from homeassistant.helpers.json import json_loads
 import homeassistant.util.dt as dt_util
 
+from .const import MAX_IDS_PER_QUERY
 from .models import LazyState
 
 # mypy: allow-untyped-defs, no-check-untyped-defs
@@ -27,6 +32,10 @@ _LOGGER = logging.getLogger(__name__)
 STATE_KEY = "state"
 LAST_CHANGED_KEY = "last_changed"
 
+COLUMNAR_TIME_KEY = "time"
+COLUMNAR_STATE_KEY = "state"
+COLUMNAR_ATTRIBUTES_KEY = "attributes"
+
 SIGNIFICANT_DOMAINS = (
     "climate",
     "device_tracker",
@@ -48,12 +57,20 @@ QUERY_STATES = [
     States.entity_id,
     States.state,
     States.attributes,
+    States.attributes_id,
     States.last_changed,
     States.last_updated,
+    States.state_id,
 ]
 
+# The states at a point in time are all returned as full states
+QUERY_STATES_WITH_SHARED_ATTRS = [*QUERY_STATES, StateAttributes.shared_attrs]
+
 HISTORY_BAKERY = "recorder_history_bakery"
 
+# Number of rows fetched from the cursor at a time when streaming
+STREAM_CHUNK_SIZE = 1000
+
 
 def async_setup(hass):
     """Set up the history hooks."""
@@ -62,7 +79,7 @@ def async_setup(hass):
 
 def get_significant_states(hass, *args, **kwargs):
     """Wrap get_significant_states_with_session with an sql session."""
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         return get_significant_states_with_session(hass, session, *args, **kwargs)
 
 
@@ -91,6 +108,455 @@ def get_significant_states_with_session(
     """
     timer_start = time.perf_counter()
 
+    baked_query = _significant_states_baked_query(
+        hass, end_time, entity_ids, filters, significant_changes_only
+    )
+    baked_query += lambda q: q.order_by(States.entity_id, States.last_updated)
+
+    states = execute(
+        baked_query(session).params(
+            start_time=start_time, end_time=end_time, entity_ids=entity_ids
+        )
+    )
+
+    if _LOGGER.isEnabledFor(logging.DEBUG):
+        elapsed = time.perf_counter() - timer_start
+        _LOGGER.debug("get_significant_states took %fs", elapsed)
+
+    return _sorted_states_to_dict(
+        hass,
+        session,
+        states,
+        start_time,
+        entity_ids,
+        filters,
+        include_start_time_state,
+        minimal_response,
+    )
+
+
+def get_statistics_states_with_session(
+    hass, session, start, end, entity_ids, significant_changes_only=True
+):
+    """Return the states of entities during a statistics period start - end.
+
+    The states the recorder still keeps for the period are used, the other
+    entities are read from the database like get_significant_states does
+    for the microsecond before start.
+
+    Must be run in the recorder thread.
+    """
+    instance = hass.data[recorder.DATA_INSTANCE]
+    result, missing = instance.statistics_states.states_during_period(
+        entity_ids, start, end, significant_changes_only
+    )
+    if missing:
+        result.update(
+            get_significant_states_with_session(
+                hass,
+                session,
+                start - timedelta.resolution,
+                end,
+                entity_ids=missing,
+                significant_changes_only=significant_changes_only,
+            )
+        )
+    return result
+
+
+def get_significant_states_columnar_with_session(
+    hass,
+    session,
+    start_time,
+    end_time=None,
+    entity_ids=None,
+    filters=None,
+    include_start_time_state=True,
+    significant_changes_only=True,
+    minimal_response=False,
+):
+    """
+    Return the significant states of an UTC period in a columnar form.
+
+    The result maps each entity_id to a dict with a list of epoch
+    timestamps of last_updated, a list of state values and a list of
+    [index, attributes] pairs for the states where the attributes changed.
+    The rows are turned into the columns directly without creating
+    State objects and only the changed attributes are decoded.
+
+    With minimal_response the same states as get_significant_states are
+    kept, only the attributes of the first and the last one are included.
+    """
+    timer_start = time.perf_counter()
+
+    baked_query = _significant_states_baked_query(
+        hass, end_time, entity_ids, filters, significant_changes_only
+    )
+    baked_query += lambda q: q.order_by(States.entity_id, States.last_updated)
+
+    rows = execute(
+        baked_query(session).params(
+            start_time=start_time, end_time=end_time, entity_ids=entity_ids
+        )
+    )
+
+    result = {}
+    # Set all entity IDs to empty columns in result set to maintain the order
+    for ent_id in entity_ids or ():
+        result[ent_id] = _empty_columns()
+
+    # The shared attributes of changed rows are fetched once the rows are done
+    pending_shared = defaultdict(list)
+    # The attributes of the start time state of each entity
+    start_attributes_keys = {}
+    if include_start_time_state:
+        start_timestamp = start_time.timestamp()
+        run = recorder.run_information_from_instance(hass, start_time)
+        for row in _get_rows_with_session(
+            hass, session, start_time, entity_ids, run=run, filters=filters
+        ):
+            columns = result.setdefault(row.entity_id, _empty_columns())
+            columns[COLUMNAR_TIME_KEY].append(start_timestamp)
+            columns[COLUMNAR_STATE_KEY].append(row.state or "")
+            if (source := row.attributes) is None:
+                source = row.shared_attrs or "{}"
+            columns[COLUMNAR_ATTRIBUTES_KEY].append([0, _decode_attributes(source)])
+            start_attributes_keys[row.entity_id] = _attributes_key(row)
+
+    for ent_id, group in groupby(rows, lambda row: row.entity_id):
+        columns = result.setdefault(ent_id, _empty_columns())
+        times = columns[COLUMNAR_TIME_KEY]
+        states = columns[COLUMNAR_STATE_KEY]
+        attributes = columns[COLUMNAR_ATTRIBUTES_KEY]
+        prev_attributes_key = start_attributes_keys.get(ent_id)
+        minimal = _is_minimal(ent_id, minimal_response)
+        last_row = None
+        for row in group:
+            state = row.state or ""
+            if minimal and states:
+                # Only the state changes after the first state are kept
+                if state == states[-1]:
+                    continue
+                last_row = row
+            times.append(process_timestamp(row.last_updated).timestamp())
+            states.append(state)
+            if last_row is not None:
+                continue
+            if (attributes_key := _attributes_key(row)) == prev_attributes_key:
+                continue
+            prev_attributes_key = attributes_key
+            _append_attributes_change(attributes, len(states) - 1, row, pending_shared)
+        if last_row is not None and _attributes_key(last_row) != prev_attributes_key:
+            _append_attributes_change(
+                attributes, len(states) - 1, last_row, pending_shared
+            )
+
+    for attributes_id, shared_attrs in _fetch_shared_attrs(session, pending_shared):
+        decoded = _decode_attributes(shared_attrs)
+        for change in pending_shared[attributes_id]:
+            change[1] = decoded
+
+    if _LOGGER.isEnabledFor(logging.DEBUG):
+        elapsed = time.perf_counter() - timer_start
+        _LOGGER.debug("get_significant_states_columnar took %fs", elapsed)
+
+    # Filter out the empty columns if some entities had 0 results.
+    return {key: val for key, val in result.items() if val[COLUMNAR_TIME_KEY]}
+
+
+def _attributes_key(row):
+    """Return what identifies the attributes of a row."""
+    if row.attributes is not None:
+        return row.attributes
+    return row.attributes_id
+
+
+def _append_attributes_change(attributes, index, row, pending_shared):
+    """Append the attributes of a row as a change of the columns at index.
+
+    Shared attributes are added to pending_shared to be decoded later.
+    """
+    if row.attributes is not None:
+        attributes.append([index, _decode_attributes(row.attributes)])
+    elif row.attributes_id is not None:
+        change = [index, {}]
+        attributes.append(change)
+        pending_shared[row.attributes_id].append(change)
+
+
+def _empty_columns():
+    """Return the columns of an entity without states."""
+    return {COLUMNAR_TIME_KEY: [], COLUMNAR_STATE_KEY: [], COLUMNAR_ATTRIBUTES_KEY: []}
+
+
+def _decode_attributes(source):
+    """Decode the attributes json of a row."""
+    try:
+        return json_loads(source)
+    except ValueError:
+        # When json_loads fails
+        _LOGGER.exception("Error converting row attributes: %s", source)
+        return {}
+
+
+def stream_significant_states_with_session(
+    hass,
+    session,
+    start_time,
+    end_time=None,
+    entity_ids=None,
+    filters=None,
+    include_start_time_state=True,
+    significant_changes_only=True,
+    minimal_response=False,
+    chunk_size=STREAM_CHUNK_SIZE,
+    after=None,
+    start_states_first=False,
+):
+    """
+    Yield the significant states of get_significant_states_with_session in chunks.
+
+    The rows are fetched chunk_size at a time with a query that resumes
+    after the last row of the previous chunk so memory use does not grow
+    with the time range. Each item is a tuple of
+    (entity_id, states, position) where states holds at most chunk_size
+    states and position is the (last_updated, state_id) of the last one.
+    The chunks of one entity are yielded consecutively and entities
+    follow the order of their entity_id. The state of an entity at the
+    start time comes ahead of its rows. Entities that only have a state
+    at the start time are yielded in between with a position of
+    (None, None).
+
+    With start_states_first the states at the start time are all yielded
+    first, each with a position of (None, None), so every later chunk can
+    be resumed after.
+
+    after is an optional (entity_id, last_updated, state_id) position of a
+    chunk with rows to resume a stream with start_states_first after. The
+    states at the start time were yielded before it and are not fetched
+    again. With minimal_response the first row of each entity is compared
+    with the state before it, so it is returned as it would have been
+    without resuming.
+    """
+    baked_query = _significant_states_baked_query(
+        hass, end_time, entity_ids, filters, significant_changes_only
+    )
+    rows = _iter_rows_in_chunks(
+        session,
+        baked_query,
+        {"start_time": start_time, "end_time": end_time, "entity_ids": entity_ids},
+        chunk_size,
+        after,
+    )
+
+    start_states = {}
+    if include_start_time_state and after is None:
+        run = recorder.run_information_from_instance(hass, start_time)
+        for state in _get_states_with_session(
+            hass, session, start_time, entity_ids, run=run, filters=filters
+        ):
+            state.last_changed = start_time
+            state.last_updated = start_time
+            start_states[state.entity_id] = state
+    start_ids = iter(sorted(start_states))
+    next_start_id = next(start_ids, None)
+    if start_states_first:
+        for ent_id in sorted(start_states):
+            yield ent_id, [start_states[ent_id]], (None, None)
+        next_start_id = None
+
+    resumed = _ResumedStates(hass, session, start_time, entity_ids, after)
+
+    for ent_id, group in groupby(rows, lambda row: row.entity_id):
+        while next_start_id is not None and next_start_id < ent_id:
+            if start_state := start_states.pop(next_start_id, None):
+                yield next_start_id, [start_state], (None, None)
+            next_start_id = next(start_ids, None)
+        chunk = []
+        start_state = start_states.pop(ent_id, None)
+        if start_state is not None and not start_states_first:
+            chunk.append(start_state)
+        prev_row = start_state
+        if after is not None and _is_minimal(ent_id, minimal_response):
+            prev_row = resumed.prev_row(ent_id, include_start_time_state)
+        position = (None, None)
+        for state, position in _entity_states(
+            ent_id, group, prev_row, minimal_response
+        ):
+            chunk.append(state)
+            if len(chunk) >= chunk_size:
+                yield ent_id, _load_shared_chunk(session, chunk), position
+                chunk = []
+        if chunk:
+            yield ent_id, _load_shared_chunk(session, chunk), position
+
+    if not start_states_first:
+        for ent_id in sorted(start_states):
+            yield ent_id, [start_states[ent_id]], (None, None)
+
+
+class _ResumedStates:
+    """Look up the state before the first row of an entity in a resumed stream."""
+
+    def __init__(self, hass, session, start_time, entity_ids, after):
+        """Initialize the lookup."""
+        self._hass = hass
+        self._session = session
+        self._start_time = start_time
+        self._entity_ids = entity_ids
+        self._after = after
+        self._run = None
+        self._run_loaded = False
+
+    def prev_row(self, ent_id, include_start_time_state):
+        """Return the row before the first row of an entity or None."""
+        if ent_id == self._after[0]:
+            # The last row of the previous chunk
+            rows = self._get_row(self._after[2])
+            return rows[0] if rows else None
+
+        if not include_start_time_state:
+            return None
+
+        # The state at the start time, limited to the run at the start
+        # time like _get_rows_with_session does for multiple entities
+        run_start = None
+        if not self._entity_ids or len(self._entity_ids) > 1:
+            if not self._run_loaded:
+                # Only looked up once an entity needs its start state
+                self._run = recorder.run_information_from_instance(
+                    self._hass, self._start_time
+                )
+                self._run_loaded = True
+            if self._run is None:
+                return None
+            run_start = process_timestamp(self._run.start)
+
+        for row in _get_single_entity_rows_with_session(
+            self._hass, self._session, self._start_time, ent_id
+        ):
+            last_updated = process_timestamp(row.last_updated)
+            if run_start is None or last_updated >= run_start:
+                return row
+        return None
+
+    def _get_row(self, state_id):
+        """Return the row of a state_id."""
+        baked_query = self._hass.data[HISTORY_BAKERY](
+            lambda session: session.query(*QUERY_STATES)
+        )
+        baked_query += lambda q: q.filter(States.state_id == bindparam("state_id"))
+        return execute(baked_query(self._session).params(state_id=state_id))
+
+
+def _iter_rows_in_chunks(session, baked_query, params, chunk_size, after):
+    """Yield the rows of a states query fetching chunk_size rows at a time.
+
+    The state_id breaks ties between rows of an entity with the same
+    last_updated so none are skipped at a chunk boundary.
+    """
+    first_query = baked_query + (
+        lambda q: q.order_by(
+            States.entity_id, States.last_updated, States.state_id
+        ).limit(bindparam("limit"))
+    )
+    next_query = baked_query + (
+        lambda q: q.filter(
+            (States.entity_id > bindparam("after_entity_id"))
+            | (
+                (States.entity_id == bindparam("after_entity_id"))
+                & (
+                    (States.last_updated > bindparam("after_last_updated"))
+                    | (
+                        (States.last_updated == bindparam("after_last_updated"))
+                        & (States.state_id > bindparam("after_state_id"))
+                    )
+                )
+            )
+        )
+        .order_by(States.entity_id, States.last_updated, States.state_id)
+        .limit(bindparam("limit"))
+    )
+
+    while True:
+        if after is None:
+            query = first_query(session).params(limit=chunk_size, **params)
+        else:
+            query = next_query(session).params(
+                limit=chunk_size,
+                after_entity_id=after[0],
+                after_last_updated=after[1],
+                after_state_id=after[2],
+                **params,
+            )
+        rows = execute(query)
+        yield from rows
+        if len(rows) < chunk_size:
+            return
+        last_row = rows[-1]
+        after = (last_row.entity_id, last_row.last_updated, last_row.state_id)
+
+
+def _is_minimal(ent_id, minimal_response):
+    """Return if the states of an entity are returned in minimal form."""
+    return (
+        minimal_response and split_entity_id(ent_id)[0] not in NEED_ATTRIBUTE_DOMAINS
+    )
+
+
+def _entity_states(ent_id, group, prev_row, minimal_response):
+    """Yield the states and their (last_updated, state_id) for the rows of an entity.
+
+    This follows the same rules as _sorted_states_to_dict without
+    holding all the rows of the entity in memory. prev_row is the state
+    before the rows, None when the first row is the first state.
+    """
+    if not _is_minimal(ent_id, minimal_response):
+        for row in group:
+            yield LazyState(row), _row_position(row)
+        return
+
+    if prev_row is None:
+        prev_row = next(group)
+        yield LazyState(prev_row), _row_position(prev_row)
+
+    # With minimal response the last state change is returned
+    # as a full state so it is held back until the next row
+    # shows it is not the last one
+    pending_row = None
+    for row in group:
+        if row.state == prev_row.state:
+            continue
+        if pending_row is not None:
+            yield {
+                STATE_KEY: pending_row.state,
+                LAST_CHANGED_KEY: process_timestamp_to_utc_isoformat(
+                    pending_row.last_changed
+                ),
+            }, _row_position(pending_row)
+        pending_row = prev_row = row
+
+    if pending_row is not None:
+        yield LazyState(pending_row), _row_position(pending_row)
+
+
+def _row_position(row):
+    """Return the position of a row to resume a stream after."""
+    return row.last_updated, row.state_id
+
+
+def _load_shared_chunk(session, chunk):
+    """Load the shared attributes of the full states in a chunk."""
+    _load_shared_attributes(
+        session, [state for state in chunk if isinstance(state, LazyState)]
+    )
+    return chunk
+
+
+def _significant_states_baked_query(
+    hass, end_time, entity_ids, filters, significant_changes_only
+):
+    """Return the baked query for significant states without an order."""
     baked_query = hass.data[HISTORY_BAKERY](
         lambda session: session.query(*QUERY_STATES)
     )
@@ -118,33 +584,12 @@ def get_significant_states_with_session(
     if end_time is not None:
         baked_query += lambda q: q.filter(States.last_updated < bindparam("end_time"))
 
-    baked_query += lambda q: q.order_by(States.entity_id, States.last_updated)
-
-    states = execute(
-        baked_query(session).params(
-            start_time=start_time, end_time=end_time, entity_ids=entity_ids
-        )
-    )
-
-    if _LOGGER.isEnabledFor(logging.DEBUG):
-        elapsed = time.perf_counter() - timer_start
-        _LOGGER.debug("get_significant_states took %fs", elapsed)
-
-    return _sorted_states_to_dict(
-        hass,
-        session,
-        states,
-        start_time,
-        entity_ids,
-        filters,
-        include_start_time_state,
-        minimal_response,
-    )
+    return baked_query
 
 
 def state_changes_during_period(hass, start_time, end_time=None, entity_id=None):
     """Return states changes during UTC period start_time - end_time."""
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         baked_query = hass.data[HISTORY_BAKERY](
             lambda session: session.query(*QUERY_STATES)
         )
@@ -180,7 +625,7 @@ def get_last_state_changes(hass, number_of_states, entity_id):
     """Return the last number_of_states."""
     start_time = dt_util.utcnow()
 
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         baked_query = hass.data[HISTORY_BAKERY](
             lambda session: session.query(*QUERY_STATES)
         )
@@ -223,7 +668,7 @@ def get_states(hass, utc_point_in_time, entity_ids=None, run=None, filters=None)
         if run is None:
             return []
 
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         return _get_states_with_session(
             hass, session, utc_point_in_time, entity_ids, run, filters
         )
@@ -233,8 +678,25 @@ def _get_states_with_session(
     hass, session, utc_point_in_time, entity_ids=None, run=None, filters=None
 ):
     """Return the states at a specific point in time."""
+    states = []
+    for row in _get_rows_with_session(
+        hass, session, utc_point_in_time, entity_ids, run, filters
+    ):
+        state = LazyState(row)
+        state.shared_attrs = row.shared_attrs
+        states.append(state)
+    return states
+
+
+def _get_rows_with_session(
+    hass, session, utc_point_in_time, entity_ids=None, run=None, filters=None
+):
+    """Return the rows of the states at a specific point in time.
+
+    The shared attributes of the rows are joined as shared_attrs.
+    """
     if entity_ids and len(entity_ids) == 1:
-        return _get_single_entity_states_with_session(
+        return _get_single_entity_rows_with_session(
             hass, session, utc_point_in_time, entity_ids[0]
         )
 
@@ -247,7 +709,9 @@ def _get_states_with_session(
 
     # We have more than one entity to look at so we need to do a query on states
     # since the last recorder run started.
-    query = session.query(*QUERY_STATES)
+    query = session.query(*QUERY_STATES_WITH_SHARED_ATTRS).outerjoin(
+        StateAttributes, States.attributes_id == StateAttributes.attributes_id
+    )
 
     if entity_ids:
         # We got an include-list of entities, accelerate the query by filtering already
@@ -306,14 +770,16 @@ def _get_states_with_session(
         if filters:
             query = filters.apply(query)
 
-    return [LazyState(row) for row in execute(query)]
+    return execute(query)
 
 
-def _get_single_entity_states_with_session(hass, session, utc_point_in_time, entity_id):
+def _get_single_entity_rows_with_session(hass, session, utc_point_in_time, entity_id):
     # Use an entirely different (and extremely fast) query if we only
     # have a single entity id
     baked_query = hass.data[HISTORY_BAKERY](
-        lambda session: session.query(*QUERY_STATES)
+        lambda session: session.query(*QUERY_STATES_WITH_SHARED_ATTRS).outerjoin(
+            StateAttributes, States.attributes_id == StateAttributes.attributes_id
+        )
     )
     baked_query += lambda q: q.filter(
         States.last_updated < bindparam("utc_point_in_time"),
@@ -326,7 +792,39 @@ def _get_single_entity_states_with_session(hass, session, utc_point_in_time, ent
         utc_point_in_time=utc_point_in_time, entity_id=entity_id
     )
 
-    return [LazyState(row) for row in execute(query)]
+    return execute(query)
+
+
+def _load_shared_attributes(session, states):
+    """Load the shared attributes of the states in as few queries as possible.
+
+    Only the attributes of the states that are returned as a full
+    state are needed so the state_attributes table is not joined
+    in the queries of the significant states.
+    """
+    pending = defaultdict(list)
+    for state in states:
+        if (attributes_id := state.pending_attributes_id) is not None:
+            pending[attributes_id].append(state)
+
+    for attributes_id, shared_attrs in _fetch_shared_attrs(session, pending):
+        for state in pending[attributes_id]:
+            state.shared_attrs = shared_attrs
+
+    return states
+
+
+def _fetch_shared_attrs(session, attributes_ids):
+    """Yield (attributes_id, shared_attrs) for the given ids."""
+    attributes_ids = list(attributes_ids)
+    for offset in range(0, len(attributes_ids), MAX_IDS_PER_QUERY):
+        yield from session.query(
+            StateAttributes.attributes_id, StateAttributes.shared_attrs
+        ).filter(
+            StateAttributes.attributes_id.in_(
+                attributes_ids[offset : offset + MAX_IDS_PER_QUERY]
+            )
+        )
 
 
 def _sorted_states_to_dict(
@@ -414,6 +912,16 @@ def _sorted_states_to_dict(
             # a full state
             ent_results[-1] = LazyState(prev_state)
 
+    _load_shared_attributes(
+        session,
+        [
+            state
+            for ent_results in result.values()
+            for state in ent_results
+            if isinstance(state, LazyState)
+        ],
+    )
+
     # Filter out the empty lists if some states had 0 results.
     return {key: val for key, val in result.items() if val}
 
@@ -0,0 +1,86 @@
+"""Maintain the state changes shown in the logbook while recording."""
+from __future__ import annotations
+
+from datetime import datetime
+from typing import Any
+
+from sqlalchemy.orm.session import Session
+
+from homeassistant.const import ATTR_FRIENDLY_NAME, ATTR_ICON, ATTR_UNIT_OF_MEASUREMENT
+from homeassistant.core import Event
+from homeassistant.helpers.json import json_dumps
+import homeassistant.util.dt as dt_util
+
+from .models import SchemaChanges, process_timestamp
+
+# Version of the schema that started recording the logbook states
+LOGBOOK_STATES_SCHEMA_VERSION = 24
+
+# Domains whose states with a unit are measurements, these are left
+# out of the logbook
+CONTINUOUS_DOMAINS = ["proximity", "sensor"]
+
+# Attributes the logbook shows for an entry
+LOGBOOK_ATTRIBUTES = (ATTR_FRIENDLY_NAME, ATTR_ICON)
+
+
+def logbook_state_columns(event: Event, has_old_state: bool) -> dict[str, Any] | None:
+    """Return the logbook columns of a state_changed event.
+
+    Returns None for the changes the logbook does not show: states
+    without a recorded previous state, removed entities, changes of
+    the attributes only and measurements of continuous domains.
+    """
+    if not has_old_state:
+        return None
+    old_state = event.data.get("old_state")
+    if (new_state := event.data.get("new_state")) is None or old_state is None:
+        return None
+    if (
+        new_state.state == old_state.state
+        or new_state.last_changed != new_state.last_updated
+    ):
+        return None
+    attributes = new_state.attributes
+    if (
+        new_state.domain in CONTINUOUS_DOMAINS
+        and ATTR_UNIT_OF_MEASUREMENT in attributes
+    ):
+        return None
+
+    context = event.context
+    return {
+        "time_fired": event.time_fired,
+        "domain": new_state.domain,
+        "entity_id": new_state.entity_id,
+        "state": new_state.state,
+        "attributes": json_dumps(
+            {key: attributes[key] for key in LOGBOOK_ATTRIBUTES if key in attributes},
+            compact=True,
+        ),
+        "context_id": context.id,
+        "context_user_id": context.user_id,
+        "context_parent_id": context.parent_id,
+    }
+
+
+def get_logbook_states_start(session: Session) -> datetime | None:
+    """Return from when on the logbook states are recorded.
+
+    Databases created with the logbook states have them for all states,
+    migrated databases since the migration. None if they are not recorded.
+    """
+    changes = session.query(
+        SchemaChanges.schema_version, SchemaChanges.changed
+    ).order_by(SchemaChanges.change_id)
+    first = changes.first()
+    if first is None:
+        return None
+    if first.schema_version >= LOGBOOK_STATES_SCHEMA_VERSION:
+        return dt_util.utc_from_timestamp(0)
+    migrated = changes.filter(
+        SchemaChanges.schema_version >= LOGBOOK_STATES_SCHEMA_VERSION
+    ).first()
+    if migrated is None:
+        return None
+    return process_timestamp(migrated.changed)
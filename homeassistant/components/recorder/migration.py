@@ -17,7 +17,9 @@ from .models import (
     SCHEMA_VERSION,
     TABLE_STATES,
     Base,
+    LogbookStates,
     SchemaChanges,
+    StateAttributes,
     Statistics,
     StatisticsMeta,
     StatisticsRuns,
@@ -353,6 +355,26 @@ def _drop_foreign_key_constraints(connection, engine, table, columns):
             )
 
 
+def _add_foreign_key_constraint(connection, engine, table, columns):
+    """Add the foreign key constraint of the model for columns if it is missing."""
+    inspector = sqlalchemy.inspect(engine)
+    for foreign_key in inspector.get_foreign_keys(table):
+        if foreign_key["constrained_columns"] == columns:
+            return
+
+    for fkc in Base.metadata.tables[table].foreign_key_constraints:
+        if fkc.column_keys != columns:
+            continue
+        try:
+            connection.execute(AddConstraint(fkc))
+        except (InternalError, OperationalError):
+            _LOGGER.exception(
+                "Could not add foreign key constraint in %s table on %s",
+                table,
+                columns,
+            )
+
+
 def _apply_update(instance, session, new_version, old_version):  # noqa: C901
     """Perform operations to bring schema up to date."""
     engine = instance.engine
@@ -584,6 +606,33 @@ def _apply_update(instance, session, new_version, old_version):  # noqa: C901
                         sum=last_statistic.sum,
                     )
                 )
+    elif new_version == 23:
+        # New states share their attributes through the state_attributes
+        # table, existing rows keep their attributes in the states table
+        if not sqlalchemy.inspect(engine).has_table(StateAttributes.__tablename__):
+            StateAttributes.__table__.create(engine)
+        _add_columns(connection, "states", ["attributes_id INTEGER"])
+        _create_index(connection, "states", "ix_states_attributes_id")
+    elif new_version == 24:
+        # The logbook reads the states recorded before this version
+        # from the states table
+        if not sqlalchemy.inspect(engine).has_table(LogbookStates.__tablename__):
+            LogbookStates.__table__.create(engine)
+    elif new_version == 25:
+        # The attributes_id column was added without its foreign key
+        # constraint, SQLite can not add it to an existing table
+        if engine.dialect.name != "sqlite":
+            # Clear the references that would violate the constraint
+            connection.execute(
+                text(
+                    "UPDATE states SET attributes_id = NULL "
+                    "WHERE attributes_id IS NOT NULL AND attributes_id NOT IN "
+                    "(SELECT attributes_id FROM state_attributes)"
+                )
+            )
+            _add_foreign_key_constraint(
+                connection, engine, TABLE_STATES, ["attributes_id"]
+            )
     else:
         raise ValueError(f"No schema migration defined for version {new_version}")
 
@@ -3,11 +3,12 @@ from __future__ import annotations
 
 from collections.abc import Iterable
 from datetime import datetime, timedelta
-import json
+import hashlib
 import logging
 from typing import TypedDict, overload
 
 from sqlalchemy import (
+    BigInteger,
     Boolean,
     Column,
     DateTime,
@@ -34,14 +35,14 @@ from homeassistant.const import (
     MAX_LENGTH_STATE_STATE,
 )
 from homeassistant.core import Context, Event, EventOrigin, State, split_entity_id
-from homeassistant.helpers.json import JSONEncoder
+from homeassistant.helpers.json import json_dumps, json_loads
 import homeassistant.util.dt as dt_util
 
 # SQLAlchemy Schema
 # pylint: disable=invalid-name
 Base = declarative_base()
 
-SCHEMA_VERSION = 22
+SCHEMA_VERSION = 25
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -49,6 +50,8 @@ DB_TIMEZONE = "+00:00"
 
 TABLE_EVENTS = "events"
 TABLE_STATES = "states"
+TABLE_STATE_ATTRIBUTES = "state_attributes"
+TABLE_LOGBOOK_STATES = "logbook_states"
 TABLE_RECORDER_RUNS = "recorder_runs"
 TABLE_SCHEMA_CHANGES = "schema_changes"
 TABLE_STATISTICS = "statistics"
@@ -58,6 +61,8 @@ TABLE_STATISTICS_SHORT_TERM = "statistics_short_term"
 
 ALL_TABLES = [
     TABLE_STATES,
+    TABLE_STATE_ATTRIBUTES,
+    TABLE_LOGBOOK_STATES,
     TABLE_EVENTS,
     TABLE_RECORDER_RUNS,
     TABLE_SCHEMA_CHANGES,
@@ -112,8 +117,7 @@ class Events(Base):  # type: ignore
         """Create an event database object from a native event."""
         return Events(
             event_type=event.event_type,
-            event_data=event_data
-            or json.dumps(event.data, cls=JSONEncoder, separators=(",", ":")),
+            event_data=event_data or json_dumps(event.data, compact=True),
             origin=str(event.origin.value),
             time_fired=event.time_fired,
             context_id=event.context.id,
@@ -131,13 +135,13 @@ class Events(Base):  # type: ignore
         try:
             return Event(
                 self.event_type,
-                json.loads(self.event_data),
+                json_loads(self.event_data),
                 EventOrigin(self.origin),
                 process_timestamp(self.time_fired),
                 context=context,
             )
         except ValueError:
-            # When json.loads fails
+            # When json_loads fails
             _LOGGER.exception("Error converting to event: %s", self)
             return None
 
@@ -164,8 +168,13 @@ class States(Base):  # type: ignore
     last_updated = Column(DATETIME_TYPE, default=dt_util.utcnow, index=True)
     created = Column(DATETIME_TYPE, default=dt_util.utcnow)
     old_state_id = Column(Integer, ForeignKey("states.state_id"), index=True)
+    attributes_id = Column(
+        Integer, ForeignKey("state_attributes.attributes_id"), index=True
+    )
     event = relationship("Events", uselist=False)
     old_state = relationship("States", remote_side=[state_id])
+    # Joined when states are loaded, to_native needs the shared attributes
+    state_attributes = relationship("StateAttributes", uselist=False, lazy="joined")
 
     def __repr__(self) -> str:
         """Return string representation of instance for debugging."""
@@ -196,9 +205,7 @@ class States(Base):  # type: ignore
         else:
             dbstate.domain = state.domain
             dbstate.state = state.state
-            dbstate.attributes = json.dumps(
-                dict(state.attributes), cls=JSONEncoder, separators=(",", ":")
-            )
+            dbstate.attributes = json_dumps(dict(state.attributes), compact=True)
             dbstate.last_changed = state.last_changed
             dbstate.last_updated = state.last_updated
 
@@ -206,11 +213,17 @@ class States(Base):  # type: ignore
 
     def to_native(self, validate_entity_id=True):
         """Convert to an HA state object."""
+        attributes = self.attributes
+        if attributes is None:
+            # Rows written since schema version 23 share their
+            # attributes through the state_attributes table
+            shared = self.state_attributes
+            attributes = shared.shared_attrs if shared is not None else "{}"
         try:
             return State(
                 self.entity_id,
                 self.state,
-                json.loads(self.attributes),
+                json_loads(attributes),
                 process_timestamp(self.last_changed),
                 process_timestamp(self.last_updated),
                 # Join the events table on event_id to get the context instead
@@ -219,11 +232,84 @@ class States(Base):  # type: ignore
                 validate_entity_id=validate_entity_id,
             )
         except ValueError:
-            # When json.loads fails
+            # When json_loads fails
             _LOGGER.exception("Error converting row to state: %s", self)
             return None
 
 
+class StateAttributes(Base):  # type: ignore
+    """State attribute change history.
+
+    Attribute sets are stored once and shared by every state row
+    with the same attributes.
+    """
+
+    __table_args__ = (
+        {"mysql_default_charset": "utf8mb4", "mysql_collate": "utf8mb4_unicode_ci"},
+    )
+    __tablename__ = TABLE_STATE_ATTRIBUTES
+    attributes_id = Column(Integer, Identity(), primary_key=True)
+    hash = Column(BigInteger, index=True)
+    # Note that this is not named attributes to avoid confusion with the states table
+    shared_attrs = Column(Text().with_variant(mysql.LONGTEXT, "mysql"))
+
+    def __repr__(self) -> str:
+        """Return string representation of instance for debugging."""
+        return (
+            f"<recorder.StateAttributes("
+            f"id={self.attributes_id}, hash='{self.hash}', attributes='{self.shared_attrs}'"
+            f")>"
+        )
+
+    @staticmethod
+    def hash_shared_attrs(shared_attrs: str) -> int:
+        """Return a stable signed 64 bit hash of the shared attributes."""
+        return int.from_bytes(
+            hashlib.blake2b(shared_attrs.encode("utf-8"), digest_size=8).digest(),
+            "big",
+            signed=True,
+        )
+
+
+class LogbookStates(Base):  # type: ignore
+    """State changes shown in the logbook.
+
+    Written next to the states row for changes of the state itself,
+    with only the attributes the logbook displays, so the logbook does
+    not have to join the states it filters away.
+    """
+
+    __table_args__ = (
+        # Used for fetching the logbook of entities
+        Index("ix_logbook_states_entity_id_time_fired", "entity_id", "time_fired"),
+        {"mysql_default_charset": "utf8mb4", "mysql_collate": "utf8mb4_unicode_ci"},
+    )
+    __tablename__ = TABLE_LOGBOOK_STATES
+    logbook_state_id = Column(Integer, Identity(), primary_key=True)
+    event_id = Column(
+        Integer, ForeignKey("events.event_id", ondelete="CASCADE"), index=True
+    )
+    time_fired = Column(DATETIME_TYPE, index=True)
+    domain = Column(String(MAX_LENGTH_STATE_DOMAIN))
+    entity_id = Column(String(MAX_LENGTH_STATE_ENTITY_ID))
+    state = Column(String(MAX_LENGTH_STATE_STATE))
+    attributes = Column(Text().with_variant(mysql.LONGTEXT, "mysql"))
+    context_id = Column(String(MAX_LENGTH_EVENT_CONTEXT_ID), index=True)
+    context_user_id = Column(String(MAX_LENGTH_EVENT_CONTEXT_ID))
+    context_parent_id = Column(String(MAX_LENGTH_EVENT_CONTEXT_ID))
+    event = relationship("Events", uselist=False)
+
+    def __repr__(self) -> str:
+        """Return string representation of instance for debugging."""
+        return (
+            f"<recorder.LogbookStates("
+            f"id={self.logbook_state_id}, entity_id='{self.entity_id}', "
+            f"state='{self.state}', event_id='{self.event_id}', "
+            f"time_fired='{self.time_fired}'"
+            f")>"
+        )
+
+
 class StatisticResult(TypedDict):
     """Statistic result data class.
 
@@ -480,6 +566,7 @@ class LazyState(State):
         "_row",
         "entity_id",
         "state",
+        "shared_attrs",
         "_attributes",
         "_last_changed",
         "_last_updated",
@@ -491,6 +578,7 @@ class LazyState(State):
         self._row = row
         self.entity_id = self._row.entity_id
         self.state = self._row.state or ""
+        self.shared_attrs = None
         self._attributes = None
         self._last_changed = None
         self._last_updated = None
@@ -500,10 +588,15 @@ class LazyState(State):
     def attributes(self):
         """State attributes."""
         if not self._attributes:
+            source = self._row.attributes
+            if source is None:
+                # The shared attributes are loaded by the history
+                # queries only for the states that need them
+                source = self.shared_attrs or "{}"
             try:
-                self._attributes = json.loads(self._row.attributes)
+                self._attributes = json_loads(source)
             except ValueError:
-                # When json.loads fails
+                # When json_loads fails
                 _LOGGER.exception("Error converting row to state: %s", self._row)
                 self._attributes = {}
         return self._attributes
@@ -513,6 +606,13 @@ class LazyState(State):
         """Set attributes."""
         self._attributes = value
 
+    @property
+    def pending_attributes_id(self):
+        """Return the id of the shared attributes if they still need loading."""
+        if self._row.attributes is not None or self.shared_attrs is not None:
+            return None
+        return self._row.attributes_id
+
     @property  # type: ignore
     def context(self):
         """State context."""
@@ -0,0 +1,182 @@
+"""Daily partitions of the events and states tables for MySQL and MariaDB."""
+from __future__ import annotations
+
+from datetime import date, datetime, timedelta
+import logging
+
+import sqlalchemy
+from sqlalchemy import text
+from sqlalchemy.orm.session import Session
+
+import homeassistant.util.dt as dt_util
+
+from .models import TABLE_EVENTS, TABLE_LOGBOOK_STATES, TABLE_STATES
+
+_LOGGER = logging.getLogger(__name__)
+
+PARTITION_DIALECTS = {"mysql", "mariadb"}
+
+# The tables partitioned by day with their primary key and the
+# timestamp column rows are partitioned by
+PARTITIONED_TABLES = {
+    TABLE_STATES: ("state_id", "last_updated"),
+    TABLE_LOGBOOK_STATES: ("logbook_state_id", "time_fired"),
+    TABLE_EVENTS: ("event_id", "time_fired"),
+}
+
+# Partitions are created ahead for this many days, rows of later days
+# go to the catch all partition until the next nightly maintenance
+PARTITION_DAYS_AHEAD = 3
+
+CATCH_ALL_PARTITION = "pmax"
+
+# TO_DAYS of MySQL counts from year 0, date.toordinal from year 1
+TO_DAYS_OFFSET = 365
+
+
+def partitions_supported(dialect_name: str) -> bool:
+    """Return if the tables can be partitioned by day with the dialect."""
+    return dialect_name in PARTITION_DIALECTS
+
+
+def setup_partitions(session: Session, keep_days: int) -> None:
+    """Partition the tables by day and create the partitions for the next days.
+
+    Partitioned InnoDB tables can not have foreign keys or be referred to by
+    one, so the foreign keys of the partitioned tables are dropped. The day
+    column has to be part of the primary key.
+    """
+    existing = {
+        table: _partition_bounds(session, table) for table in PARTITIONED_TABLES
+    }
+    if all(existing.values()):
+        create_future_partitions(session)
+        return
+
+    today = dt_util.utcnow().date()
+    # The first partition also holds the older rows, they are dropped
+    # with it by the next purge
+    days = _partition_days(today - timedelta(days=keep_days), today)
+    for table in PARTITIONED_TABLES:
+        _drop_foreign_keys(session, table)
+    for table, (primary_key, day_column) in PARTITIONED_TABLES.items():
+        if existing[table]:
+            continue
+        _LOGGER.warning(
+            "Partitioning table `%s` by day. Note: this can take several "
+            "minutes on large databases and slow computers. Please "
+            "be patient!",
+            table,
+        )
+        # Primary key columns can not be NULL
+        session.execute(
+            text(
+                f"UPDATE {table} SET {day_column} = UTC_TIMESTAMP() "
+                f"WHERE {day_column} IS NULL"
+            )
+        )
+        session.execute(
+            text(
+                f"ALTER TABLE {table} DROP PRIMARY KEY, "
+                f"ADD PRIMARY KEY ({primary_key}, {day_column}) "
+                f"PARTITION BY RANGE (TO_DAYS({day_column})) "
+                f"({_partition_definitions(days)})"
+            )
+        )
+
+
+def create_future_partitions(session: Session) -> None:
+    """Split the partitions for the next days off the catch all partition."""
+    last_day = dt_util.utcnow().date()
+    for table in PARTITIONED_TABLES:
+        if not (bounds := _partition_bounds(session, table)):
+            continue
+        # Days before the bound of the last partition have one
+        days = _partition_days(_from_days(max(bounds.values())), last_day)
+        if not days:
+            continue
+        _LOGGER.debug("Adding partitions to %s for %s", table, days)
+        session.execute(
+            text(
+                f"ALTER TABLE {table} REORGANIZE PARTITION {CATCH_ALL_PARTITION} "
+                f"INTO ({_partition_definitions(days)})"
+            )
+        )
+
+
+def partitions_before(
+    session: Session, table: str, before: datetime
+) -> dict[str, date]:
+    """Return the partitions of a table that only hold rows older than before.
+
+    Each partition is mapped to the day its rows end before.
+    """
+    before_days = _to_days(before.date())
+    return {
+        name: _from_days(bound)
+        for name, bound in _partition_bounds(session, table).items()
+        if bound <= before_days
+    }
+
+
+def drop_partitions(session: Session, table: str, names: list[str]) -> None:
+    """Drop the partitions of a table along with their rows."""
+    _LOGGER.debug("Dropping partitions %s of %s", names, table)
+    session.execute(text(f"ALTER TABLE {table} DROP PARTITION {', '.join(names)}"))
+
+
+def _partition_bounds(session: Session, table: str) -> dict[str, int]:
+    """Return the bound of each daily partition of a table, as TO_DAYS."""
+    return {
+        name: int(description)
+        for name, description in session.execute(
+            text(
+                "SELECT PARTITION_NAME, PARTITION_DESCRIPTION "
+                "FROM information_schema.PARTITIONS "
+                "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = :table "
+                "AND PARTITION_NAME IS NOT NULL"
+            ),
+            {"table": table},
+        )
+        if description != "MAXVALUE"
+    }
+
+
+def _drop_foreign_keys(session: Session, table: str) -> None:
+    """Drop the foreign keys of a table, partitioned tables can not have them."""
+    inspector = sqlalchemy.inspect(session.connection())
+    for foreign_key in inspector.get_foreign_keys(table):
+        _LOGGER.debug("Dropping foreign key %s of %s", foreign_key["name"], table)
+        session.execute(
+            text(f"ALTER TABLE {table} DROP FOREIGN KEY {foreign_key['name']}")
+        )
+
+
+def _partition_definitions(days: list[date]) -> str:
+    """Return the definitions of the partitions of the days and the catch all."""
+    definitions = [
+        f"PARTITION p{day:%Y%m%d} "
+        f"VALUES LESS THAN ({_to_days(day + timedelta(days=1))})"
+        for day in days
+    ]
+    definitions.append(f"PARTITION {CATCH_ALL_PARTITION} VALUES LESS THAN MAXVALUE")
+    return ", ".join(definitions)
+
+
+def _partition_days(first_day: date, today: date) -> list[date]:
+    """Return the days from first_day that need a partition."""
+    last_day = today + timedelta(days=PARTITION_DAYS_AHEAD)
+    return [
+        first_day + timedelta(days=offset)
+        for offset in range((last_day - first_day).days + 1)
+    ]
+
+
+def _to_days(day: date) -> int:
+    """Return the day as the MySQL TO_DAYS function does."""
+    return day.toordinal() + TO_DAYS_OFFSET
+
+
+def _from_days(days: int) -> date:
+    """Return the day of a MySQL TO_DAYS value."""
+    return date.fromordinal(days - TO_DAYS_OFFSET)
@@ -1,5 +1,7 @@
 """A pool for sqlite connections."""
+import sqlite3
 import threading
+from urllib.request import pathname2url
 
 from sqlalchemy.pool import NullPool, StaticPool
 
@@ -32,3 +34,14 @@ class RecorderPool(StaticPool, NullPool):
         return super(  # pylint: disable=bad-super-call
             NullPool, self
         )._create_connection()
+
+
+def connect_sqlite_read_only(path: str) -> sqlite3.Connection:
+    """Open a read only connection to an sqlite database file.
+
+    Readers do not block the recorder, or each other, since the recorder
+    runs the database in WAL mode.
+    """
+    return sqlite3.connect(
+        f"file:{pathname2url(path)}?mode=ro", uri=True, check_same_thread=False
+    )
@@ -4,13 +4,28 @@ from __future__ import annotations
 from collections.abc import Callable
 from datetime import datetime
 import logging
-from typing import TYPE_CHECKING
+import queue
+import threading
+from typing import TYPE_CHECKING, Any
 
+from sqlalchemy import text
+from sqlalchemy.exc import SQLAlchemyError
 from sqlalchemy.orm.session import Session
-from sqlalchemy.sql.expression import distinct
-
-from .const import MAX_ROWS_TO_PURGE
-from .models import Events, RecorderRuns, States
+from sqlalchemy.sql.expression import distinct, exists
+
+from homeassistant.helpers.entityfilter import EntityFilter
+import homeassistant.util.dt as dt_util
+
+from .const import MAX_IDS_PER_QUERY, MAX_ROWS_TO_PURGE
+from .models import (
+    TABLE_STATES,
+    Events,
+    LogbookStates,
+    RecorderRuns,
+    StateAttributes,
+    States,
+)
+from .partitions import PARTITIONED_TABLES, drop_partitions, partitions_before
 from .repack import repack_database
 from .util import retryable_database_job, session_scope
 
@@ -32,6 +47,7 @@ def purge_old_data(
         "Purging states and events before target %s",
         purge_before.isoformat(sep=" ", timespec="seconds"),
     )
+    instance.statistics_states.purge(purge_before)
 
     with session_scope(session=instance.get_session()) as session:  # type: ignore
         # Purge a max of MAX_ROWS_TO_PURGE, based on the oldest states or events record
@@ -55,6 +71,87 @@ def purge_old_data(
     return True
 
 
+def drop_old_partitions(instance: Recorder, purge_before: datetime) -> None:
+    """Drop the daily partitions that only hold rows older than purge_before.
+
+    The rows of the day purge_before falls in are left for the purge by row.
+    """
+    try:
+        with session_scope(session=instance.get_session()) as session:  # type: ignore
+            _drop_old_partitions(instance, session, purge_before)
+    except SQLAlchemyError:
+        _LOGGER.exception("Error dropping old partitions, purging their rows instead")
+
+
+def _drop_old_partitions(
+    instance: Recorder, session: Session, purge_before: datetime
+) -> None:
+    """Drop the old partitions and clean up what referred to their states."""
+    old_partitions = {
+        table: partitions_before(session, table, purge_before)
+        for table in PARTITIONED_TABLES
+    }
+    if old_states_partitions := old_partitions[TABLE_STATES]:
+        end = max(old_states_partitions.values())
+        before = datetime(end.year, end.month, end.day, tzinfo=dt_util.UTC)
+        _evict_purged_states_from_old_states_cache(
+            instance,
+            _select_state_ids_before(session, protected_state_ids(instance), before),
+        )
+        # Partitioned tables have no foreign keys to do this for us
+        disconnected_rows = session.execute(
+            text(
+                "UPDATE states AS kept JOIN states AS dropped "
+                "ON kept.old_state_id = dropped.state_id "
+                "SET kept.old_state_id = NULL "
+                "WHERE dropped.last_updated < :before AND kept.last_updated >= :before"
+            ),
+            {"before": before},
+        ).rowcount
+        _LOGGER.debug("Updated %s states to remove old_state_id", disconnected_rows)
+
+    for table, names in old_partitions.items():
+        if names:
+            drop_partitions(session, table, list(names))
+
+    if old_states_partitions:
+        _purge_all_unused_attributes(instance, session)
+
+
+def _select_state_ids_before(
+    session: Session, state_ids: set[int], before: datetime
+) -> set[int]:
+    """Return the ids of the states last updated before a point in time."""
+    state_ids_list = list(state_ids)
+    old_state_ids: set[int] = set()
+    for offset in range(0, len(state_ids_list), MAX_IDS_PER_QUERY):
+        for (state_id,) in (
+            session.query(States.state_id)
+            .filter(
+                States.state_id.in_(state_ids_list[offset : offset + MAX_IDS_PER_QUERY])
+            )
+            .filter(States.last_updated < before)
+        ):
+            old_state_ids.add(state_id)
+    return old_state_ids
+
+
+def _purge_all_unused_attributes(instance: Recorder, session: Session) -> None:
+    """Delete the shared attributes no state refers to, in batches."""
+    last_attributes_id = 0
+    while attributes_ids := [
+        attributes_id
+        for (attributes_id,) in session.query(StateAttributes.attributes_id)
+        .filter(StateAttributes.attributes_id > last_attributes_id)
+        .filter(~exists().where(States.attributes_id == StateAttributes.attributes_id))
+        .order_by(StateAttributes.attributes_id)
+        .limit(MAX_ROWS_TO_PURGE)
+        .all()
+    ]:
+        _purge_unused_attributes_ids(instance, session, set(attributes_ids))
+        last_attributes_id = attributes_ids[-1]
+
+
 def _select_event_ids_to_purge(session: Session, purge_before: datetime) -> list[int]:
     """Return a list of event ids to purge."""
     events = (
@@ -85,6 +182,20 @@ def _select_state_ids_to_purge(
 
 def _purge_state_ids(instance: Recorder, session: Session, state_ids: set[int]) -> None:
     """Disconnect states and delete by state id."""
+    attributes_ids = _delete_state_ids(session, state_ids)
+
+    # Evict eny entries in the old_states cache referring to a purged state
+    _evict_purged_states_from_old_states_cache(instance, state_ids)
+
+    if attributes_ids:
+        _purge_unused_attributes_ids(instance, session, attributes_ids)
+
+
+def _delete_state_ids(session: Session, state_ids: set[int]) -> set[int]:
+    """Disconnect and delete states, leaving the recorder caches alone.
+
+    Return the ids of the shared attributes the deleted states referred to.
+    """
 
     # Update old_state_id to NULL before deleting to ensure
     # the delete does not fail due to a foreign key constraint
@@ -97,15 +208,45 @@ def _purge_state_ids(instance: Recorder, session: Session, state_ids: set[int])
     )
     _LOGGER.debug("Updated %s states to remove old_state_id", disconnected_rows)
 
+    attributes_ids = {
+        attributes_id
+        for (attributes_id,) in session.query(distinct(States.attributes_id))
+        .filter(States.state_id.in_(state_ids))
+        .filter(States.attributes_id.isnot(None))
+        .all()
+    }
+
     deleted_rows = (
         session.query(States)
         .filter(States.state_id.in_(state_ids))
         .delete(synchronize_session=False)
     )
     _LOGGER.debug("Deleted %s states", deleted_rows)
+    return attributes_ids
 
-    # Evict eny entries in the old_states cache referring to a purged state
-    _evict_purged_states_from_old_states_cache(instance, state_ids)
+
+def _purge_unused_attributes_ids(
+    instance: Recorder, session: Session, attributes_ids: set[int]
+) -> None:
+    """Delete the shared attributes no state refers to anymore."""
+    state_attributes = instance._state_attributes  # pylint: disable=protected-access
+    still_used = {
+        attributes_id
+        for (attributes_id,) in session.query(distinct(States.attributes_id))
+        .filter(States.attributes_id.in_(attributes_ids))
+        .all()
+    }
+    # States waiting in the event session may refer to them as well
+    unused_ids = attributes_ids - still_used - state_attributes.uncommitted_references
+    if not unused_ids:
+        return
+    deleted_rows = (
+        session.query(StateAttributes)
+        .filter(StateAttributes.attributes_id.in_(unused_ids))
+        .delete(synchronize_session=False)
+    )
+    _LOGGER.debug("Deleted %s attribute states", deleted_rows)
+    state_attributes.evict_purged(unused_ids)
 
 
 def _evict_purged_states_from_old_states_cache(
@@ -124,9 +265,32 @@ def _evict_purged_states_from_old_states_cache(
     for purged_state_id in purged_state_ids.intersection(old_state_reversed):
         old_states.pop(old_state_reversed[purged_state_id], None)
 
+    bulk_writer = instance._bulk_writer  # pylint: disable=protected-access
+    if bulk_writer is not None:
+        bulk_writer.evict_purged_states(purged_state_ids)
+
+
+def protected_state_ids(instance: Recorder) -> set[int]:
+    """Return the ids of the states new states may still link to as old state."""
+    old_states = instance._old_states  # pylint: disable=protected-access
+    state_ids = {
+        old_state.state_id for old_state in old_states.values() if old_state.state_id
+    }
+    bulk_writer = instance._bulk_writer  # pylint: disable=protected-access
+    if bulk_writer is not None:
+        state_ids.update(bulk_writer.old_state_ids.values())
+    return state_ids
+
 
 def _purge_event_ids(session: Session, event_ids: list[int]) -> None:
     """Delete by event id."""
+    deleted_rows = (
+        session.query(LogbookStates)
+        .filter(LogbookStates.event_id.in_(event_ids))
+        .delete(synchronize_session=False)
+    )
+    _LOGGER.debug("Deleted %s logbook states", deleted_rows)
+
     deleted_rows = (
         session.query(Events)
         .filter(Events.event_id.in_(event_ids))
@@ -154,13 +318,8 @@ def _purge_filtered_data(instance: Recorder, session: Session) -> bool:
     _LOGGER.debug("Cleanup filtered data")
 
     # Check if excluded entity_ids are in database
-    excluded_entity_ids: list[str] = [
-        entity_id
-        for (entity_id,) in session.query(distinct(States.entity_id)).all()
-        if not instance.entity_filter(entity_id)
-    ]
-    if len(excluded_entity_ids) > 0:
-        _purge_filtered_states(instance, session, excluded_entity_ids)
+    excluded = _entities_condition(session, instance.entity_filter, selected=False)
+    if excluded is not None and _purge_filtered_states(instance, session, excluded):
         return False
 
     # Check if excluded event_types are in database
@@ -176,26 +335,54 @@ def _purge_filtered_data(instance: Recorder, session: Session) -> bool:
     return True
 
 
+def _entities_condition(
+    session: Session, entity_filter: Callable[[str], bool], selected: bool
+) -> Any:
+    """Return the condition for the states of entities the filter passes or not.
+
+    A compiled entity filter is turned into a SQL predicate, otherwise the
+    filter is run on the entity_ids in the database. None if no entity_id
+    needs to be purged.
+    """
+    if isinstance(entity_filter, EntityFilter) and entity_filter.supports_sql:
+        predicate = entity_filter.sql_predicate(States.entity_id)
+        return predicate if selected else ~predicate
+
+    entity_ids: list[str] = [
+        entity_id
+        for (entity_id,) in session.query(distinct(States.entity_id)).all()
+        if entity_filter(entity_id) is selected
+    ]
+    if not entity_ids:
+        return None
+    return States.entity_id.in_(entity_ids)
+
+
 def _purge_filtered_states(
-    instance: Recorder, session: Session, excluded_entity_ids: list[str]
-) -> None:
-    """Remove filtered states and linked events."""
+    instance: Recorder, session: Session, condition: Any
+) -> bool:
+    """Remove filtered states and linked events.
+
+    Return if there were states to remove.
+    """
     state_ids: list[int]
     event_ids: list[int | None]
-    state_ids, event_ids = zip(
-        *(
-            session.query(States.state_id, States.event_id)
-            .filter(States.entity_id.in_(excluded_entity_ids))
-            .limit(MAX_ROWS_TO_PURGE)
-            .all()
-        )
+    rows = (
+        session.query(States.state_id, States.event_id)
+        .filter(condition)
+        .limit(MAX_ROWS_TO_PURGE)
+        .all()
     )
+    if not rows:
+        return False
+    state_ids, event_ids = zip(*rows)
     event_ids = [id_ for id_ in event_ids if id_ is not None]
     _LOGGER.debug(
         "Selected %s state_ids to remove that should be filtered", len(state_ids)
     )
     _purge_state_ids(instance, session, set(state_ids))
     _purge_event_ids(session, event_ids)  # type: ignore  # type of event_ids already narrowed to 'list[int]'
+    return True
 
 
 def _purge_filtered_events(
@@ -223,17 +410,160 @@ def _purge_filtered_events(
 @retryable_database_job("purge")
 def purge_entity_data(instance: Recorder, entity_filter: Callable[[str], bool]) -> bool:
     """Purge states and events of specified entities."""
+    instance.statistics_states.forget(entity_filter)
     with session_scope(session=instance.get_session()) as session:  # type: ignore
-        selected_entity_ids: list[str] = [
-            entity_id
-            for (entity_id,) in session.query(distinct(States.entity_id)).all()
-            if entity_filter(entity_id)
-        ]
-        _LOGGER.debug("Purging entity data for %s", selected_entity_ids)
-        if len(selected_entity_ids) > 0:
-            # Purge a max of MAX_ROWS_TO_PURGE, based on the oldest states or events record
-            _purge_filtered_states(instance, session, selected_entity_ids)
+        selected = _entities_condition(session, entity_filter, selected=True)
+        # Purge a batch of the states of the selected entities
+        if selected is not None and _purge_filtered_states(
+            instance, session, selected
+        ):
             _LOGGER.debug("Purging entity data hasn't fully completed yet")
             return False
 
     return True
+
+
+@retryable_database_job("purge")
+def purge_unused_attributes(instance: Recorder, attributes_ids: set[int]) -> bool:
+    """Delete the shared attributes left unused by a purge off the recorder thread."""
+    with session_scope(session=instance.get_session()) as session:  # type: ignore
+        _purge_unused_attributes_ids(instance, session, attributes_ids)
+    return True
+
+
+class OldDataPurge:
+    """Progress of a purge of old data off the recorder thread."""
+
+    def __init__(
+        self,
+        purge_before: datetime,
+        repack: bool,
+        apply_filter: bool,
+        protected_state_ids: set[int],
+    ) -> None:
+        """Initialize the purge."""
+        self.purge_before = purge_before
+        self.repack = repack
+        self.apply_filter = apply_filter
+        # States that new states may link to, they are left for the recorder
+        # thread along with their events
+        self.protected_state_ids = protected_state_ids
+        self.protected_event_ids: set[int] | None = None
+        # Events up to this id are purged or left for the recorder thread
+        self.last_event_id = 0
+
+
+class PurgeWorker(threading.Thread):
+    """Purge old events and states without blocking the recorder thread.
+
+    Each batch is committed in a session of its own. The shared attributes
+    are cached by the recorder, so deleting the unused ones is queued to the
+    recorder thread, as is the rest of the purge once the old data is gone.
+    """
+
+    def __init__(self, instance: Recorder) -> None:
+        """Initialize the worker."""
+        threading.Thread.__init__(self, name="Recorder purge")
+        self.instance = instance
+        self.queue: queue.SimpleQueue[
+            OldDataPurge | threading.Event | None
+        ] = queue.SimpleQueue()
+        self._stopping = threading.Event()
+
+    def run(self) -> None:
+        """Run the queued purges in turn."""
+        while (item := self.queue.get()) is not None:
+            if isinstance(item, threading.Event):
+                item.set()
+            elif not self._stopping.is_set():
+                self._purge(item)
+
+    def _purge(self, purge: OldDataPurge) -> None:
+        """Purge the old data in batches until it is done or the worker stops."""
+        instance = self.instance
+        while not self._stopping.is_set():
+            try:
+                finished = _purge_old_data_batch(instance, purge)
+            except Exception as err:  # pylint: disable=broad-except
+                # The recorder thread purges what is left and recovers
+                # the database if needed
+                _LOGGER.exception("Error purging old data: %s", err)
+                finished = True
+            if finished:
+                instance.queue_purge_remaining(
+                    purge.purge_before, purge.repack, purge.apply_filter
+                )
+                return
+
+    def block_till_done(self) -> None:
+        """Block till the queued purges are done.
+
+        This is only called in tests.
+        """
+        done = threading.Event()
+        self.queue.put(done)
+        while self.is_alive() and not done.wait(0.1):
+            pass
+
+    def stop(self) -> None:
+        """Stop after the current batch."""
+        self._stopping.set()
+        self.queue.put(None)
+        self.join()
+
+
+@retryable_database_job("purge")
+def _purge_old_data_batch(instance: Recorder, purge: OldDataPurge) -> bool:
+    """Purge a batch of old events and states off the recorder thread.
+
+    Return True once nothing is left that can be purged off the recorder
+    thread.
+    """
+    with session_scope(session=instance.get_session()) as session:  # type: ignore
+        if purge.protected_event_ids is None:
+            purge.protected_event_ids = _select_event_ids_of_states(
+                session, purge.protected_state_ids
+            )
+        # Walk the events in id order, the protected ones are never purged here
+        selected_ids = [
+            event_id
+            for (event_id,) in session.query(Events.event_id)
+            .filter(Events.time_fired < purge.purge_before)
+            .filter(Events.event_id > purge.last_event_id)
+            .order_by(Events.event_id)
+            .limit(MAX_ROWS_TO_PURGE)
+            .all()
+        ]
+        if not selected_ids:
+            return True
+        event_ids = [
+            event_id
+            for event_id in selected_ids
+            if event_id not in purge.protected_event_ids
+        ]
+        _LOGGER.debug("Selected %s event ids to remove", len(event_ids))
+        state_ids = _select_state_ids_to_purge(session, purge.purge_before, event_ids)
+        attributes_ids = _delete_state_ids(session, state_ids) if state_ids else set()
+        if event_ids:
+            _purge_event_ids(session, event_ids)
+
+    purge.last_event_id = selected_ids[-1]
+    if attributes_ids:
+        instance.queue_purge_unused_attributes(attributes_ids)
+    return False
+
+
+def _select_event_ids_of_states(session: Session, state_ids: set[int]) -> set[int]:
+    """Return the ids of the events of the states."""
+    state_ids_list = list(state_ids)
+    event_ids: set[int] = set()
+    for offset in range(0, len(state_ids_list), MAX_IDS_PER_QUERY):
+        for (event_id,) in (
+            session.query(States.event_id)
+            .filter(
+                States.state_id.in_(state_ids_list[offset : offset + MAX_IDS_PER_QUERY])
+            )
+            .filter(States.event_id.isnot(None))
+        ):
+            event_ids.add(event_id)
+    return event_ids
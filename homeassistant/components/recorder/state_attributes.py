@@ -0,0 +1,90 @@
+"""Deduplicate state attributes for the recorder."""
+from __future__ import annotations
+
+from sqlalchemy.orm.session import Session
+
+from .models import StateAttributes
+
+# Number of committed attribute sets whose ids are held in memory
+STATE_ATTRIBUTES_ID_CACHE_SIZE = 2048
+
+
+class StateAttributesManager:
+    """Map attribute sets to the state_attributes rows that store them.
+
+    Lookups are keyed by the content hash of the attributes JSON. The
+    ids of recently used rows are cached so the database only has to be
+    consulted the first time an attribute set is seen in this run.
+
+    This class must only be used from the recorder thread.
+    """
+
+    def __init__(self) -> None:
+        """Initialize the manager."""
+        self._id_cache: dict[int, int] = {}
+        self._pending: dict[int, StateAttributes] = {}
+        self._pending_ids: dict[int, int] = {}
+        # Stored rows referenced by states that are not committed yet
+        self.uncommitted_references: set[int] = set()
+
+    def get_id(self, session: Session, attr_hash: int, shared_attrs: str) -> int | None:
+        """Return the id of a stored or pending row with these attributes."""
+        id_cache = self._id_cache
+        if (attributes_id := id_cache.pop(attr_hash, None)) is not None:
+            # Move to the end so the most recently used ids are kept
+            id_cache[attr_hash] = attributes_id
+            self.uncommitted_references.add(attributes_id)
+            return attributes_id
+        if (attributes_id := self._pending_ids.get(attr_hash)) is not None:
+            return attributes_id
+        with session.no_autoflush:
+            for row in session.query(
+                StateAttributes.attributes_id, StateAttributes.shared_attrs
+            ).filter(StateAttributes.hash == attr_hash):
+                if row.shared_attrs == shared_attrs:
+                    self._cache_id(attr_hash, row.attributes_id)
+                    self.uncommitted_references.add(row.attributes_id)
+                    return row.attributes_id
+        return None
+
+    def get_pending(self, attr_hash: int) -> StateAttributes | None:
+        """Return a row added to the session that is not committed yet."""
+        return self._pending.get(attr_hash)
+
+    def add_pending(self, dbattrs: StateAttributes) -> None:
+        """Track a row added to the session until it is committed."""
+        self._pending[dbattrs.hash] = dbattrs
+
+    def add_pending_id(self, attr_hash: int, attributes_id: int) -> None:
+        """Track an id assigned by the bulk writer until it is committed."""
+        self._pending_ids[attr_hash] = attributes_id
+
+    def post_commit(self) -> None:
+        """Move the committed rows into the id cache."""
+        for attr_hash, dbattrs in self._pending.items():
+            self._cache_id(attr_hash, dbattrs.attributes_id)
+        for attr_hash, attributes_id in self._pending_ids.items():
+            self._cache_id(attr_hash, attributes_id)
+        self._pending = {}
+        self._pending_ids = {}
+        self.uncommitted_references = set()
+
+    def reset(self) -> None:
+        """Forget everything after the session was rolled back."""
+        self._id_cache = {}
+        self._pending = {}
+        self._pending_ids = {}
+        self.uncommitted_references = set()
+
+    def evict_purged(self, purged_attributes_ids: set[int]) -> None:
+        """Forget ids of rows that were purged from the database."""
+        for attr_hash, attributes_id in list(self._id_cache.items()):
+            if attributes_id in purged_attributes_ids:
+                del self._id_cache[attr_hash]
+
+    def _cache_id(self, attr_hash: int, attributes_id: int) -> None:
+        """Cache an id and drop the least recently used one when full."""
+        id_cache = self._id_cache
+        id_cache[attr_hash] = attributes_id
+        if len(id_cache) > STATE_ATTRIBUTES_ID_CACHE_SIZE:
+            del id_cache[next(iter(id_cache))]
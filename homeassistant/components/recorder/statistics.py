@@ -234,20 +234,98 @@ def _update_or_add_metadata(
     return metadata_id
 
 
+class ShortTermStatisticsSummary:
+    """The 5-minute statistics compiled during the current hour.
+
+    Lets the hourly statistics be summarized without reading the 5-minute
+    statistics back from the database when all periods of the hour were
+    compiled by this recorder.
+
+    This class must only be used from the recorder thread.
+    """
+
+    def __init__(self) -> None:
+        """Initialize the summary."""
+        self._hour: datetime | None = None
+        # period start -> (metadata_id, statistics) added in the period
+        self._periods: dict[datetime, list[tuple[int, StatisticData]]] = {}
+
+    def reset(self) -> None:
+        """Forget the compiled periods."""
+        self._hour = None
+        self._periods = {}
+
+    def add(self, start: datetime, rows: list[tuple[int, StatisticData]]) -> None:
+        """Add the statistics compiled for a 5-minute period."""
+        hour = start.replace(minute=0)
+        if hour != self._hour:
+            self._hour = hour
+            self._periods = {}
+        self._periods[start] = rows
+
+    def discard(self, start: datetime) -> None:
+        """Forget a period whose statistics were not saved."""
+        self._periods.pop(start, None)
+
+    def hourly_summary(self, start: datetime) -> dict[int, StatisticData] | None:
+        """Summarize the hour like the database query, None if periods are missing."""
+        hour = start.replace(minute=0)
+        if hour != self._hour or len(self._periods) != 12:
+            return None
+        if any(hour + timedelta(minutes=5 * i) not in self._periods for i in range(12)):
+            return None
+
+        stats_by_id: dict[int, list[StatisticData]] = defaultdict(list)
+        for period in sorted(self._periods):
+            for metadata_id, stat in self._periods[period]:
+                stats_by_id[metadata_id].append(stat)
+
+        summary: dict[int, StatisticData] = {}
+        for metadata_id, stats in stats_by_id.items():
+            means = [_mean for stat in stats if (_mean := stat.get("mean")) is not None]
+            mins = [_min for stat in stats if (_min := stat.get("min")) is not None]
+            maxs = [_max for stat in stats if (_max := stat.get("max")) is not None]
+            last = stats[-1]
+            summary[metadata_id] = {
+                "start": hour,
+                "mean": sum(means) / len(means) if means else None,
+                "min": min(mins, default=None),
+                "max": max(maxs, default=None),
+                "last_reset": process_timestamp(last.get("last_reset")),
+                "state": last.get("state"),
+                "sum": last.get("sum"),
+            }
+        return summary
+
+
 def compile_hourly_statistics(
     instance: Recorder, session: scoped_session, start: datetime
 ) -> None:
     """Compile hourly statistics.
 
     This will summarize 5-minute statistics for one hour:
-    - average, min max is computed by a database query
+    - average, min max is computed from the compiled 5-minute statistics, or
+      by a database query if some were not compiled by this recorder
     - sum is taken from the last 5-minute entry during the hour
     """
+    summary = instance.statistics_summary.hourly_summary(start)
+    if summary is None:
+        summary = _query_hourly_summary(instance, session, start)
+
+    # Insert compiled hourly statistics in the database
+    for metadata_id, stat in summary.items():
+        session.add(Statistics.from_stats(metadata_id, stat))
+
+
+def _query_hourly_summary(
+    instance: Recorder, session: scoped_session, start: datetime
+) -> dict[int, StatisticData]:
+    """Summarize the 5-minute statistics of an hour in the database."""
     start_time = start.replace(minute=0)
     end_time = start_time + timedelta(hours=1)
 
     # Compute last hour's average, min, max
-    summary: dict[str, StatisticData] = {}
+    summary: dict[int, StatisticData] = {}
     baked_query = instance.hass.data[STATISTICS_SHORT_TERM_BAKERY](
         lambda session: session.query(*QUERY_STATISTICS_SUMMARY_MEAN)
     )
@@ -306,9 +384,7 @@ def compile_hourly_statistics(
                     "sum": _sum,
                 }
 
-    # Insert compiled hourly statistics in the database
-    for metadata_id, stat in summary.items():
-        session.add(Statistics.from_stats(metadata_id, stat))
+    return summary
 
 
 @retryable_database_job("statistics")
@@ -339,24 +415,35 @@ def compile_statistics(instance: Recorder, start: datetime) -> bool:
         platform_stats.extend(platform_stat)
 
     # Insert collected statistics in the database
-    with session_scope(session=instance.get_session()) as session:  # type: ignore
-        for stats in platform_stats:
-            metadata_id = _update_or_add_metadata(instance.hass, session, stats["meta"])
-            for stat in stats["stat"]:
-                try:
-                    session.add(StatisticsShortTerm.from_stats(metadata_id, stat))
-                except SQLAlchemyError:
-                    _LOGGER.exception(
-                        "Unexpected exception when inserting statistics %s:%s ",
-                        metadata_id,
-                        stats,
-                    )
-
-        if start.minute == 55:
-            # A full hour is ready, summarize it
-            compile_hourly_statistics(instance, session, start)
-
-        session.add(StatisticsRuns(start=start))
+    statistics_summary = instance.statistics_summary
+    try:
+        with session_scope(session=instance.get_session()) as session:  # type: ignore
+            rows: list[tuple[int, StatisticData]] = []
+            for stats in platform_stats:
+                metadata_id = _update_or_add_metadata(
+                    instance.hass, session, stats["meta"]
+                )
+                for stat in stats["stat"]:
+                    try:
+                        session.add(StatisticsShortTerm.from_stats(metadata_id, stat))
+                    except SQLAlchemyError:
+                        _LOGGER.exception(
+                            "Unexpected exception when inserting statistics %s:%s ",
+                            metadata_id,
+                            stats,
+                        )
+                    else:
+                        rows.append((metadata_id, stat))
+            statistics_summary.add(start, rows)
+
+            if start.minute == 55:
+                # A full hour is ready, summarize it
+                compile_hourly_statistics(instance, session, start)
+
+            session.add(StatisticsRuns(start=start))
+    except Exception:
+        statistics_summary.discard(start)
+        raise
 
     return True
 
@@ -418,7 +505,7 @@ def get_metadata(
     statistic_ids: Iterable[str],
 ) -> dict[str, tuple[int, StatisticMetaData]]:
     """Return metadata for statistic_ids."""
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         return get_metadata_with_session(hass, session, statistic_ids, None)
 
 
@@ -437,6 +524,7 @@ def _configured_unit(unit: str, units: UnitSystem) -> str:
 
 def clear_statistics(instance: Recorder, statistic_ids: list[str]) -> None:
     """Clear statistics for a list of statistic_ids."""
+    instance.statistics_summary.reset()
     with session_scope(session=instance.get_session()) as session:  # type: ignore
         session.query(StatisticsMeta).filter(
             StatisticsMeta.statistic_id.in_(statistic_ids)
@@ -467,7 +555,7 @@ def list_statistic_ids(
     statistic_ids = {}
 
     # Query the database
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         metadata = get_metadata_with_session(hass, session, None, statistic_type)
 
         for _, meta in metadata.values():
@@ -545,7 +633,7 @@ def statistics_during_period(
     If statistic_ids is omitted, returns statistics for all statistics ids.
     """
     metadata = None
-    with session_scope(hass=hass) as session:
+    with session_scope(hass=hass, read_only=True) as session:
         # Fetch metadata for the given (or all) statistic_ids
         metadata = get_metadata_with_session(hass, session, statistic_ids, None)
         if not metadata:
@@ -583,45 +671,58 @@ def statistics_during_period(
 
 def get_last_statistics(
     hass: HomeAssistant, number_of_stats: int, statistic_id: str, convert_units: bool
+) -> dict[str, list[dict]]:
+    """Return the last number_of_stats statistics for a given statistic_id."""
+    with session_scope(hass=hass, read_only=True) as session:
+        return get_last_statistics_with_session(
+            hass, session, number_of_stats, statistic_id, convert_units
+        )
+
+
+def get_last_statistics_with_session(
+    hass: HomeAssistant,
+    session: scoped_session,
+    number_of_stats: int,
+    statistic_id: str,
+    convert_units: bool,
 ) -> dict[str, list[dict]]:
     """Return the last number_of_stats statistics for a given statistic_id."""
     statistic_ids = [statistic_id]
-    with session_scope(hass=hass) as session:
-        # Fetch metadata for the given statistic_id
-        metadata = get_metadata_with_session(hass, session, statistic_ids, None)
-        if not metadata:
-            return {}
+    # Fetch metadata for the given statistic_id
+    metadata = get_metadata_with_session(hass, session, statistic_ids, None)
+    if not metadata:
+        return {}
 
-        baked_query = hass.data[STATISTICS_SHORT_TERM_BAKERY](
-            lambda session: session.query(*QUERY_STATISTICS_SHORT_TERM)
-        )
+    baked_query = hass.data[STATISTICS_SHORT_TERM_BAKERY](
+        lambda session: session.query(*QUERY_STATISTICS_SHORT_TERM)
+    )
 
-        baked_query += lambda q: q.filter_by(metadata_id=bindparam("metadata_id"))
-        metadata_id = metadata[statistic_id][0]
+    baked_query += lambda q: q.filter_by(metadata_id=bindparam("metadata_id"))
+    metadata_id = metadata[statistic_id][0]
 
-        baked_query += lambda q: q.order_by(
-            StatisticsShortTerm.metadata_id, StatisticsShortTerm.start.desc()
-        )
+    baked_query += lambda q: q.order_by(
+        StatisticsShortTerm.metadata_id, StatisticsShortTerm.start.desc()
+    )
 
-        baked_query += lambda q: q.limit(bindparam("number_of_stats"))
+    baked_query += lambda q: q.limit(bindparam("number_of_stats"))
 
-        stats = execute(
-            baked_query(session).params(
-                number_of_stats=number_of_stats, metadata_id=metadata_id
-            )
+    stats = execute(
+        baked_query(session).params(
+            number_of_stats=number_of_stats, metadata_id=metadata_id
         )
-        if not stats:
-            return {}
+    )
+    if not stats:
+        return {}
 
-        # Return statistics combined with metadata
-        return _sorted_statistics_to_dict(
-            hass,
-            stats,
-            statistic_ids,
-            metadata,
-            convert_units,
-            StatisticsShortTerm.duration,
-        )
+    # Return statistics combined with metadata
+    return _sorted_statistics_to_dict(
+        hass,
+        stats,
+        statistic_ids,
+        metadata,
+        convert_units,
+        StatisticsShortTerm.duration,
+    )
 
 
 def _sorted_statistics_to_dict(
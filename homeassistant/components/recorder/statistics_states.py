@@ -0,0 +1,174 @@
+"""Keep the recorded states statistics are compiled from."""
+from __future__ import annotations
+
+from collections.abc import Callable, Iterable
+from datetime import datetime, timedelta
+
+from homeassistant.core import Event, State
+
+# Statistics are compiled for entities with a state class
+ATTR_STATE_CLASS = "state_class"
+
+
+class StatisticsStates:
+    """Recorded states of the entities with a state class.
+
+    The states are kept until the statistics of the period they are in
+    are compiled, so the states of a period do not have to be read back
+    from the database. Older states are dropped except for the last one
+    of each entity, which is the state at the start of the next period.
+
+    An entity is covered from its first recorded state with a state
+    class on, the database is used for periods before that.
+
+    This class must only be used from the recorder thread.
+    """
+
+    def __init__(self) -> None:
+        """Initialize the states."""
+        # The time from which all recorded states are kept, None when disabled
+        self.since: datetime | None = None
+        self._tracked_since: dict[str, datetime] = {}
+        # (last_updated, state) where state is None for a removed entity
+        self._start_states: dict[str, tuple[datetime, State | None]] = {}
+        self._states: dict[str, list[tuple[datetime, State | None]]] = {}
+
+    def reset(self, since: datetime | None) -> None:
+        """Drop all states and keep the states recorded from a time on."""
+        self.since = since
+        self._tracked_since = {}
+        self._start_states = {}
+        self._states = {}
+
+    def add_event(self, event: Event) -> None:
+        """Keep the new state of a recorded state_changed event."""
+        if self.since is None:
+            return
+        entity_id = event.data["entity_id"]
+        new_state = event.data.get("new_state")
+        if entity_id not in self._tracked_since:
+            if new_state is None or ATTR_STATE_CLASS not in new_state.attributes:
+                return
+            self._tracked_since[entity_id] = new_state.last_updated
+        # Removed entities are stored with the time the event was fired
+        last_updated = event.time_fired if new_state is None else new_state.last_updated
+        self._states.setdefault(entity_id, []).append((last_updated, new_state))
+
+    def prune(self, before: datetime) -> None:
+        """Drop the states before a time except the last one of each entity."""
+        if self.since is None:
+            return
+        self.since = max(self.since, before)
+        for entity_id, states in list(self._states.items()):
+            start_state = self._start_states.get(entity_id)
+            kept = []
+            for item in states:
+                if item[0] >= before:
+                    kept.append(item)
+                elif start_state is None or item[0] >= start_state[0]:
+                    start_state = item
+            if len(kept) == len(states):
+                continue
+            assert start_state is not None
+            self._start_states[entity_id] = start_state
+            if kept:
+                self._states[entity_id] = kept
+            else:
+                del self._states[entity_id]
+
+    def purge(self, purge_before: datetime) -> None:
+        """Drop the states purged from the database."""
+        if self.since is None:
+            return
+        self.since = max(self.since, purge_before)
+        for entity_id, states in list(self._states.items()):
+            if kept := [item for item in states if item[0] >= purge_before]:
+                self._states[entity_id] = kept
+            else:
+                del self._states[entity_id]
+        for entity_id, (last_updated, _) in list(self._start_states.items()):
+            if last_updated < purge_before:
+                del self._start_states[entity_id]
+
+    def forget(self, entity_filter: Callable[[str], bool]) -> None:
+        """Stop covering the entities a filter passes."""
+        for entity_id in [
+            entity_id for entity_id in self._tracked_since if entity_filter(entity_id)
+        ]:
+            del self._tracked_since[entity_id]
+            self._start_states.pop(entity_id, None)
+            self._states.pop(entity_id, None)
+
+    def states_during_period(
+        self,
+        entity_ids: Iterable[str],
+        start: datetime,
+        end: datetime,
+        significant_changes_only: bool,
+    ) -> tuple[dict[str, list[State]], list[str]]:
+        """Return the states of entities during a period.
+
+        The states are the state at the start followed by the states in
+        the period like get_significant_states returns them when called
+        with the microsecond before the start. Entities with a state that
+        can not be used, like a removal, map to an empty list, entities
+        without any state are left out.
+
+        Also returns the entity_ids that are not covered for the period.
+        """
+        result: dict[str, list[State]] = {}
+        if self.since is None or start < self.since:
+            return result, list(entity_ids)
+
+        start_time = start - timedelta.resolution
+        missing = []
+        for entity_id in entity_ids:
+            tracked_since = self._tracked_since.get(entity_id)
+            if tracked_since is None or start <= tracked_since:
+                missing.append(entity_id)
+                continue
+            start_state = self._start_states.get(entity_id)
+            in_period = []
+            for item in self._states.get(entity_id, ()):
+                if item[0] >= end:
+                    continue
+                if item[0] >= start:
+                    in_period.append(item)
+                elif start_state is None or item[0] >= start_state[0]:
+                    start_state = item
+
+            states: list[State] = []
+            found = False
+            if start_state is not None:
+                found = True
+                if (state := start_state[1]) is not None:
+                    # Moved to the start like the database start states
+                    states.append(
+                        State(
+                            entity_id,
+                            state.state,
+                            state.attributes,
+                            start_time,
+                            start_time,
+                            state.context,
+                            validate_entity_id=False,
+                        )
+                    )
+            # Sorted like the database returns them, states fired at the
+            # same time keep the order they were recorded in
+            in_period.sort(key=_last_updated)
+            for last_updated, state in in_period:
+                if state is None:
+                    # Removals are always a significant change
+                    found = True
+                elif not significant_changes_only or state.last_changed == last_updated:
+                    found = True
+                    states.append(state)
+            if found:
+                result[entity_id] = states
+        return result, missing
+
+
+def _last_updated(item: tuple[datetime, State | None]) -> datetime:
+    """Return the time of a kept state for sorting."""
+    return item[0]
@@ -410,10 +410,10 @@ def _compile_statistics(  # noqa: C901
     ]
     history_list = {}
     if entities_full_history:
-        history_list = history.get_significant_states_with_session(  # type: ignore
+        history_list = history.get_statistics_states_with_session(  # type: ignore
             hass,
             session,
-            start - datetime.timedelta.resolution,
+            start,
             end,
             entity_ids=entities_full_history,
             significant_changes_only=False,
@@ -424,10 +424,10 @@ def _compile_statistics(  # noqa: C901
         if "sum" not in wanted_statistics[i.entity_id]
     ]
     if entities_significant_history:
-        _history_list = history.get_significant_states_with_session(  # type: ignore
+        _history_list = history.get_statistics_states_with_session(  # type: ignore
             hass,
             session,
-            start - datetime.timedelta.resolution,
+            start,
             end,
             entity_ids=entities_significant_history,
         )
@@ -493,7 +493,9 @@ def _compile_statistics(  # noqa: C901
             last_reset = old_last_reset = None
             new_state = old_state = None
             _sum = 0.0
-            last_stats = statistics.get_last_statistics(hass, 1, entity_id, False)
+            last_stats = statistics.get_last_statistics_with_session(
+                hass, session, 1, entity_id, False
+            )
             if entity_id in last_stats:
                 # We have compiled history for this sensor before, use that as a starting point
                 last_reset = old_last_reset = last_stats[entity_id][0]["last_reset"]
@@ -1,6 +1,7 @@
 """WebSocket based API for Home Assistant."""
 from __future__ import annotations
 
+from functools import partial
 from typing import Final, cast
 
 import voluptuous as vol
@@ -67,5 +68,11 @@ def async_register_command(
 async def async_setup(hass: HomeAssistant, config: ConfigType) -> bool:
     """Initialize the websocket API."""
     hass.http.register_view(http.WebsocketAPIView())
+    hass.metrics.gauge(
+        "websocket_send_backlog",
+        "Messages waiting to be sent to a websocket connection",
+        partial(http.async_send_backlog, hass),
+        "connection",
+    )
     commands.async_register_commands(hass, async_register_command)
     return True
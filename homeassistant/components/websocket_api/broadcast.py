@@ -0,0 +1,150 @@
+"""Fan out subscribed events to websocket connections."""
+from __future__ import annotations
+
+from collections.abc import Callable
+from typing import TYPE_CHECKING
+
+from homeassistant.auth.models import User
+from homeassistant.auth.permissions.const import POLICY_READ
+from homeassistant.const import EVENT_STATE_CHANGED, EVENT_TIME_CHANGED, MATCH_ALL
+from homeassistant.core import Event, HomeAssistant, callback
+
+from . import messages
+from .const import DATA_BROADCASTERS
+
+if TYPE_CHECKING:
+    from .connection import ActiveConnection
+
+
+@callback
+def async_subscribe_events(
+    hass: HomeAssistant, connection: ActiveConnection, msg_id: int, event_type: str
+) -> Callable[[], None]:
+    """Subscribe a connection to events of a type and return the unsubscribe."""
+    broadcasters: dict[str, EventBroadcaster] = hass.data.setdefault(
+        DATA_BROADCASTERS, {}
+    )
+    if (broadcaster := broadcasters.get(event_type)) is None:
+        broadcaster = broadcasters[event_type] = EventBroadcaster(hass, event_type)
+    return broadcaster.async_subscribe(connection, msg_id)
+
+
+class _SubscriberGroup:
+    """Subscribers that share the same entity permissions."""
+
+    __slots__ = ("user", "subscribers")
+
+    def __init__(self, user: User | None) -> None:
+        """Initialize the group."""
+        # The user whose permissions apply, None for administrators
+        self.user = user
+        self.subscribers: list[tuple[ActiveConnection, int]] = []
+
+
+class EventBroadcaster:
+    """Forward the events of one type to every subscribed connection.
+
+    There is a single bus listener per event type no matter how many
+    connections subscribed. Each event is serialized once and only the
+    message id is spliced in per subscription. The subscribers are
+    grouped by user so the entity permissions of state changes are only
+    checked once per user, and all messages for a connection from one
+    batch of events are handed to it at once.
+    """
+
+    def __init__(self, hass: HomeAssistant, event_type: str) -> None:
+        """Initialize the broadcaster."""
+        self.hass = hass
+        self.event_type = event_type
+        # Administrators can read all entities and are grouped under None
+        self._groups: dict[str | None, _SubscriberGroup] = {}
+        self._unsub_bus: Callable[[], None] | None = None
+
+    @callback
+    def async_subscribe(
+        self, connection: ActiveConnection, msg_id: int
+    ) -> Callable[[], None]:
+        """Add a subscription and return a function to remove it."""
+        user = connection.user
+        group_key = None if user.is_admin else user.id
+        if (group := self._groups.get(group_key)) is None:
+            group = self._groups[group_key] = _SubscriberGroup(
+                None if user.is_admin else user
+            )
+        subscriber = (connection, msg_id)
+        group.subscribers.append(subscriber)
+
+        if self._unsub_bus is None:
+            self._async_listen()
+
+        subscribed = True
+
+        @callback
+        def _async_unsubscribe() -> None:
+            """Remove the subscription, does nothing when already removed."""
+            nonlocal subscribed
+            if not subscribed:
+                return
+            subscribed = False
+            group.subscribers.remove(subscriber)
+            if group.subscribers:
+                return
+            del self._groups[group_key]
+            if self._groups or self._unsub_bus is None:
+                return
+            self._unsub_bus()
+            self._unsub_bus = None
+            broadcasters = self.hass.data[DATA_BROADCASTERS]
+            if broadcasters.get(self.event_type) is self:
+                del broadcasters[self.event_type]
+
+        return _async_unsubscribe
+
+    @callback
+    def _async_listen(self) -> None:
+        """Listen to the event bus for the event type."""
+        bus = self.hass.bus
+        if self.event_type == EVENT_STATE_CHANGED:
+            self._unsub_bus = bus.async_listen_batch(
+                EVENT_STATE_CHANGED, self._async_forward
+            )
+        elif self.event_type == MATCH_ALL:
+            self._unsub_bus = bus.async_listen(
+                MATCH_ALL,
+                self._async_forward_one,
+                exclude_event_types=[EVENT_TIME_CHANGED],
+            )
+        else:
+            self._unsub_bus = bus.async_listen(self.event_type, self._async_forward_one)
+
+    @callback
+    def _async_forward_one(self, event: Event) -> None:
+        """Forward a single event."""
+        self._async_forward([event])
+
+    @callback
+    def _async_forward(self, events: list[Event]) -> None:
+        """Forward a batch of events to all subscribers."""
+        if self.event_type == EVENT_TIME_CHANGED:
+            return
+
+        parts = [messages.split_event_message(event) for event in events]
+        filter_entities = self.event_type == EVENT_STATE_CHANGED
+
+        for group in list(self._groups.values()):
+            group_parts = parts
+            if filter_entities and group.user is not None:
+                check_entity = group.user.permissions.check_entity
+                group_parts = [
+                    event_parts
+                    for event, event_parts in zip(events, parts)
+                    if check_entity(event.data["entity_id"], POLICY_READ)
+                ]
+                if not group_parts:
+                    continue
+
+            for connection, msg_id in list(group.subscribers):
+                iden = str(msg_id)
+                connection.send_messages(
+                    [f"{head}{iden}{tail}" for head, tail in group_parts]
+                )
@@ -3,7 +3,9 @@ from __future__ import annotations
 
 import asyncio
 from collections.abc import Callable
+import fnmatch
 import json
+import re
 from typing import Any
 
 import voluptuous as vol
@@ -11,8 +13,8 @@ import voluptuous as vol
 from homeassistant.auth.permissions.const import CAT_ENTITIES, POLICY_READ
 from homeassistant.bootstrap import SIGNAL_BOOTSTRAP_INTEGRATONS
 from homeassistant.components.websocket_api.const import ERR_NOT_FOUND
-from homeassistant.const import EVENT_STATE_CHANGED, EVENT_TIME_CHANGED, MATCH_ALL
-from homeassistant.core import Context, Event, HomeAssistant, callback
+from homeassistant.const import EVENT_STATE_CHANGED, MATCH_ALL
+from homeassistant.core import Context, Event, HomeAssistant, State, callback
 from homeassistant.exceptions import (
     HomeAssistantError,
     ServiceNotFound,
@@ -24,6 +26,7 @@ from homeassistant.helpers.dispatcher import async_dispatcher_connect
 from homeassistant.helpers.event import (
     TrackTemplate,
     TrackTemplateResult,
+    async_track_state_change_event,
     async_track_template_result,
 )
 from homeassistant.helpers.json import ExtendedJSONEncoder
@@ -31,7 +34,7 @@ from homeassistant.helpers.service import async_get_all_descriptions
 from homeassistant.loader import IntegrationNotFound, async_get_integration
 from homeassistant.setup import DATA_SETUP_TIME, async_get_loaded_integrations
 
-from . import const, decorators, messages
+from . import broadcast, const, decorators, messages
 from .connection import ActiveConnection
 
 
@@ -50,11 +53,14 @@ def async_register_commands(
     async_reg(hass, handle_manifest_get)
     async_reg(hass, handle_integration_setup_info)
     async_reg(hass, handle_manifest_list)
+    async_reg(hass, handle_metrics)
     async_reg(hass, handle_ping)
     async_reg(hass, handle_render_template)
     async_reg(hass, handle_subscribe_bootstrap_integrations)
+    async_reg(hass, handle_subscribe_entities)
     async_reg(hass, handle_subscribe_events)
     async_reg(hass, handle_subscribe_trigger)
+    async_reg(hass, handle_supported_features)
     async_reg(hass, handle_test_condition)
     async_reg(hass, handle_unsubscribe_events)
 
@@ -84,33 +90,163 @@ def handle_subscribe_events(
     if event_type not in SUBSCRIBE_ALLOWLIST and not connection.user.is_admin:
         raise Unauthorized
 
-    if event_type == EVENT_STATE_CHANGED:
+    connection.subscriptions[msg["id"]] = broadcast.async_subscribe_events(
+        hass, connection, msg["id"], event_type
+    )
 
-        @callback
-        def forward_events(event: Event) -> None:
-            """Forward state changed events to websocket."""
-            if not connection.user.permissions.check_entity(
-                event.data["entity_id"], POLICY_READ
-            ):
-                return
+    connection.send_message(messages.result_message(msg["id"]))
 
-            connection.send_message(messages.cached_event_message(msg["id"], event))
 
-    else:
+def _entity_id_glob(entity_id: str) -> bool:
+    """Return if an entity id of subscribe_entities is a glob."""
+    return any(char in entity_id for char in "*?[")
 
-        @callback
-        def forward_events(event: Event) -> None:
-            """Forward events to websocket."""
-            if event.event_type == EVENT_TIME_CHANGED:
-                return
 
-            connection.send_message(messages.cached_event_message(msg["id"], event))
+@callback
+@decorators.websocket_command(
+    {
+        vol.Required("type"): "subscribe_entities",
+        vol.Required("entity_ids"): vol.All(
+            cv.ensure_list, [vol.All(cv.string, vol.Lower)]
+        ),
+    }
+)
+def handle_subscribe_entities(
+    hass: HomeAssistant, connection: ActiveConnection, msg: dict[str, Any]
+) -> None:
+    """Handle subscribe entities command.
+
+    The first event holds the compressed states of the matching
+    entities. The following events only hold what changed.
+    """
+    msg_id = msg["id"]
+    entity_ids = {
+        entity_id for entity_id in msg["entity_ids"] if not _entity_id_glob(entity_id)
+    }
+    globs = [entity_id for entity_id in msg["entity_ids"] if _entity_id_glob(entity_id)]
+    glob_match: Callable[[str], Any] | None = None
+    if globs:
+        glob_match = re.compile(
+            "|".join(f"(?:{fnmatch.translate(glob)})" for glob in globs)
+        ).match
+
+    user = connection.user
+    entity_perm = (
+        None
+        if user.permissions.access_all_entities(POLICY_READ)
+        else user.permissions.check_entity
+    )
+
+    def _matches(entity_id: str) -> bool:
+        """Return if an entity is part of the subscription."""
+        if entity_id not in entity_ids and (
+            glob_match is None or not glob_match(entity_id)
+        ):
+            return False
+        return entity_perm is None or entity_perm(entity_id, POLICY_READ)
+
+    @callback
+    def forward_entity_changes(events: list[Event]) -> None:
+        """Forward the changes of the subscribed entities in one message.
+
+        An entity that changes more than once in the events gets a single
+        update from its first old state to its last new state.
+        """
+        states: dict[str, tuple[State | None, State | None]] = {}
+        for event in events:
+            entity_id = event.data["entity_id"]
+            if entity_perm is not None and not entity_perm(entity_id, POLICY_READ):
+                continue
+            if (first := states.get(entity_id)) is not None:
+                states[entity_id] = (first[0], event.data["new_state"])
+            else:
+                states[entity_id] = (event.data["old_state"], event.data["new_state"])
+
+        added: dict[str, Any] = {}
+        changed: dict[str, Any] = {}
+        removed: list[str] = []
+        for entity_id, (old_state, new_state) in states.items():
+            if new_state is None:
+                # An entity added and removed again was never sent
+                if old_state is not None:
+                    removed.append(entity_id)
+            elif old_state is None:
+                added[entity_id] = messages.compressed_state_dict_add(new_state)
+            else:
+                changed[entity_id] = messages.compressed_state_diff(
+                    old_state, new_state
+                )
 
-    connection.subscriptions[msg["id"]] = hass.bus.async_listen(
-        event_type, forward_events
+        entity_event: dict[str, Any] = {}
+        if added:
+            entity_event[messages.ENTITY_EVENT_ADD] = added
+        if changed:
+            entity_event[messages.ENTITY_EVENT_CHANGE] = changed
+        if removed:
+            entity_event[messages.ENTITY_EVENT_REMOVE] = removed
+        if entity_event:
+            connection.send_message(messages.event_message(msg_id, entity_event))
+
+    @callback
+    def forward_entity_change(event: Event) -> None:
+        """Forward the change of a subscribed entity."""
+        forward_entity_changes([event])
+
+    @callback
+    def forward_glob_changes(events: list[Event]) -> None:
+        """Forward the changes of entities matched by the globs."""
+        assert glob_match is not None
+        if matched := [
+            event
+            for event in events
+            if event.data["entity_id"] not in entity_ids
+            and glob_match(event.data["entity_id"])
+        ]:
+            forward_entity_changes(matched)
+
+    # Entities named explicitly are routed by the keyed index of the bus,
+    # only globs have to look at every state change
+    unsubs = [async_track_state_change_event(hass, entity_ids, forward_entity_change)]
+    if glob_match is not None:
+        unsubs.append(
+            hass.bus.async_listen_batch(EVENT_STATE_CHANGED, forward_glob_changes)
+        )
+
+    @callback
+    def unsubscribe() -> None:
+        """Remove the listeners of the subscription."""
+        for unsub in unsubs:
+            unsub()
+
+    connection.subscriptions[msg_id] = unsubscribe
+    connection.send_result(msg_id)
+    connection.send_message(
+        messages.event_message(
+            msg_id,
+            {
+                messages.ENTITY_EVENT_ADD: {
+                    state.entity_id: messages.compressed_state_dict_add(state)
+                    for state in hass.states.async_all()
+                    if _matches(state.entity_id)
+                }
+            },
+        )
     )
 
-    connection.send_message(messages.result_message(msg["id"]))
+
+@callback
+@decorators.websocket_command(
+    {
+        vol.Required("type"): "supported_features",
+        vol.Required("features"): {str: int},
+    }
+)
+def handle_supported_features(
+    hass: HomeAssistant, connection: ActiveConnection, msg: dict[str, Any]
+) -> None:
+    """Handle setting the features the client supports."""
+    connection.supported_features = msg["features"]
+    connection.send_result(msg["id"])
 
 
 @callback
@@ -480,6 +616,19 @@ async def handle_subscribe_trigger(
     connection.send_result(msg["id"])
 
 
+@callback
+@decorators.websocket_command({vol.Required("type"): "metrics"})
+@decorators.require_admin
+def handle_metrics(
+    hass: HomeAssistant, connection: ActiveConnection, msg: dict[str, Any]
+) -> None:
+    """Handle metrics command.
+
+    The first call starts the measurements that add work to hot paths.
+    """
+    connection.send_result(msg["id"], hass.metrics.as_dict())
+
+
 @decorators.websocket_command(
     {
         vol.Required("type"): "test_condition",
@@ -27,20 +27,32 @@ class ActiveConnection:
         send_message: Callable[[str | dict[str, Any]], None],
         user: User,
         refresh_token: RefreshToken,
+        send_messages: Callable[[list[str]], None] | None = None,
     ) -> None:
         """Initialize an active connection."""
         self.logger = logger
         self.hass = hass
         self.send_message = send_message
+        self._send_messages = send_messages
         self.user = user
         self.refresh_token_id = refresh_token.id
         self.subscriptions: dict[Hashable, Callable[[], Any]] = {}
+        self.supported_features: dict[str, int] = {}
         self.last_id = 0
 
     def context(self, msg: dict[str, Any]) -> Context:
         """Return a context."""
         return Context(user_id=self.user.id)
 
+    @callback
+    def send_messages(self, messages_json: list[str]) -> None:
+        """Send several serialized messages at once."""
+        if self._send_messages is not None:
+            self._send_messages(messages_json)
+            return
+        for message in messages_json:
+            self.send_message(message)
+
     @callback
     def send_result(self, msg_id: int, result: Any | None = None) -> None:
         """Send a result message."""
@@ -4,11 +4,10 @@ from __future__ import annotations
 import asyncio
 from concurrent import futures
 from functools import partial
-import json
 from typing import TYPE_CHECKING, Any, Awaitable, Callable, Dict, Final
 
 from homeassistant.core import HomeAssistant
-from homeassistant.helpers.json import JSONEncoder
+from homeassistant.helpers.json import json_dumps
 
 if TYPE_CHECKING:
     from .connection import ActiveConnection
@@ -40,6 +39,10 @@ ERR_TEMPLATE_ERROR: Final = "template_error"
 
 TYPE_RESULT: Final = "result"
 
+# Features a client can enable with the supported_features command.
+# With coalesce_messages pending messages are sent as one JSON array frame.
+FEATURE_COALESCE_MESSAGES: Final = "coalesce_messages"
+
 # Define the possible errors that occur when connections are cancelled.
 # Originally, this was just asyncio.CancelledError, but issue #9546 showed
 # that futures.CancelledErrors can also occur in some situations.
@@ -52,4 +55,10 @@ SIGNAL_WEBSOCKET_DISCONNECTED: Final = "websocket_disconnected"
 # Data used to store the current connection list
 DATA_CONNECTIONS: Final = f"{DOMAIN}.connections"
 
-JSON_DUMP: Final = partial(json.dumps, cls=JSONEncoder, allow_nan=False)
+# Data used to store the event broadcasters by event type
+DATA_BROADCASTERS: Final = f"{DOMAIN}.broadcasters"
+
+# Data used to store the write queues of the connections by connection id
+DATA_WRITE_QUEUES: Final = f"{DOMAIN}.write_queues"
+
+JSON_DUMP: Final = partial(json_dumps, allow_nan=False)
@@ -17,9 +17,12 @@ from homeassistant.core import Event, HomeAssistant, callback
 from homeassistant.helpers.event import async_call_later
 
 from .auth import AuthPhase, auth_required_message
+from .connection import ActiveConnection
 from .const import (
     CANCELLATION_ERRORS,
     DATA_CONNECTIONS,
+    DATA_WRITE_QUEUES,
+    FEATURE_COALESCE_MESSAGES,
     MAX_PENDING_MSG,
     PENDING_MSG_PEAK,
     PENDING_MSG_PEAK_TIME,
@@ -33,6 +36,15 @@ from .messages import message_to_json
 _WS_LOGGER: Final = logging.getLogger(f"{__name__}.connection")
 
 
+@callback
+def async_send_backlog(hass: HomeAssistant) -> dict[str, float]:
+    """Return the number of messages waiting to be sent by connection id."""
+    return {
+        str(connid): to_write.qsize()
+        for connid, to_write in hass.data.get(DATA_WRITE_QUEUES, {}).items()
+    }
+
+
 class WebsocketAPIView(HomeAssistantView):
     """View to serve a websockets endpoint."""
 
@@ -67,6 +79,7 @@ class WebSocketHandler:
         self._writer_task: asyncio.Task | None = None
         self._logger = WebSocketAdapter(_WS_LOGGER, {"connid": id(self)})
         self._peak_checker_unsub: Callable[[], None] | None = None
+        self._connection: ActiveConnection | None = None
 
     async def _writer(self) -> None:
         """Write outgoing messages."""
@@ -78,14 +91,56 @@ class WebSocketHandler:
                 if message is None:
                     break
 
-                self._logger.debug("Sending %s", message)
-                await self.wsock.send_str(message)
+                if (
+                    self._connection is not None
+                    and self._connection.supported_features.get(
+                        FEATURE_COALESCE_MESSAGES
+                    )
+                ):
+                    if not await self._write_coalesced(message):
+                        break
+                    continue
+
+                if isinstance(message, str):
+                    self._logger.debug("Sending %s", message)
+                    await self.wsock.send_str(message)
+                    continue
+
+                for part in message:
+                    self._logger.debug("Sending %s", part)
+                    await self.wsock.send_str(part)
 
         # Clean up the peaker checker when we shut down the writer
         if self._peak_checker_unsub is not None:
             self._peak_checker_unsub()
             self._peak_checker_unsub = None
 
+    async def _write_coalesced(self, message: str | list[str]) -> bool:
+        """Write a message and everything else pending as one frame.
+
+        Returns False when the writer was asked to stop.
+        """
+        assert self.wsock is not None
+        to_write = self._to_write
+        messages = [message] if isinstance(message, str) else list(message)
+        running = True
+        while not to_write.empty():
+            if (pending := to_write.get_nowait()) is None:
+                running = False
+                break
+            if isinstance(pending, str):
+                messages.append(pending)
+            else:
+                messages.extend(pending)
+
+        if len(messages) == 1:
+            coalesced = messages[0]
+        else:
+            coalesced = f"[{','.join(messages)}]"
+        self._logger.debug("Sending %s", coalesced)
+        await self.wsock.send_str(coalesced)
+        return running
+
     @callback
     def _send_message(self, message: str | dict[str, Any]) -> None:
         """Send a message to the client.
@@ -97,6 +152,24 @@ class WebSocketHandler:
         if not isinstance(message, str):
             message = message_to_json(message)
 
+        self._queue_message(message)
+
+    @callback
+    def _send_messages(self, messages: list[str]) -> None:
+        """Send several serialized messages to the client.
+
+        They take a single place in the write queue.
+
+        Async friendly.
+        """
+        self._queue_message(messages)
+
+    @callback
+    def _queue_message(self, message: str | list[str]) -> None:
+        """Queue a message or group of messages for the writer.
+
+        Closes connection if the client is not reading the messages.
+        """
         try:
             self._to_write.put_nowait(message)
         except asyncio.QueueFull:
@@ -104,7 +177,7 @@ class WebSocketHandler:
                 "Client exceeded max pending messages [2]: %s", MAX_PENDING_MSG
             )
 
-            self._cancel()
+            self._cancel_slow_client()
 
         if self._to_write.qsize() < PENDING_MSG_PEAK:
             if self._peak_checker_unsub:
@@ -130,6 +203,15 @@ class WebSocketHandler:
             PENDING_MSG_PEAK,
             PENDING_MSG_PEAK_TIME,
         )
+        self._cancel_slow_client()
+
+    @callback
+    def _cancel_slow_client(self) -> None:
+        """Cancel the connection of a client that does not keep up."""
+        self.hass.metrics.counter(
+            "websocket_slow_clients_total",
+            "Websocket connections closed for not reading their messages",
+        ).inc()
         self._cancel()
 
     @callback
@@ -147,6 +229,8 @@ class WebSocketHandler:
         await wsock.prepare(request)
         self._logger.debug("Connected from %s", request.remote)
         self._handle_task = asyncio.current_task()
+        write_queues = self.hass.data.setdefault(DATA_WRITE_QUEUES, {})
+        write_queues[id(self)] = self._to_write
 
         @callback
         def handle_hass_stop(event: Event) -> None:
@@ -161,7 +245,9 @@ class WebSocketHandler:
         # event we do not want to block for websocket responses
         self._writer_task = asyncio.create_task(self._writer())
 
-        auth = AuthPhase(self._logger, self.hass, self._send_message, request)
+        auth = AuthPhase(
+            self._logger, self.hass, self._send_message, request, self._send_messages
+        )
         connection = None
         disconnect_warn = None
 
@@ -190,7 +276,7 @@ class WebSocketHandler:
                 raise Disconnect from err
 
             self._logger.debug("Received %s", msg_data)
-            connection = await auth.async_handle(msg_data)
+            connection = self._connection = await auth.async_handle(msg_data)
             self.hass.data[DATA_CONNECTIONS] = (
                 self.hass.data.get(DATA_CONNECTIONS, 0) + 1
             )
@@ -229,6 +315,7 @@ class WebSocketHandler:
 
         finally:
             unsub_stop()
+            write_queues.pop(id(self), None)
 
             if connection is not None:
                 connection.async_handle_close()
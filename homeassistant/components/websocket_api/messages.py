@@ -7,7 +7,7 @@ from typing import Any, Final
 
 import voluptuous as vol
 
-from homeassistant.core import Event
+from homeassistant.core import Event, State
 from homeassistant.helpers import config_validation as cv
 from homeassistant.util.json import (
     find_paths_unserializable_data,
@@ -28,6 +28,18 @@ MINIMAL_MESSAGE_SCHEMA: Final = vol.Schema(
 # Base schema to extend by message handlers
 BASE_COMMAND_MESSAGE_SCHEMA: Final = vol.Schema({vol.Required("id"): cv.positive_int})
 
+# Keys of the compressed states sent by subscribe_entities
+COMPRESSED_STATE_STATE: Final = "s"
+COMPRESSED_STATE_ATTRIBUTES: Final = "a"
+COMPRESSED_STATE_CONTEXT: Final = "c"
+COMPRESSED_STATE_LAST_CHANGED: Final = "lc"
+COMPRESSED_STATE_LAST_UPDATED: Final = "lu"
+
+# Keys of the entity events sent by subscribe_entities
+ENTITY_EVENT_ADD: Final = "a"
+ENTITY_EVENT_CHANGE: Final = "c"
+ENTITY_EVENT_REMOVE: Final = "r"
+
 IDEN_TEMPLATE: Final = "__IDEN__"
 IDEN_JSON_TEMPLATE: Final = '"__IDEN__"'
 
@@ -64,6 +76,70 @@ def cached_event_message(iden: int, event: Event) -> str:
     return _cached_event_message(event).replace(IDEN_JSON_TEMPLATE, str(iden), 1)
 
 
+def compressed_state_dict_add(state: State) -> dict[str, Any]:
+    """Return a compact dict of a state for subscribe_entities.
+
+    Timestamps are sent as seconds since the epoch and last_updated
+    is left out when it matches last_changed.
+    """
+    compressed_state: dict[str, Any] = {
+        COMPRESSED_STATE_STATE: state.state,
+        COMPRESSED_STATE_ATTRIBUTES: state.attributes,
+        COMPRESSED_STATE_CONTEXT: state.context.id,
+        COMPRESSED_STATE_LAST_CHANGED: state.last_changed.timestamp(),
+    }
+    if state.last_changed != state.last_updated:
+        compressed_state[COMPRESSED_STATE_LAST_UPDATED] = state.last_updated.timestamp()
+    return compressed_state
+
+
+def compressed_state_diff(old_state: State, new_state: State) -> dict[str, Any]:
+    """Return what changed between two states for subscribe_entities.
+
+    Changed values are under "+" and the keys of removed attributes
+    are under "-". A change of last_changed implies the same
+    last_updated.
+    """
+    additions: dict[str, Any] = {}
+    diff: dict[str, Any] = {"+": additions}
+    if old_state.state != new_state.state:
+        additions[COMPRESSED_STATE_STATE] = new_state.state
+    if old_state.last_changed != new_state.last_changed:
+        additions[COMPRESSED_STATE_LAST_CHANGED] = new_state.last_changed.timestamp()
+    elif old_state.last_updated != new_state.last_updated:
+        additions[COMPRESSED_STATE_LAST_UPDATED] = new_state.last_updated.timestamp()
+    if old_state.context.id != new_state.context.id:
+        additions[COMPRESSED_STATE_CONTEXT] = new_state.context.id
+
+    old_attributes = old_state.attributes
+    new_attributes = new_state.attributes
+    if old_attributes is new_attributes or old_attributes == new_attributes:
+        return diff
+
+    changed_attributes = {
+        key: value
+        for key, value in new_attributes.items()
+        if key not in old_attributes or old_attributes[key] != value
+    }
+    if changed_attributes:
+        additions[COMPRESSED_STATE_ATTRIBUTES] = changed_attributes
+    if removed_attributes := [
+        key for key in old_attributes if key not in new_attributes
+    ]:
+        diff["-"] = {COMPRESSED_STATE_ATTRIBUTES: removed_attributes}
+    return diff
+
+
+def split_event_message(event: Event) -> tuple[str, str]:
+    """Return the json of an event message split where the id goes.
+
+    Broadcasting joins the parts around the id of each subscription
+    instead of serializing the event per connection.
+    """
+    head, tail = _cached_event_message(event).split(IDEN_JSON_TEMPLATE, 1)
+    return head, tail
+
+
 @lru_cache(maxsize=128)
 def _cached_event_message(event: Event) -> str:
     """Cache and serialize the event to json.
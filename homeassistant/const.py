@@ -651,6 +651,7 @@ URL_API_SERVICES_SERVICE: Final = "/api/services/{}/{}"
 URL_API_COMPONENTS: Final = "/api/components"
 URL_API_ERROR_LOG: Final = "/api/error_log"
 URL_API_LOG_OUT: Final = "/api/log_out"
+URL_API_METRICS: Final = "/api/metrics"
 URL_API_TEMPLATE: Final = "/api/template"
 
 HTTP_OK: Final = 200
@@ -7,7 +7,16 @@ of entities and react to changes.
 from __future__ import annotations
 
 import asyncio
-from collections.abc import Awaitable, Collection, Coroutine, Iterable, Mapping
+from collections.abc import (
+    Awaitable,
+    Collection,
+    Coroutine,
+    Generator,
+    Iterable,
+    Mapping,
+)
+from contextlib import contextmanager
+from contextvars import ContextVar
 import datetime
 import enum
 import functools
@@ -16,9 +25,9 @@ import os
 import pathlib
 import re
 import threading
-from time import monotonic
+from time import monotonic, perf_counter
 from types import MappingProxyType
-from typing import TYPE_CHECKING, Any, Callable, Optional, TypeVar, cast
+from typing import TYPE_CHECKING, Any, Callable, NamedTuple, Optional, TypeVar, cast
 from urllib.parse import urlparse
 
 import attr
@@ -67,6 +76,13 @@ from homeassistant.util.async_ import (
     shutdown_run_callback_threadsafe,
 )
 import homeassistant.util.dt as dt_util
+from homeassistant.util.executor import InterruptibleThreadPoolExecutor
+from homeassistant.util.metrics import (
+    Counter,
+    Histogram,
+    MetricsRegistry,
+    async_track_loop_lag,
+)
 from homeassistant.util.timeout import TimeoutManager
 from homeassistant.util.unit_system import IMPERIAL_SYSTEM, METRIC_SYSTEM, UnitSystem
 import homeassistant.util.uuid as uuid_util
@@ -219,6 +235,7 @@ class HomeAssistant:
         self.loop = asyncio.get_running_loop()
         self._pending_tasks: list = []
         self._track_task = True
+        self.metrics = MetricsRegistry()
         self.bus = EventBus(self)
         self.services = ServiceRegistry(self)
         self.states = StateMachine(self.bus, self.loop)
@@ -233,6 +250,30 @@ class HomeAssistant:
         self._stopped: asyncio.Event | None = None
         # Timeout handler for Core/Helper namespace
         self.timeout: TimeoutManager = TimeoutManager()
+        self.metrics.gauge(
+            "executor_queue_depth",
+            "Jobs waiting for a thread of the executor",
+            self._executor_queue_depth,
+        )
+        self.metrics.listen_enable(self._async_enable_loop_metrics)
+
+    def _executor_queue_depth(self) -> float:
+        """Return the number of jobs waiting for the default executor."""
+        executor = self.loop._default_executor  # type: ignore  # pylint: disable=protected-access
+        if isinstance(executor, InterruptibleThreadPoolExecutor):
+            return executor.queue_depth()
+        return 0
+
+    @callback
+    def _async_enable_loop_metrics(self) -> None:
+        """Start measuring how late the event loop runs timers."""
+        stop = async_track_loop_lag(
+            self.loop,
+            self.metrics.histogram(
+                "loop_lag_seconds", "Delay of the event loop running a timer"
+            ),
+        )
+        self.bus.async_listen_once(EVENT_HOMEASSISTANT_CLOSE, lambda _: stop())
 
     @property
     def is_running(self) -> bool:
@@ -657,13 +698,55 @@ class Event:
         )
 
 
+class _FilterableJob(NamedTuple):
+    """Event listener job to be executed with optional filter."""
+
+    job: HassJob
+    event_filter: Callable[[Event], bool] | None
+    exclude_event_types: frozenset[str] | None = None
+
+
 class EventBus:
     """Allow the firing of and listening for events."""
 
     def __init__(self, hass: HomeAssistant) -> None:
         """Initialize a new event bus."""
-        self._listeners: dict[str, list[tuple[HassJob, Callable | None]]] = {}
+        self._listeners: dict[str, list[_FilterableJob]] = {}
+        # The dispatch index is rebuilt every time a listener is added or
+        # removed so firing an event never has to combine or copy lists.
+        # Event types without a dispatch entry only go to MATCH_ALL listeners.
+        self._dispatch: dict[str, tuple[_FilterableJob, ...]] = {
+            EVENT_HOMEASSISTANT_CLOSE: ()
+        }
+        self._match_all_dispatch: tuple[_FilterableJob, ...] = ()
+        self._match_all_excluded: set[str] = set()
+        # event_type -> event data key -> data value -> jobs
+        self._keyed_listeners: dict[str, dict[str, dict[str, list[HassJob]]]] = {}
+        self._keyed_listener_count: dict[str, int] = {}
+        # Each keyed index is dispatched by one regular listener so keyed
+        # listeners keep their place in the order listeners were added
+        self._keyed_dispatchers: dict[tuple[str, str], CALLBACK_TYPE] = {}
+        self._batch_listeners: dict[str, list[HassJob]] = {}
+        # Called when a listener that receives EVENT_TIME_CHANGED is added
+        self._time_listener_added: Callable[[], None] | None = None
         self._hass = hass
+        # Set once the metrics are enabled
+        self._events_fired: Counter | None = None
+        self._listener_seconds: Histogram | None = None
+        hass.metrics.listen_enable(self._async_enable_metrics)
+
+    @callback
+    def _async_enable_metrics(self) -> None:
+        """Start counting the events and timing the callback listeners."""
+        metrics = self._hass.metrics
+        self._events_fired = metrics.counter(
+            "events_fired_total", "Events fired", "event_type"
+        )
+        self._listener_seconds = metrics.histogram(
+            "event_listener_seconds",
+            "Time the event loop spent in callback event listeners",
+            "event_type",
+        )
 
     @callback
     def async_listeners(self) -> dict[str, int]:
@@ -671,7 +754,47 @@ class EventBus:
 
         This method must be run in the event loop.
         """
-        return {key: len(listeners) for key, listeners in self._listeners.items()}
+        listeners = {key: len(listeners) for key, listeners in self._listeners.items()}
+        for key, _ in self._keyed_dispatchers:
+            listeners[key] -= 1
+        for key, count in self._keyed_listener_count.items():
+            listeners[key] = listeners.get(key, 0) + count
+        for key, jobs in self._batch_listeners.items():
+            listeners[key] = listeners.get(key, 0) + len(jobs)
+        return listeners
+
+    @callback
+    def async_has_listeners(self, event_type: str) -> bool:
+        """Return if firing an event of a type would reach any listener.
+
+        This method must be run in the event loop.
+        """
+        return bool(
+            self._dispatch.get(event_type, self._match_all_dispatch)
+            or event_type in self._keyed_listener_count
+            or event_type in self._batch_listeners
+        )
+
+    @callback
+    def async_set_time_listener_added(
+        self, time_listener_added: Callable[[], None] | None
+    ) -> None:
+        """Set the function called when a time changed listener may have been added.
+
+        The timer uses this to only fire EVENT_TIME_CHANGED while it is listened to.
+
+        This method must be run in the event loop.
+        """
+        self._time_listener_added = time_listener_added
+
+    @callback
+    def _async_listener_added(self, event_type: str) -> None:
+        """Wake up the timer if the listener receives EVENT_TIME_CHANGED."""
+        if self._time_listener_added is not None and event_type in (
+            EVENT_TIME_CHANGED,
+            MATCH_ALL,
+        ):
+            self._time_listener_added()
 
     @property
     def listeners(self) -> dict[str, int]:
@@ -708,22 +831,71 @@ class EventBus:
                 event_type, "event_type", MAX_LENGTH_EVENT_EVENT_TYPE
             )
 
-        listeners = self._listeners.get(event_type, [])
-
-        # EVENT_HOMEASSISTANT_CLOSE should go only to his listeners
-        match_all_listeners = self._listeners.get(MATCH_ALL)
-        if match_all_listeners is not None and event_type != EVENT_HOMEASSISTANT_CLOSE:
-            listeners = match_all_listeners + listeners
-
         event = Event(event_type, event_data, origin, time_fired, context)
 
         if event_type != EVENT_TIME_CHANGED:
             _LOGGER.debug("Bus:Handling %s", event)
 
-        if not listeners:
-            return
+        self._async_dispatch(event)
+
+        if (batch_jobs := self._batch_listeners.get(event_type)) is not None:
+            events = [event]
+            for job in batch_jobs:
+                self._hass.async_add_hass_job(job, events)
 
-        for job, event_filter in listeners:
+    @callback
+    def async_fire_batch(
+        self,
+        event_type: str,
+        batch: Iterable[
+            tuple[dict[str, Any] | None, Context | None, datetime.datetime | None]
+        ],
+        origin: EventOrigin = EventOrigin.local,
+    ) -> None:
+        """Fire a group of events of the same type.
+
+        batch is an iterable of (event_data, context, time_fired) tuples.
+
+        Every event is delivered to regular listeners one by one, exactly
+        as if it was fired with async_fire. Listeners added with
+        async_listen_batch are called once with the list of all events.
+
+        This method must be run in the event loop.
+        """
+        if len(event_type) > MAX_LENGTH_EVENT_EVENT_TYPE:
+            raise MaxLengthExceeded(
+                event_type, "event_type", MAX_LENGTH_EVENT_EVENT_TYPE
+            )
+
+        events = [
+            Event(event_type, event_data, origin, time_fired, context)
+            for event_data, context, time_fired in batch
+        ]
+
+        for event in events:
+            if event_type != EVENT_TIME_CHANGED:
+                _LOGGER.debug("Bus:Handling %s", event)
+            self._async_dispatch(event)
+
+        if events and (batch_jobs := self._batch_listeners.get(event_type)):
+            for job in batch_jobs:
+                self._hass.async_add_hass_job(job, events)
+
+    @callback
+    def _async_dispatch(self, event: Event) -> None:
+        """Dispatch an event to the listeners of its type."""
+        # EVENT_HOMEASSISTANT_CLOSE always has a dispatch entry so
+        # it only goes to its own listeners
+        listeners = self._dispatch.get(event.event_type, self._match_all_dispatch)
+
+        add_job: Callable[[HassJob, Event], Any]
+        if self._events_fired is None:
+            add_job = self._hass.async_add_hass_job
+        else:
+            self._events_fired.inc(label=event.event_type)
+            add_job = self._async_add_timed_job
+
+        for job, event_filter, _ in listeners:
             if event_filter is not None:
                 try:
                     if not event_filter(event):
@@ -731,8 +903,28 @@ class EventBus:
                 except Exception:  # pylint: disable=broad-except
                     _LOGGER.exception("Error in event filter")
                     continue
+            add_job(job, event)
+
+    @callback
+    def _async_add_timed_job(self, job: HassJob, event: Event) -> None:
+        """Add a listener job and time it if it runs in the event loop."""
+        if job.job_type == HassJobType.Callback:
+            self._hass.loop.call_soon(self._async_run_timed, job.target, event)
+        else:
             self._hass.async_add_hass_job(job, event)
 
+    @callback
+    def _async_run_timed(self, target: Callable[[Event], Any], event: Event) -> None:
+        """Run a callback listener and measure how long it took."""
+        start = perf_counter()
+        try:
+            target(event)
+        finally:
+            if self._listener_seconds is not None:
+                self._listener_seconds.observe(
+                    perf_counter() - start, event.event_type
+                )
+
     def listen(self, event_type: str, listener: Callable) -> CALLBACK_TYPE:
         """Listen for all events or events of a specific type.
 
@@ -755,6 +947,7 @@ class EventBus:
         event_type: str,
         listener: Callable,
         event_filter: Callable | None = None,
+        exclude_event_types: Iterable[str] | None = None,
     ) -> CALLBACK_TYPE:
         """Listen for all events or events of a specific type.
 
@@ -765,19 +958,171 @@ class EventBus:
         @callback that returns a boolean value, determines if the
         listener callable should run.
 
+        When listening to ``MATCH_ALL``, exclude_event_types lists event
+        types that are never delivered to the listener. Unlike an
+        event_filter this is resolved when the listener is added.
+
         This method must be run in the event loop.
         """
         if event_filter is not None and not is_callback(event_filter):
             raise HomeAssistantError(f"Event filter {event_filter} is not a callback")
+        excluded: frozenset[str] | None = None
+        if exclude_event_types:
+            if event_type != MATCH_ALL:
+                raise HomeAssistantError(
+                    "Excluding event types is only supported for MATCH_ALL listeners"
+                )
+            excluded = frozenset(exclude_event_types)
+        return self._async_listen_filterable_job(
+            event_type, _FilterableJob(HassJob(listener), event_filter, excluded)
+        )
+
+    @callback
+    def async_listen_keyed(
+        self,
+        event_type: str,
+        data_key: str,
+        keys: Iterable[str],
+        listener: Callable,
+    ) -> CALLBACK_TYPE:
+        """Listen for events of a specific type indexed by an event data value.
+
+        The listener only runs for events where event.data[data_key] is one
+        of keys. Matching is a dict lookup at fire time, so this scales to
+        many listeners that each care about a few values, for example
+        EVENT_STATE_CHANGED listeners keyed on entity_id.
+
+        This method must be run in the event loop.
+        """
+        if event_type == MATCH_ALL:
+            raise HomeAssistantError("Keyed listeners require a specific event type")
+
+        keys = list(keys)
+        job = HassJob(listener)
+        keyed_jobs = self.async_keyed_listeners(event_type, data_key)
+        dispatch_key = (event_type, data_key)
+        if keys and dispatch_key not in self._keyed_dispatchers:
+            self._keyed_dispatchers[dispatch_key] = self._async_listen_keyed_dispatch(
+                event_type, data_key, keyed_jobs
+            )
+        for key in keys:
+            keyed_jobs.setdefault(key, []).append(job)
+        self._keyed_listener_count[event_type] = (
+            self._keyed_listener_count.get(event_type, 0) + 1
+        )
+        self._async_listener_added(event_type)
+
+        @callback
+        def remove_listener() -> None:
+            """Remove the listener."""
+            nonlocal keys
+            if not keys:
+                _LOGGER.error("Unable to remove unknown job listener %s", job)
+                return
+            for key in keys:
+                jobs = keyed_jobs[key]
+                jobs.remove(job)
+                if not jobs:
+                    del keyed_jobs[key]
+            keys = []
+            if not keyed_jobs:
+                self._keyed_dispatchers.pop(dispatch_key)()
+            if count := self._keyed_listener_count[event_type] - 1:
+                self._keyed_listener_count[event_type] = count
+            else:
+                del self._keyed_listener_count[event_type]
+
+        return remove_listener
+
+    @callback
+    def _async_listen_keyed_dispatch(
+        self, event_type: str, data_key: str, keyed_jobs: dict[str, list[HassJob]]
+    ) -> CALLBACK_TYPE:
+        """Listen for the events of a keyed index and run its jobs."""
+        if event_type == EVENT_STATE_CHANGED:
+            description = "state change"
+        else:
+            description = f"{event_type} event"
+
+        @callback
+        def _async_keyed_filter(event: Event) -> bool:
+            """Filter the events by the keys of the index."""
+            key = event.data.get(data_key)
+            return isinstance(key, str) and key in keyed_jobs
+
+        @callback
+        def _async_keyed_dispatcher(event: Event) -> None:
+            """Run the jobs of the key of the event."""
+            key = event.data[data_key]
+
+            if key not in keyed_jobs:
+                return
+
+            for job in keyed_jobs[key][:]:
+                try:
+                    self._hass.async_run_hass_job(job, event)
+                except Exception:  # pylint: disable=broad-except
+                    _LOGGER.exception(
+                        "Error while processing %s for %s", description, key
+                    )
+
         return self._async_listen_filterable_job(
-            event_type, (HassJob(listener), event_filter)
+            event_type,
+            _FilterableJob(HassJob(_async_keyed_dispatcher), _async_keyed_filter),
+        )
+
+    @callback
+    def async_listen_batch(self, event_type: str, listener: Callable) -> CALLBACK_TYPE:
+        """Listen for events of a specific type delivered in groups.
+
+        The listener is called with a list of events. Events fired with
+        async_fire arrive as a list with a single event, while a group
+        fired with async_fire_batch arrives as one list. The list is
+        shared between batch listeners and must not be modified.
+
+        This method must be run in the event loop.
+        """
+        if event_type == MATCH_ALL:
+            raise HomeAssistantError("Batch listeners require a specific event type")
+
+        job = HassJob(listener)
+        self._batch_listeners.setdefault(event_type, []).append(job)
+        self._async_listener_added(event_type)
+
+        @callback
+        def remove_listener() -> None:
+            """Remove the listener."""
+            try:
+                self._batch_listeners[event_type].remove(job)
+                if not self._batch_listeners[event_type]:
+                    self._batch_listeners.pop(event_type)
+            except (KeyError, ValueError):
+                _LOGGER.exception("Unable to remove unknown job listener %s", job)
+
+        return remove_listener
+
+    @callback
+    def async_keyed_listeners(
+        self, event_type: str, data_key: str
+    ) -> dict[str, list[HassJob]]:
+        """Return the keyed listener index for an event type and data key.
+
+        The returned dict maps data values to jobs. It is owned by the bus
+        and must only be modified through async_listen_keyed.
+
+        This method must be run in the event loop.
+        """
+        return self._keyed_listeners.setdefault(event_type, {}).setdefault(
+            data_key, {}
         )
 
     @callback
     def _async_listen_filterable_job(
-        self, event_type: str, filterable_job: tuple[HassJob, Callable | None]
+        self, event_type: str, filterable_job: _FilterableJob
     ) -> CALLBACK_TYPE:
         self._listeners.setdefault(event_type, []).append(filterable_job)
+        self._async_update_dispatch(event_type)
+        self._async_listener_added(event_type)
 
         def remove_listener() -> None:
             """Remove the listener."""
@@ -785,6 +1130,52 @@ class EventBus:
 
         return remove_listener
 
+    @callback
+    def _async_update_dispatch(self, event_type: str) -> None:
+        """Rebuild the dispatch index after the listeners of event_type changed."""
+        if event_type != MATCH_ALL:
+            self._async_build_dispatch(event_type)
+            return
+
+        match_all = self._listeners.get(MATCH_ALL, [])
+        self._match_all_dispatch = tuple(match_all)
+        self._match_all_excluded = set()
+        for filterable_job in match_all:
+            if filterable_job.exclude_event_types:
+                self._match_all_excluded.update(filterable_job.exclude_event_types)
+
+        for dispatch_event_type in {
+            *self._dispatch,
+            *self._listeners,
+            *self._match_all_excluded,
+        }:
+            if dispatch_event_type != MATCH_ALL:
+                self._async_build_dispatch(dispatch_event_type)
+
+    @callback
+    def _async_build_dispatch(self, event_type: str) -> None:
+        """Build the dispatch entry for a single event type."""
+        listeners = self._listeners.get(event_type, [])
+
+        # EVENT_HOMEASSISTANT_CLOSE should go only to his listeners
+        if event_type == EVENT_HOMEASSISTANT_CLOSE:
+            self._dispatch[event_type] = tuple(listeners)
+            return
+
+        if not listeners and event_type not in self._match_all_excluded:
+            self._dispatch.pop(event_type, None)
+            return
+
+        self._dispatch[event_type] = (
+            *(
+                filterable_job
+                for filterable_job in self._listeners.get(MATCH_ALL, [])
+                if not filterable_job.exclude_event_types
+                or event_type not in filterable_job.exclude_event_types
+            ),
+            *listeners,
+        )
+
     def listen_once(
         self, event_type: str, listener: Callable[[Event], None]
     ) -> CALLBACK_TYPE:
@@ -816,7 +1207,7 @@ class EventBus:
 
         This method must be run in the event loop.
         """
-        filterable_job: tuple[HassJob, Callable | None] | None = None
+        filterable_job: _FilterableJob | None = None
 
         @callback
         def _onetime_listener(event: Event) -> None:
@@ -834,13 +1225,13 @@ class EventBus:
             self._async_remove_listener(event_type, filterable_job)
             self._hass.async_run_job(listener, event)
 
-        filterable_job = (HassJob(_onetime_listener), None)
+        filterable_job = _FilterableJob(HassJob(_onetime_listener), None)
 
         return self._async_listen_filterable_job(event_type, filterable_job)
 
     @callback
     def _async_remove_listener(
-        self, event_type: str, filterable_job: tuple[HassJob, Callable | None]
+        self, event_type: str, filterable_job: _FilterableJob
     ) -> None:
         """Remove a listener of a specific event_type.
 
@@ -858,6 +1249,9 @@ class EventBus:
             _LOGGER.exception(
                 "Unable to remove unknown job listener %s", filterable_job
             )
+            return
+
+        self._async_update_dispatch(event_type)
 
 
 class State:
@@ -912,7 +1306,11 @@ class State:
 
         self.entity_id = entity_id.lower()
         self.state = state
-        self.attributes = MappingProxyType(attributes or {})
+        if isinstance(attributes, MappingProxyType):
+            # Share the read only attributes of another state
+            self.attributes = attributes
+        else:
+            self.attributes = MappingProxyType(attributes or {})
         self.last_updated = last_updated or dt_util.utcnow()
         self.last_changed = last_changed or self.last_updated
         self.context = context or Context()
@@ -1009,9 +1407,15 @@ class StateMachine:
     def __init__(self, bus: EventBus, loop: asyncio.events.AbstractEventLoop) -> None:
         """Initialize state machine."""
         self._states: dict[str, State] = {}
+        # domain -> entity_id -> state, kept in sync with _states
+        self._domain_index: dict[str, dict[str, State]] = {}
         self._reservations: set[str] = set()
         self._bus = bus
         self._loop = loop
+        # The open batch of the running task, see async_batch
+        self._batch: ContextVar[_StateChangedBatch | None] = ContextVar(
+            "state_changed_batch", default=None
+        )
 
     def entity_ids(self, domain_filter: str | None = None) -> list[str]:
         """List of entity ids that are being tracked."""
@@ -1032,12 +1436,12 @@ class StateMachine:
             return list(self._states)
 
         if isinstance(domain_filter, str):
-            domain_filter = (domain_filter.lower(),)
+            return list(self._domain_index.get(domain_filter.lower(), ()))
 
         return [
-            state.entity_id
-            for state in self._states.values()
-            if state.domain in domain_filter
+            entity_id
+            for domain in dict.fromkeys(domain_filter)
+            for entity_id in self._domain_index.get(domain, ())
         ]
 
     @callback
@@ -1052,10 +1456,11 @@ class StateMachine:
             return len(self._states)
 
         if isinstance(domain_filter, str):
-            domain_filter = (domain_filter.lower(),)
+            return len(self._domain_index.get(domain_filter.lower(), ()))
 
-        return len(
-            [None for state in self._states.values() if state.domain in domain_filter]
+        return sum(
+            len(self._domain_index.get(domain, ()))
+            for domain in dict.fromkeys(domain_filter)
         )
 
     def all(self, domain_filter: str | Iterable | None = None) -> list[State]:
@@ -1074,10 +1479,12 @@ class StateMachine:
             return list(self._states.values())
 
         if isinstance(domain_filter, str):
-            domain_filter = (domain_filter.lower(),)
+            return list(self._domain_index.get(domain_filter.lower(), {}).values())
 
         return [
-            state for state in self._states.values() if state.domain in domain_filter
+            state
+            for domain in dict.fromkeys(domain_filter)
+            for state in self._domain_index.get(domain, {}).values()
         ]
 
     def get(self, entity_id: str) -> State | None:
@@ -1121,11 +1528,15 @@ class StateMachine:
         if old_state is None:
             return False
 
-        self._bus.async_fire(
-            EVENT_STATE_CHANGED,
+        domain_states = self._domain_index[old_state.domain]
+        del domain_states[entity_id]
+        if not domain_states:
+            del self._domain_index[old_state.domain]
+
+        self._async_fire_state_changed(
             {"entity_id": entity_id, "old_state": old_state, "new_state": None},
-            EventOrigin.local,
-            context=context,
+            context,
+            None,
         )
         return True
 
@@ -1189,6 +1600,8 @@ class StateMachine:
         """Set the state of an entity, add entity if it does not exist.
 
         Attributes is an optional dict to specify attributes of this state.
+        Passing the attributes of the current state marks them unchanged
+        without comparing them, the new state then shares them.
 
         If you just update the attributes and not the state, last changed will
         not be affected.
@@ -1204,7 +1617,9 @@ class StateMachine:
             last_changed = None
         else:
             same_state = old_state.state == new_state and not force_update
-            same_attr = old_state.attributes == MappingProxyType(attributes)
+            same_attr = attributes is old_state.attributes or (
+                old_state.attributes == MappingProxyType(attributes)
+            )
             last_changed = old_state.last_changed if same_state else None
 
         if same_state and same_attr:
@@ -1225,15 +1640,107 @@ class StateMachine:
             old_state is None,
         )
         self._states[entity_id] = state
+        if (domain_states := self._domain_index.get(state.domain)) is None:
+            domain_states = self._domain_index[state.domain] = {}
+        domain_states[entity_id] = state
+        self._async_fire_state_changed(
+            {"entity_id": entity_id, "old_state": old_state, "new_state": state},
+            context,
+            now,
+        )
+
+    @callback
+    def async_set_many(
+        self,
+        states: Iterable[tuple[str, str, Mapping[str, Any] | None]],
+        force_update: bool = False,
+        context: Context | None = None,
+    ) -> None:
+        """Set the state of many entities at once.
+
+        states is an iterable of (entity_id, new_state, attributes) tuples.
+        The resulting state_changed events are fired as one batch.
+
+        This method must be run in the event loop.
+        """
+        with self.async_batch():
+            for entity_id, new_state, attributes in states:
+                self.async_set(entity_id, new_state, attributes, force_update, context)
+
+    @contextmanager
+    def async_batch(self) -> Generator[None, None, None]:
+        """Group the state changes made inside the context into one batch.
+
+        States are updated in the state machine right away. The state_changed
+        events are held back until the outermost batch exits and are then
+        fired with EventBus.async_fire_batch, so regular listeners still see
+        every event while batch listeners process them in one pass.
+
+        Only the state changes of the task that opened the batch are held
+        back. Awaiting inside the batch does not delay the events of other
+        tasks, nor of the tasks and callbacks it schedules.
+
+        This method must be run in the event loop.
+        """
+        if self._async_current_batch() is not None:
+            yield
+            return
+
+        batch = _StateChangedBatch(asyncio.current_task())
+        token = self._batch.set(batch)
+        try:
+            yield
+        finally:
+            self._batch.reset(token)
+            batch.open = False
+            if batch.events:
+                self._bus.async_fire_batch(EVENT_STATE_CHANGED, batch.events)
+
+    @callback
+    def _async_current_batch(self) -> _StateChangedBatch | None:
+        """Return the open batch of the running task."""
+        if (batch := self._batch.get()) is None or not batch.open:
+            return None
+        # Tasks and callbacks scheduled inside a batch inherit the context
+        if batch.task is not asyncio.current_task():
+            return None
+        return batch
+
+    @callback
+    def _async_fire_state_changed(
+        self,
+        event_data: dict[str, Any],
+        context: Context | None,
+        time_fired: datetime.datetime | None,
+    ) -> None:
+        """Fire a state_changed event or hold it back if a batch is active."""
+        if (batch := self._async_current_batch()) is not None:
+            batch.events.append((event_data, context, time_fired))
+            return
+
         self._bus.async_fire(
             EVENT_STATE_CHANGED,
-            {"entity_id": entity_id, "old_state": old_state, "new_state": state},
+            event_data,
             EventOrigin.local,
             context,
-            time_fired=now,
+            time_fired=time_fired,
         )
 
 
+class _StateChangedBatch:
+    """The state_changed events held back by StateMachine.async_batch."""
+
+    __slots__ = ("task", "open", "events")
+
+    def __init__(self, task: asyncio.Task | None) -> None:
+        """Initialize the batch of a task, or of a callback without a task."""
+        self.task = task
+        self.open = True
+        self.events: list[
+            tuple[dict[str, Any], Context | None, datetime.datetime | None]
+        ] = []
+
+
 class Service:
     """Representation of a callable service."""
 
@@ -1765,8 +2272,13 @@ class Config:
 
 
 def _async_create_timer(hass: HomeAssistant) -> None:
-    """Create a timer that will start on HOMEASSISTANT_START."""
+    """Create a timer that will start on HOMEASSISTANT_START.
+
+    The timer only ticks while EVENT_TIME_CHANGED has listeners and goes
+    idle otherwise, time based helpers do not depend on it.
+    """
     handle = None
+    stopped = False
     timer_context = Context()
 
     def schedule_tick(now: datetime.datetime) -> None:
@@ -1780,6 +2292,12 @@ def _async_create_timer(hass: HomeAssistant) -> None:
     @callback
     def fire_time_event(target: float) -> None:
         """Fire next time event."""
+        nonlocal handle
+
+        if not hass.bus.async_has_listeners(EVENT_TIME_CHANGED):
+            handle = None
+            return
+
         now = dt_util.utcnow()
 
         hass.bus.async_fire(
@@ -1797,13 +2315,26 @@ def _async_create_timer(hass: HomeAssistant) -> None:
 
         schedule_tick(now)
 
+    def time_listener_added() -> None:
+        """Resume ticking when EVENT_TIME_CHANGED got a listener."""
+        if (
+            handle is None
+            and not stopped
+            and hass.bus.async_has_listeners(EVENT_TIME_CHANGED)
+        ):
+            schedule_tick(dt_util.utcnow())
+
     @callback
     def stop_timer(_: Event) -> None:
         """Stop the timer."""
+        nonlocal stopped
+        stopped = True
         if handle is not None:
             handle.cancel()
 
+    hass.bus.async_set_time_listener_added(time_listener_added)
     hass.bus.async_listen_once(EVENT_HOMEASSISTANT_STOP, stop_timer)
 
     _LOGGER.info("Timer:starting")
-    schedule_tick(dt_util.utcnow())
+    if hass.bus.async_has_listeners(EVENT_TIME_CHANGED):
+        schedule_tick(dt_util.utcnow())
@@ -157,11 +157,17 @@ class DeviceRegistry:
     deleted_devices: dict[str, DeletedDeviceEntry]
     _registered_index: _DeviceIndex
     _deleted_index: _DeviceIndex
+    # area_id -> ids of the registered devices in the area
+    _area_index: dict[str, dict[str, None]]
 
     def __init__(self, hass: HomeAssistant) -> None:
         """Initialize the device registry."""
         self.hass = hass
-        self._store = hass.helpers.storage.Store(STORAGE_VERSION, STORAGE_KEY)
+        self._store = hass.helpers.storage.Store(
+            STORAGE_VERSION,
+            STORAGE_KEY,
+            journal={"devices": "id", "deleted_devices": "id"},
+        )
         self._clear_index()
 
     @callback
@@ -169,6 +175,11 @@ class DeviceRegistry:
         """Get device."""
         return self.devices.get(device_id)
 
+    @callback
+    def async_device_ids_for_area(self, area_id: str) -> list[str]:
+        """Return the ids of the devices in an area."""
+        return list(self._area_index.get(area_id, ()))
+
     @callback
     def async_get_device(
         self,
@@ -204,6 +215,7 @@ class DeviceRegistry:
         else:
             devices_index = self._registered_index
             self.devices[device.id] = device
+            self._add_device_to_area_index(device)
 
         _add_device_to_index(devices_index, device)
 
@@ -215,6 +227,7 @@ class DeviceRegistry:
         else:
             devices_index = self._registered_index
             self.devices.pop(device.id)
+            self._remove_device_from_area_index(device)
 
         _remove_device_from_index(devices_index, device)
 
@@ -226,16 +239,39 @@ class DeviceRegistry:
         _remove_device_from_index(devices_index, old_device)
         _add_device_to_index(devices_index, new_device)
 
+        if old_device.area_id != new_device.area_id:
+            self._remove_device_from_area_index(old_device)
+            self._add_device_to_area_index(new_device)
+
+    def _add_device_to_area_index(self, device: DeviceEntry) -> None:
+        """Add a device to the area index."""
+        if device.area_id is None:
+            return
+        if (device_ids := self._area_index.get(device.area_id)) is None:
+            device_ids = self._area_index[device.area_id] = {}
+        device_ids[device.id] = None
+
+    def _remove_device_from_area_index(self, device: DeviceEntry) -> None:
+        """Remove a device from the area index."""
+        if device.area_id is None:
+            return
+        device_ids = self._area_index[device.area_id]
+        del device_ids[device.id]
+        if not device_ids:
+            del self._area_index[device.area_id]
+
     def _clear_index(self) -> None:
         """Clear the index."""
         self._registered_index = _DeviceIndex(identifiers={}, connections={})
         self._deleted_index = _DeviceIndex(identifiers={}, connections={})
+        self._area_index = {}
 
     def _rebuild_index(self) -> None:
         """Create the index after loading devices."""
         self._clear_index()
         for device in self.devices.values():
             _add_device_to_index(self._registered_index, device)
+            self._add_device_to_area_index(device)
         for deleted_device in self.deleted_devices.values():
             _add_device_to_index(self._deleted_index, deleted_device)
 
@@ -617,9 +653,8 @@ class DeviceRegistry:
     @callback
     def async_clear_area_id(self, area_id: str) -> None:
         """Clear area id from registry entries."""
-        for dev_id, device in self.devices.items():
-            if area_id == device.area_id:
-                self._async_update_device(dev_id, area_id=None)
+        for dev_id in self.async_device_ids_for_area(area_id):
+            self._async_update_device(dev_id, area_id=None)
 
 
 @callback
@@ -647,7 +682,10 @@ async def async_get_registry(hass: HomeAssistant) -> DeviceRegistry:
 @callback
 def async_entries_for_area(registry: DeviceRegistry, area_id: str) -> list[DeviceEntry]:
     """Return entries that match an area."""
-    return [device for device in registry.devices.values() if device.area_id == area_id]
+    devices = registry.devices
+    return [
+        devices[device_id] for device_id in registry.async_device_ids_for_area(area_id)
+    ]
 
 
 @callback
@@ -230,6 +230,19 @@ class Entity(ABC):
     # If entity is added to an entity platform
     _added = False
 
+    # Set to True when the attributes other than the state attributes and
+    # extra state attributes only change with the registry entry. They are
+    # then read once instead of on every state write.
+    _static_attributes = False
+    _static_attributes_cache: tuple[
+        RegistryEntry | None, dict[str, Any] | None, dict[str, Any]
+    ] | None = None
+    # What the last written attributes were made of, their mapping in the
+    # state machine and the unit before temperature conversion
+    _written_attributes: tuple[
+        tuple[Any, ...], Mapping[str, Any] | None, str | None
+    ] | None = None
+
     # Entity Properties
     _attr_assumed_state: bool = False
     _attr_available: bool = True
@@ -483,19 +496,157 @@ class Entity(ABC):
 
         start = timer()
 
+        if self._static_attributes:
+            state, attr = self._async_calculate_cached_state()
+        else:
+            state, attr = self._async_calculate_state()
+
+        end = timer()
+
+        if end - start > 0.4 and not self._slow_reported:
+            self._slow_reported = True
+            report_issue = self._suggest_report_issue()
+            _LOGGER.warning(
+                "Updating state for %s (%s) took %.3f seconds. Please %s",
+                self.entity_id,
+                type(self),
+                end - start,
+                report_issue,
+            )
+
+        if (
+            self._context_set is not None
+            and dt_util.utcnow() - self._context_set > self.context_recent_time
+        ):
+            self._context = None
+            self._context_set = None
+
+        self.hass.states.async_set(
+            self.entity_id, state, attr, self.force_update, self._context
+        )
+
+        if (written := self._written_attributes) is not None and written[1] is None:
+            # Remember the mapping of the written state to pass it on when the
+            # attributes do not change
+            if (new_state := self.hass.states.get(self.entity_id)) is not None:
+                self._written_attributes = (
+                    written[0],
+                    new_state.attributes,
+                    written[2],
+                )
+            else:
+                self._written_attributes = None
+
+    def _async_calculate_state(self) -> tuple[str, dict[str, Any]]:
+        """Calculate the state and attributes to write."""
         attr = self.capability_attributes
         attr = dict(attr) if attr else {}
 
         state = self._stringify_state()
         if self.available:
             attr.update(self.state_attributes or {})
-            extra_state_attributes = self.extra_state_attributes
-            # Backwards compatibility for "device_state_attributes" deprecated in 2021.4
-            # Add warning in 2021.6, remove in 2021.10
-            if extra_state_attributes is None:
-                extra_state_attributes = self.device_state_attributes
-            attr.update(extra_state_attributes or {})
+            attr.update(self._extra_state_attributes_compat() or {})
+
+        self._async_add_entity_attributes(attr)
+
+        # Overwrite properties that have been set in the config file.
+        if DATA_CUSTOMIZE in self.hass.data:
+            attr.update(self.hass.data[DATA_CUSTOMIZE].get(self.entity_id))
+
+        state, unit = self._async_convert_temperature(
+            state, attr.get(ATTR_UNIT_OF_MEASUREMENT)
+        )
+        if unit is not None:
+            attr[ATTR_UNIT_OF_MEASUREMENT] = unit
+        return state, attr
+
+    def _async_calculate_cached_state(self) -> tuple[str, Mapping[str, Any]]:
+        """Calculate the state and attributes to write with the static attributes.
+
+        Returns the attributes of the last written state when nothing they
+        are made of changed.
+        """
+        entry = self.registry_entry
+        if (static := self._static_attributes_cache) is None or static[0] is not entry:
+            capability_attributes = self.capability_attributes
+            entity_attributes: dict[str, Any] = {}
+            self._async_add_entity_attributes(entity_attributes)
+            static = self._static_attributes_cache = (
+                entry,
+                dict(capability_attributes) if capability_attributes else None,
+                entity_attributes,
+            )
 
+        state = self._stringify_state()
+        if available := self.available:
+            state_attributes = self.state_attributes
+            extra_state_attributes = self._extra_state_attributes_compat()
+        else:
+            state_attributes = extra_state_attributes = None
+        customize = None
+        if DATA_CUSTOMIZE in self.hass.data:
+            customize = self.hass.data[DATA_CUSTOMIZE].get(self.entity_id)
+        temperature_unit = self.hass.config.units.temperature_unit
+
+        key = (
+            static,
+            available,
+            state_attributes,
+            extra_state_attributes,
+            customize,
+            temperature_unit,
+        )
+        if (
+            (written := self._written_attributes) is not None
+            and written[1] is not None
+            and written[0] == key
+        ):
+            state, _ = self._async_convert_temperature(state, written[2])
+            return state, written[1]
+
+        _, capability_attributes, entity_attributes = static
+        attr = dict(capability_attributes) if capability_attributes else {}
+        if available:
+            attr.update(state_attributes or {})
+            attr.update(extra_state_attributes or {})
+        attr.update(entity_attributes)
+        if customize:
+            attr.update(customize)
+
+        unit_of_measurement = attr.get(ATTR_UNIT_OF_MEASUREMENT)
+        state, unit = self._async_convert_temperature(state, unit_of_measurement)
+        if unit is not None:
+            attr[ATTR_UNIT_OF_MEASUREMENT] = unit
+
+        # Keep copies as entities may return the same dict changed in place,
+        # the mapping is added once the state is written
+        self._written_attributes = (
+            (
+                static,
+                available,
+                None if state_attributes is None else dict(state_attributes),
+                None
+                if extra_state_attributes is None
+                else dict(extra_state_attributes),
+                customize,
+                temperature_unit,
+            ),
+            None,
+            unit_of_measurement,
+        )
+        return state, attr
+
+    def _extra_state_attributes_compat(self) -> Mapping[str, Any] | None:
+        """Return the extra state attributes."""
+        extra_state_attributes = self.extra_state_attributes
+        # Backwards compatibility for "device_state_attributes" deprecated in 2021.4
+        # Add warning in 2021.6, remove in 2021.10
+        if extra_state_attributes is None:
+            extra_state_attributes = self.device_state_attributes
+        return extra_state_attributes
+
+    def _async_add_entity_attributes(self, attr: dict[str, Any]) -> None:
+        """Add the attributes of the entity properties to attr."""
         unit_of_measurement = self.unit_of_measurement
         if unit_of_measurement is not None:
             attr[ATTR_UNIT_OF_MEASUREMENT] = unit_of_measurement
@@ -520,49 +671,27 @@ class Entity(ABC):
         if (device_class := self.device_class) is not None:
             attr[ATTR_DEVICE_CLASS] = str(device_class)
 
-        end = timer()
+    def _async_convert_temperature(
+        self, state: str, unit_of_measure: str | None
+    ) -> tuple[str, str | None]:
+        """Convert a temperature state to the configured unit.
 
-        if end - start > 0.4 and not self._slow_reported:
-            self._slow_reported = True
-            report_issue = self._suggest_report_issue()
-            _LOGGER.warning(
-                "Updating state for %s (%s) took %.3f seconds. Please %s",
-                self.entity_id,
-                type(self),
-                end - start,
-                report_issue,
-            )
-
-        # Overwrite properties that have been set in the config file.
-        if DATA_CUSTOMIZE in self.hass.data:
-            attr.update(self.hass.data[DATA_CUSTOMIZE].get(self.entity_id))
-
-        # Convert temperature if we detect one
+        Returns the state and the new unit, None if the state was not converted.
+        """
+        units = self.hass.config.units
+        if (
+            unit_of_measure not in (TEMP_CELSIUS, TEMP_FAHRENHEIT)
+            or unit_of_measure == units.temperature_unit
+        ):
+            return state, None
         try:
-            unit_of_measure = attr.get(ATTR_UNIT_OF_MEASUREMENT)
-            units = self.hass.config.units
-            if (
-                unit_of_measure in (TEMP_CELSIUS, TEMP_FAHRENHEIT)
-                and unit_of_measure != units.temperature_unit
-            ):
-                prec = len(state) - state.index(".") - 1 if "." in state else 0
-                temp = units.temperature(float(state), unit_of_measure)
-                state = str(round(temp) if prec == 0 else round(temp, prec))
-                attr[ATTR_UNIT_OF_MEASUREMENT] = units.temperature_unit
+            prec = len(state) - state.index(".") - 1 if "." in state else 0
+            temp = units.temperature(float(state), unit_of_measure)
         except ValueError:
             # Could not convert state to float
-            pass
-
-        if (
-            self._context_set is not None
-            and dt_util.utcnow() - self._context_set > self.context_recent_time
-        ):
-            self._context = None
-            self._context_set = None
-
-        self.hass.states.async_set(
-            self.entity_id, state, attr, self.force_update, self._context
-        )
+            return state, None
+        state = str(round(temp) if prec == 0 else round(temp, prec))
+        return state, units.temperature_unit
 
     def schedule_update_ha_state(self, force_refresh: bool = False) -> None:
         """Schedule an update ha state change task.
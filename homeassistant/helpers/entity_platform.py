@@ -2,13 +2,13 @@
 from __future__ import annotations
 
 import asyncio
-from collections.abc import Callable, Coroutine, Iterable
+from collections.abc import Awaitable, Callable, Coroutine, Iterable
 from contextvars import ContextVar
 from datetime import datetime, timedelta
 import logging
 from logging import Logger
 from types import ModuleType
-from typing import TYPE_CHECKING, Any, Protocol
+from typing import TYPE_CHECKING, Any, Optional, Protocol
 
 import voluptuous as vol
 
@@ -61,6 +61,12 @@ PLATFORM_NOT_READY_BASE_WAIT_TIME = 30  # seconds
 
 _LOGGER = logging.getLogger(__name__)
 
+# Handles an entity service call for several entities of a platform at once.
+# Returns the entities that still need the regular call, None if there are none.
+BatchServiceHandler = Callable[
+    [list["Entity"], ServiceCall], Awaitable[Optional[Iterable["Entity"]]]
+]
+
 
 class AddEntitiesCallback(Protocol):
     """Protocol type for EntityPlatform.add_entities callback."""
@@ -103,6 +109,8 @@ class EntityPlatform:
         # Method to cancel the retry of setup
         self._async_cancel_retry_setup: CALLBACK_TYPE | None = None
         self._process_updates: asyncio.Lock | None = None
+        # (service domain, service name) -> batch handler
+        self._batch_service_handlers: dict[tuple[str, str], BatchServiceHandler] = {}
 
         self.parallel_updates: asyncio.Semaphore | None = None
 
@@ -678,6 +686,32 @@ class EntityPlatform:
             self.platform_name, name, handle_service, schema
         )
 
+    @callback
+    def async_register_batch_service_handler(
+        self, name: str, handler: BatchServiceHandler, domain: str | None = None
+    ) -> None:
+        """Handle an entity service for all targeted entities of the platform at once.
+
+        The handler gets the targeted entities of this platform that are
+        available and have the required features, and the service call.
+        It can send a single command for all of them, for example a group
+        command of a bridge, and should write the new states together with
+        hass.states.async_batch. Polling entities are still updated after
+        the call.
+
+        The domain of the service defaults to the domain of the entities,
+        services registered with async_register_entity_service use the
+        platform name.
+        """
+        self._batch_service_handlers[(domain or self.domain, name)] = handler
+
+    @callback
+    def async_get_batch_service_handler(
+        self, domain: str, name: str
+    ) -> BatchServiceHandler | None:
+        """Return the batch handler of an entity service."""
+        return self._batch_service_handlers.get((domain, name))
+
     async def _update_entity_states(self, now: datetime) -> None:
         """Update the states of all the polling entities.
 
@@ -154,7 +154,12 @@ class EntityRegistry:
         self.hass = hass
         self.entities: dict[str, RegistryEntry]
         self._index: dict[tuple[str, str, str], str] = {}
-        self._store = hass.helpers.storage.Store(STORAGE_VERSION, STORAGE_KEY)
+        # device_id / area_id -> entity_ids, kept in sync with entities
+        self._device_index: dict[str, dict[str, None]] = {}
+        self._area_index: dict[str, dict[str, None]] = {}
+        self._store = hass.helpers.storage.Store(
+            STORAGE_VERSION, STORAGE_KEY, journal={"entities": "entity_id"}
+        )
         self.hass.bus.async_listen(
             EVENT_DEVICE_REGISTRY_UPDATED, self.async_device_modified
         )
@@ -191,6 +196,16 @@ class EntityRegistry:
         """Get EntityEntry for an entity_id."""
         return self.entities.get(entity_id)
 
+    @callback
+    def async_entity_ids_for_device(self, device_id: str) -> list[str]:
+        """Return the ids of the entities of a device, including disabled ones."""
+        return list(self._device_index.get(device_id, ()))
+
+    @callback
+    def async_entity_ids_for_area(self, area_id: str) -> list[str]:
+        """Return the ids of the entities that have an area set explicitly."""
+        return list(self._area_index.get(area_id, ()))
+
     @callback
     def async_get_entity_id(
         self, domain: str, platform: str, unique_id: str
@@ -574,9 +589,8 @@ class EntityRegistry:
     @callback
     def async_clear_area_id(self, area_id: str) -> None:
         """Clear area id from registry entries."""
-        for entity_id, entry in self.entities.items():
-            if area_id == entry.area_id:
-                self._async_update_entity(entity_id, area_id=None)
+        for entity_id in self.async_entity_ids_for_area(area_id):
+            self._async_update_entity(entity_id, area_id=None)
 
     def _register_entry(self, entry: RegistryEntry) -> None:
         self.entities[entry.entity_id] = entry
@@ -584,6 +598,10 @@ class EntityRegistry:
 
     def _add_index(self, entry: RegistryEntry) -> None:
         self._index[(entry.domain, entry.platform, entry.unique_id)] = entry.entity_id
+        if entry.device_id is not None:
+            _add_to_lookup(self._device_index, entry.device_id, entry.entity_id)
+        if entry.area_id is not None:
+            _add_to_lookup(self._area_index, entry.area_id, entry.entity_id)
 
     def _unregister_entry(self, entry: RegistryEntry) -> None:
         self._remove_index(entry)
@@ -591,13 +609,38 @@ class EntityRegistry:
 
     def _remove_index(self, entry: RegistryEntry) -> None:
         del self._index[(entry.domain, entry.platform, entry.unique_id)]
+        if entry.device_id is not None:
+            _remove_from_lookup(self._device_index, entry.device_id, entry.entity_id)
+        if entry.area_id is not None:
+            _remove_from_lookup(self._area_index, entry.area_id, entry.entity_id)
 
     def _rebuild_index(self) -> None:
         self._index = {}
+        self._device_index = {}
+        self._area_index = {}
         for entry in self.entities.values():
             self._add_index(entry)
 
 
+def _add_to_lookup(
+    lookup: dict[str, dict[str, None]], key: str, entity_id: str
+) -> None:
+    """Add an entity id to a lookup."""
+    if (entity_ids := lookup.get(key)) is None:
+        entity_ids = lookup[key] = {}
+    entity_ids[entity_id] = None
+
+
+def _remove_from_lookup(
+    lookup: dict[str, dict[str, None]], key: str, entity_id: str
+) -> None:
+    """Remove an entity id from a lookup."""
+    entity_ids = lookup[key]
+    del entity_ids[entity_id]
+    if not entity_ids:
+        del lookup[key]
+
+
 @callback
 def async_get(hass: HomeAssistant) -> EntityRegistry:
     """Get entity registry."""
@@ -625,11 +668,11 @@ def async_entries_for_device(
     registry: EntityRegistry, device_id: str, include_disabled_entities: bool = False
 ) -> list[RegistryEntry]:
     """Return entries that match a device."""
+    entities = registry.entities
     return [
         entry
-        for entry in registry.entities.values()
-        if entry.device_id == device_id
-        and (not entry.disabled_by or include_disabled_entities)
+        for entity_id in registry.async_entity_ids_for_device(device_id)
+        if not (entry := entities[entity_id]).disabled_by or include_disabled_entities
     ]
 
 
@@ -638,7 +681,10 @@ def async_entries_for_area(
     registry: EntityRegistry, area_id: str
 ) -> list[RegistryEntry]:
     """Return entries that match an area."""
-    return [entry for entry in registry.entities.values() if entry.area_id == area_id]
+    entities = registry.entities
+    return [
+        entities[entity_id] for entity_id in registry.async_entity_ids_for_area(area_id)
+    ]
 
 
 @callback
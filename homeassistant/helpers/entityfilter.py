@@ -1,9 +1,12 @@
 """Helper class to implement include/exclude of entities and domains."""
 from __future__ import annotations
 
-from collections.abc import Callable
+from collections.abc import Callable, Iterable
 import fnmatch
+from functools import reduce
+import operator
 import re
+from typing import Any
 
 import voluptuous as vol
 
@@ -20,20 +23,122 @@ CONF_EXCLUDE_ENTITIES = "exclude_entities"
 
 CONF_ENTITY_GLOBS = "entity_globs"
 
+# The decisions are cached until there are this many, then the cache starts over
+MAX_CACHED_DECISIONS = 8192
+
+_LIKE_ESCAPE = "\\"
+_LIKE_ESCAPE_CHARS = str.maketrans({"\\": "\\\\", "%": "\\%", "_": "\\_"})
+_GLOB_TO_LIKE_CHARS = str.maketrans({"*": "%", "?": "_"})
+
+
+class EntityFilter:
+    """Filter entity ids with include and exclude rules.
+
+    The globs of the includes and the excludes are each merged into one
+    regex and the decision for every entity id is cached. A filter never
+    changes, a new config needs a new filter.
+    """
+
+    def __init__(self, config: dict[str, list[str]]) -> None:
+        """Initialize the filter."""
+        self.config = config
+        self.empty_filter = sum(len(val) for val in config.values()) == 0
+        self._include_d = set(config[CONF_INCLUDE_DOMAINS])
+        self._include_e = set(config[CONF_INCLUDE_ENTITIES])
+        self._exclude_d = set(config[CONF_EXCLUDE_DOMAINS])
+        self._exclude_e = set(config[CONF_EXCLUDE_ENTITIES])
+        self._include_eg = set(config[CONF_INCLUDE_ENTITY_GLOBS])
+        self._exclude_eg = set(config[CONF_EXCLUDE_ENTITY_GLOBS])
+        self._filter = _generate_filter_from_sets_and_pattern(
+            self._include_d,
+            self._include_e,
+            self._exclude_d,
+            self._exclude_e,
+            _convert_globs_to_pattern(self._include_eg),
+            _convert_globs_to_pattern(self._exclude_eg),
+        )
+        self._decisions: dict[str, bool] = {}
+
+    def __call__(self, entity_id: str) -> bool:
+        """Return if an entity passes the filter."""
+        if (decision := self._decisions.get(entity_id)) is None:
+            if len(self._decisions) >= MAX_CACHED_DECISIONS:
+                self._decisions.clear()
+            decision = self._decisions[entity_id] = self._filter(entity_id)
+        return decision
+
+    @property
+    def supports_sql(self) -> bool:
+        """Return if the filter can be expressed as a SQL predicate."""
+        return all(
+            _like_compatible(value)
+            for values in (
+                self._include_d,
+                self._exclude_d,
+                self._include_eg,
+                self._exclude_eg,
+            )
+            for value in values
+        )
+
+    def sql_predicate(self, entity_id_column: Any) -> Any:
+        """Return a SQL expression matching the entity ids that pass the filter.
+
+        The expression is built with the operators of the column, which is
+        usually a SQLAlchemy column. Raises ValueError if the filter does not
+        support SQL.
+        """
+        if not self.supports_sql:
+            raise ValueError("Entity filter can not be expressed in SQL")
+
+        column = entity_id_column
+        include_e = column.in_(sorted(self._include_e)) if self._include_e else None
+        include_d = _sql_any(_like_domain(column, domain) for domain in self._include_d)
+        include_eg = _sql_any(_like_glob(column, glob) for glob in self._include_eg)
+        exclude_e = column.in_(sorted(self._exclude_e)) if self._exclude_e else None
+        exclude_d = _sql_any(_like_domain(column, domain) for domain in self._exclude_d)
+        exclude_eg = _sql_any(_like_glob(column, glob) for glob in self._exclude_eg)
+        included = _sql_any((include_e, include_d, include_eg))
+        excluded = _sql_any((exclude_e, exclude_d, exclude_eg))
+
+        # The cases are the ones of _generate_filter_from_sets_and_pattern
+        predicate: Any
+        if included is None and excluded is None:
+            predicate = True
+        elif excluded is None:
+            predicate = included
+        elif included is None:
+            predicate = ~excluded
+        elif include_d is not None or include_eg is not None:
+            not_include_d = _sql_not(include_d)
+            predicate = _sql_any(
+                (
+                    _sql_all((include_d, _sql_not(_sql_any((exclude_e, exclude_eg))))),
+                    _sql_all((not_include_d, include_eg, ~excluded)),
+                    _sql_all((not_include_d, _sql_not(include_eg), include_e)),
+                )
+            )
+        elif exclude_d is not None or exclude_eg is not None:
+            excluded_d_or_eg = _sql_any((exclude_d, exclude_eg))
+            predicate = _sql_any(
+                (
+                    _sql_all((excluded_d_or_eg, include_e)),
+                    _sql_all((~excluded_d_or_eg, _sql_not(exclude_e))),
+                )
+            )
+        else:
+            predicate = include_e
+
+        if predicate is True:
+            return column.isnot(None)
+        if predicate is None:
+            return column.is_(None)
+        return predicate
+
 
-def convert_filter(config: dict[str, list[str]]) -> Callable[[str], bool]:
+def convert_filter(config: dict[str, list[str]]) -> EntityFilter:
     """Convert the filter schema into a filter."""
-    filt = generate_filter(
-        config[CONF_INCLUDE_DOMAINS],
-        config[CONF_INCLUDE_ENTITIES],
-        config[CONF_EXCLUDE_DOMAINS],
-        config[CONF_EXCLUDE_ENTITIES],
-        config[CONF_INCLUDE_ENTITY_GLOBS],
-        config[CONF_EXCLUDE_ENTITY_GLOBS],
-    )
-    setattr(filt, "config", config)
-    setattr(filt, "empty_filter", sum(len(val) for val in config.values()) == 0)
-    return filt
+    return EntityFilter(config)
 
 
 BASE_FILTER_SCHEMA = vol.Schema(
@@ -60,7 +165,7 @@ FILTER_SCHEMA = vol.All(BASE_FILTER_SCHEMA, convert_filter)
 
 def convert_include_exclude_filter(
     config: dict[str, dict[str, list[str]]]
-) -> Callable[[str], bool]:
+) -> EntityFilter:
     """Convert the include exclude filter schema into a filter."""
     include = config[CONF_INCLUDE]
     exclude = config[CONF_EXCLUDE]
@@ -74,7 +179,7 @@ def convert_include_exclude_filter(
             CONF_EXCLUDE_ENTITIES: exclude[CONF_ENTITIES],
         }
     )
-    setattr(filt, "config", config)
+    filt.config = config  # type: ignore[assignment]
     return filt
 
 
@@ -104,18 +209,55 @@ INCLUDE_EXCLUDE_FILTER_SCHEMA = vol.All(
 )
 
 
-def _glob_to_re(glob: str) -> re.Pattern[str]:
-    """Translate and compile glob string into pattern."""
-    return re.compile(fnmatch.translate(glob))
+def _convert_globs_to_pattern(globs: Iterable[str]) -> re.Pattern[str] | None:
+    """Translate and compile glob strings into a single pattern."""
+    if not globs:
+        return None
+    return re.compile("|".join(fnmatch.translate(glob) for glob in sorted(globs)))
+
+
+def _like_compatible(value: str) -> bool:
+    """Return if a domain or glob matches the same entity ids with LIKE."""
+    # LIKE has no character classes and is case insensitive in SQLite and MySQL
+    return "[" not in value and value == value.lower()
+
+
+def _like_domain(column: Any, domain: str) -> Any:
+    """Return a SQL expression matching the entity ids of a domain."""
+    return column.like(f"{domain.translate(_LIKE_ESCAPE_CHARS)}.%", escape=_LIKE_ESCAPE)
 
 
-def _test_against_patterns(patterns: list[re.Pattern[str]], entity_id: str) -> bool:
-    """Test entity against list of patterns, true if any match."""
-    for pattern in patterns:
-        if pattern.match(entity_id):
-            return True
+def _like_glob(column: Any, glob: str) -> Any:
+    """Return a SQL expression matching the entity ids of a glob."""
+    pattern = glob.translate(_LIKE_ESCAPE_CHARS).translate(_GLOB_TO_LIKE_CHARS)
+    return column.like(pattern, escape=_LIKE_ESCAPE)
 
-    return False
+
+# While building a SQL predicate None stands for false and True for true
+
+
+def _sql_any(terms: Iterable[Any]) -> Any:
+    """Return the OR of SQL expressions."""
+    terms = [term for term in terms if term is not None]
+    if any(term is True for term in terms):
+        return True
+    return reduce(operator.or_, terms) if terms else None
+
+
+def _sql_all(terms: Iterable[Any]) -> Any:
+    """Return the AND of SQL expressions."""
+    terms = list(terms)
+    if any(term is None for term in terms):
+        return None
+    terms = [term for term in terms if term is not True]
+    return reduce(operator.and_, terms) if terms else True
+
+
+def _sql_not(term: Any) -> Any:
+    """Return the negation of a SQL expression."""
+    if term is None or term is True:
+        return term is None
+    return ~term
 
 
 # It's safe since we don't modify it. And None causes typing warnings
@@ -127,17 +269,29 @@ def generate_filter(
     exclude_entities: list[str],
     include_entity_globs: list[str] = [],
     exclude_entity_globs: list[str] = [],
+) -> EntityFilter:
+    """Return a filter that will filter entities based on the args."""
+    return EntityFilter(
+        {
+            CONF_INCLUDE_DOMAINS: include_domains,
+            CONF_INCLUDE_ENTITIES: include_entities,
+            CONF_EXCLUDE_DOMAINS: exclude_domains,
+            CONF_EXCLUDE_ENTITIES: exclude_entities,
+            CONF_INCLUDE_ENTITY_GLOBS: include_entity_globs,
+            CONF_EXCLUDE_ENTITY_GLOBS: exclude_entity_globs,
+        }
+    )
+
+
+def _generate_filter_from_sets_and_pattern(
+    include_d: set[str],
+    include_e: set[str],
+    exclude_d: set[str],
+    exclude_e: set[str],
+    include_eg: re.Pattern[str] | None,
+    exclude_eg: re.Pattern[str] | None,
 ) -> Callable[[str], bool]:
     """Return a function that will filter entities based on the args."""
-    include_d = set(include_domains)
-    include_e = set(include_entities)
-    exclude_d = set(exclude_domains)
-    exclude_e = set(exclude_entities)
-    include_eg_set = set(include_entity_globs)
-    exclude_eg_set = set(exclude_entity_globs)
-    include_eg = list(map(_glob_to_re, include_eg_set))
-    exclude_eg = list(map(_glob_to_re, exclude_eg_set))
-
     have_exclude = bool(exclude_e or exclude_d or exclude_eg)
     have_include = bool(include_e or include_d or include_eg)
 
@@ -146,7 +300,7 @@ def generate_filter(
         return (
             entity_id in include_e
             or domain in include_d
-            or bool(include_eg and _test_against_patterns(include_eg, entity_id))
+            or bool(include_eg and include_eg.match(entity_id))
         )
 
     def entity_excluded(domain: str, entity_id: str) -> bool:
@@ -154,7 +308,7 @@ def generate_filter(
         return (
             entity_id in exclude_e
             or domain in exclude_d
-            or bool(exclude_eg and _test_against_patterns(exclude_eg, entity_id))
+            or bool(exclude_eg and exclude_eg.match(entity_id))
         )
 
     # Case 1 - no includes or excludes - pass all entities
@@ -196,11 +350,9 @@ def generate_filter(
             if domain in include_d:
                 return not (
                     entity_id in exclude_e
-                    or bool(
-                        exclude_eg and _test_against_patterns(exclude_eg, entity_id)
-                    )
+                    or bool(exclude_eg and exclude_eg.match(entity_id))
                 )
-            if _test_against_patterns(include_eg, entity_id):
+            if include_eg and include_eg.match(entity_id):
                 return not entity_excluded(domain, entity_id)
             return entity_id in include_e
 
@@ -218,9 +370,7 @@ def generate_filter(
         def entity_filter_4b(entity_id: str) -> bool:
             """Return filter function for case 4b."""
             domain = split_entity_id(entity_id)[0]
-            if domain in exclude_d or (
-                exclude_eg and _test_against_patterns(exclude_eg, entity_id)
-            ):
+            if domain in exclude_d or (exclude_eg and exclude_eg.match(entity_id)):
                 return entity_id in include_e
             return entity_id not in exclude_e
 
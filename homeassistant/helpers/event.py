@@ -1,24 +1,20 @@
 """Helpers for listening to events."""
 from __future__ import annotations
 
-import asyncio
 from collections.abc import Awaitable, Iterable
 import copy
 from dataclasses import dataclass
 from datetime import datetime, timedelta
 import functools as ft
 import logging
-import time
 from typing import Any, Callable, List, cast
 
 import attr
 
 from homeassistant.const import (
     ATTR_ENTITY_ID,
-    ATTR_NOW,
     EVENT_CORE_CONFIG_UPDATE,
     EVENT_STATE_CHANGED,
-    EVENT_TIME_CHANGED,
     MATCH_ALL,
     SUN_EVENT_SUNRISE,
     SUN_EVENT_SUNSET,
@@ -41,9 +37,9 @@ from homeassistant.helpers.typing import TemplateVarsType
 from homeassistant.loader import bind_hass
 from homeassistant.util import dt as dt_util
 from homeassistant.util.async_ import run_callback_threadsafe
+from homeassistant.util.timer_wheel import TimerWheel
 
 TRACK_STATE_CHANGE_CALLBACKS = "track_state_change_callbacks"
-TRACK_STATE_CHANGE_LISTENER = "track_state_change_listener"
 
 TRACK_STATE_ADDED_DOMAIN_CALLBACKS = "track_state_added_domain_callbacks"
 TRACK_STATE_ADDED_DOMAIN_LISTENER = "track_state_added_domain_listener"
@@ -54,6 +50,8 @@ TRACK_STATE_REMOVED_DOMAIN_LISTENER = "track_state_removed_domain_listener"
 TRACK_ENTITY_REGISTRY_UPDATED_CALLBACKS = "track_entity_registry_updated_callbacks"
 TRACK_ENTITY_REGISTRY_UPDATED_LISTENER = "track_entity_registry_updated_listener"
 
+DATA_TIMER_WHEEL = "event_timer_wheel"
+
 _ALL_LISTENER = "all"
 _DOMAINS_LISTENER = "domains"
 _ENTITIES_LISTENER = "entities"
@@ -240,61 +238,21 @@ def async_track_state_change_event(
 
     In order to avoid having to iterate a long list
     of EVENT_STATE_CHANGED and fire and create a job
-    for each one, we keep a dict of entity ids that
-    care about the state change events so we can
-    do a fast dict lookup to route events.
+    for each one, the listener is registered in the
+    event bus index keyed by entity_id so the bus
+    can do a fast dict lookup to route events.
     """
     if not (entity_ids := _async_string_to_lower_list(entity_ids)):
         return _remove_empty_listener
 
-    entity_callbacks = hass.data.setdefault(TRACK_STATE_CHANGE_CALLBACKS, {})
-
-    if TRACK_STATE_CHANGE_LISTENER not in hass.data:
-
-        @callback
-        def _async_state_change_filter(event: Event) -> bool:
-            """Filter state changes by entity_id."""
-            return event.data.get("entity_id") in entity_callbacks
-
-        @callback
-        def _async_state_change_dispatcher(event: Event) -> None:
-            """Dispatch state changes by entity_id."""
-            entity_id = event.data.get("entity_id")
-
-            if entity_id not in entity_callbacks:
-                return
-
-            for job in entity_callbacks[entity_id][:]:
-                try:
-                    hass.async_run_hass_job(job, event)
-                except Exception:  # pylint: disable=broad-except
-                    _LOGGER.exception(
-                        "Error while processing state change for %s", entity_id
-                    )
-
-        hass.data[TRACK_STATE_CHANGE_LISTENER] = hass.bus.async_listen(
-            EVENT_STATE_CHANGED,
-            _async_state_change_dispatcher,
-            event_filter=_async_state_change_filter,
+    if TRACK_STATE_CHANGE_CALLBACKS not in hass.data:
+        hass.data[TRACK_STATE_CHANGE_CALLBACKS] = hass.bus.async_keyed_listeners(
+            EVENT_STATE_CHANGED, ATTR_ENTITY_ID
         )
 
-    job = HassJob(action)
-
-    for entity_id in entity_ids:
-        entity_callbacks.setdefault(entity_id, []).append(job)
-
-    @callback
-    def remove_listener() -> None:
-        """Remove state change listener."""
-        _async_remove_indexed_listeners(
-            hass,
-            TRACK_STATE_CHANGE_CALLBACKS,
-            TRACK_STATE_CHANGE_LISTENER,
-            entity_ids,
-            job,
-        )
-
-    return remove_listener
+    return hass.bus.async_listen_keyed(
+        EVENT_STATE_CHANGED, ATTR_ENTITY_ID, entity_ids, action
+    )
 
 
 @callback
@@ -1165,39 +1123,39 @@ def async_track_point_in_utc_time(
 
     # Since this is called once, we accept a HassJob so we can avoid
     # having to figure out how to call the action every time its called.
-    cancel_callback: asyncio.TimerHandle | None = None
-
-    @callback
-    def run_action(job: HassJob) -> None:
-        """Call the action."""
-        nonlocal cancel_callback
+    job = action if isinstance(action, HassJob) else HassJob(action)
 
-        now = time_tracker_utcnow()
+    # The wheel checks utcnow() before running a timer, so a timer that
+    # would fire a little too early as measured by utcnow() is rearmed
+    # for the remaining time.
+    timer = _async_get_timer_wheel(hass).async_schedule(
+        utc_point_in_time.timestamp(),
+        hass.async_run_hass_job,
+        job,
+        utc_point_in_time,
+    )
 
-        # Depending on the available clock support (including timer hardware
-        # and the OS kernel) it can happen that we fire a little bit too early
-        # as measured by utcnow(). That is bad when callbacks have assumptions
-        # about the current time. Thus, we rearm the timer for the remaining
-        # time.
-        if (delta := (utc_point_in_time - now).total_seconds()) > 0:
-            _LOGGER.debug("Called %f seconds too early, rearming", delta)
+    @callback
+    def unsub_point_in_time_listener() -> None:
+        """Cancel the timer."""
+        timer.cancel()
 
-            cancel_callback = hass.loop.call_later(delta, run_action, job)
-            return
+    return unsub_point_in_time_listener
 
-        hass.async_run_hass_job(job, utc_point_in_time)
 
-    job = action if isinstance(action, HassJob) else HassJob(action)
-    delta = utc_point_in_time.timestamp() - time.time()
-    cancel_callback = hass.loop.call_later(delta, run_action, job)
+@callback
+def _async_get_timer_wheel(hass: HomeAssistant) -> TimerWheel:
+    """Return the timer wheel that runs the time listeners of hass."""
+    if (wheel := hass.data.get(DATA_TIMER_WHEEL)) is None:
+        wheel = hass.data[DATA_TIMER_WHEEL] = TimerWheel(
+            hass.loop, _time_tracker_timestamp
+        )
+    return cast(TimerWheel, wheel)
 
-    @callback
-    def unsub_point_in_time_listener() -> None:
-        """Cancel the call_later."""
-        assert cancel_callback is not None
-        cancel_callback.cancel()
 
-    return unsub_point_in_time_listener
+def _time_tracker_timestamp() -> float:
+    """Return the timestamp the timer wheel runs timers by."""
+    return time_tracker_utcnow().timestamp()
 
 
 track_point_in_utc_time = threaded_listener_factory(async_track_point_in_utc_time)
@@ -1363,17 +1321,9 @@ def async_track_utc_time_change(
 ) -> CALLBACK_TYPE:
     """Add a listener that will fire if time matches a pattern."""
     job = HassJob(action)
-    # We do not have to wrap the function with time pattern matching logic
-    # if no pattern given
-    if all(val is None for val in (hour, minute, second)):
-
-        @callback
-        def time_change_listener(event: Event) -> None:
-            """Fire every time event that comes in."""
-            hass.async_run_hass_job(job, event.data[ATTR_NOW])
-
-        return hass.bus.async_listen(EVENT_TIME_CHANGED, time_change_listener)
-
+    # Without a pattern the listener runs at every second. It is scheduled
+    # on the timer wheel like any other pattern so it does not depend on
+    # EVENT_TIME_CHANGED being fired.
     matching_seconds = dt_util.parse_time_expression(second, 0, 59)
     matching_minutes = dt_util.parse_time_expression(minute, 0, 59)
     matching_hours = dt_util.parse_time_expression(hour, 0, 23)
@@ -1496,13 +1446,14 @@ def _event_triggers_rerender(event: Event, info: RenderInfo) -> bool:
     """Determine if a template should be re-rendered from an event."""
     entity_id = cast(str, event.data.get(ATTR_ENTITY_ID))
 
+    old_state = event.data.get("old_state")
+    new_state = event.data.get("new_state")
+
     if info.filter(entity_id):
-        return True
+        # Skip changes to parts of the state that the template did not read
+        return info.state_change_affects_render(entity_id, old_state, new_state)
 
-    if (
-        event.data.get("new_state") is not None
-        and event.data.get("old_state") is not None
-    ):
+    if new_state is not None and old_state is not None:
         return False
 
     return bool(info.filter_lifecycle(entity_id))
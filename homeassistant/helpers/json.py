@@ -1,8 +1,41 @@
 """Helpers to help with encoding Home Assistant objects in JSON."""
+from __future__ import annotations
+
+from collections.abc import Callable
 from datetime import datetime, timedelta
 import json
 from typing import Any
 
+# Converters for the types that are not JSON serializable themselves,
+# looked up by exact type before falling back to isinstance checks.
+# Types with an as_dict method, like State and Event, are added on first use.
+_TYPE_ENCODERS: dict[type, Callable[[Any], Any]] = {
+    datetime: datetime.isoformat,
+    set: list,
+}
+
+COMPACT_SEPARATORS = (",", ":")
+
+
+def json_encoder_default(obj: Any) -> Any:
+    """Convert Home Assistant objects.
+
+    Raise TypeError for objects that can not be converted.
+    """
+    if (encode := _TYPE_ENCODERS.get(type(obj))) is not None:
+        return encode(obj)
+    if isinstance(obj, datetime):
+        return obj.isoformat()
+    if isinstance(obj, set):
+        return list(obj)
+    obj_type = type(obj)
+    if callable(as_dict := getattr(obj_type, "as_dict", None)):
+        _TYPE_ENCODERS[obj_type] = as_dict
+        return as_dict(obj)
+    if hasattr(obj, "as_dict"):
+        return obj.as_dict()
+    raise TypeError(f"Object of type {type(obj).__name__} is not JSON serializable")
+
 
 class JSONEncoder(json.JSONEncoder):
     """JSONEncoder that supports Home Assistant objects."""
@@ -12,14 +45,10 @@ class JSONEncoder(json.JSONEncoder):
 
         Hand other objects to the original method.
         """
-        if isinstance(o, datetime):
-            return o.isoformat()
-        if isinstance(o, set):
-            return list(o)
-        if hasattr(o, "as_dict"):
-            return o.as_dict()
-
-        return json.JSONEncoder.default(self, o)
+        try:
+            return json_encoder_default(o)
+        except TypeError:
+            return json.JSONEncoder.default(self, o)
 
 
 class ExtendedJSONEncoder(JSONEncoder):
@@ -36,3 +65,87 @@ class ExtendedJSONEncoder(JSONEncoder):
             return super().default(o)
         except TypeError:
             return {"__type": str(type(o)), "repr": repr(o)}
+
+
+class JSONBackend:
+    """Serialize and parse JSON with the standard library.
+
+    A faster implementation can be plugged in with set_json_backend.
+    It has to produce the same JSON for the same arguments, convert
+    unsupported objects with json_encoder_default unless strict is set,
+    raise TypeError or ValueError for data it can not serialize and
+    ValueError for invalid JSON.
+    """
+
+    name = "json"
+
+    def __init__(self) -> None:
+        """Initialize the backend."""
+        self._encoders: dict[
+            tuple[bool, int | None, bool, bool], json.JSONEncoder
+        ] = {}
+
+    def dumps(
+        self,
+        obj: Any,
+        *,
+        allow_nan: bool = True,
+        indent: int | None = None,
+        compact: bool = False,
+        strict: bool = False,
+    ) -> str:
+        """Serialize an object to JSON.
+
+        With strict only the types of the json module are serialized.
+        """
+        key = (allow_nan, indent, compact, strict)
+        if (encoder := self._encoders.get(key)) is None:
+            # Encoders hold no state while encoding so they are reused
+            # instead of creating one per call like json.dumps does
+            encoder = self._encoders[key] = json.JSONEncoder(
+                allow_nan=allow_nan,
+                indent=indent,
+                separators=COMPACT_SEPARATORS if compact else None,
+                default=None if strict else json_encoder_default,
+            )
+        return encoder.encode(obj)
+
+    def loads(self, data: str | bytes) -> Any:
+        """Parse JSON."""
+        return json.loads(data)
+
+
+_BACKEND = JSONBackend()
+
+
+def set_json_backend(backend: JSONBackend) -> None:
+    """Replace the backend used by json_dumps and json_loads."""
+    global _BACKEND  # pylint: disable=global-statement
+    _BACKEND = backend
+
+
+def get_json_backend() -> JSONBackend:
+    """Return the backend used by json_dumps and json_loads."""
+    return _BACKEND
+
+
+def json_dumps(
+    obj: Any,
+    *,
+    allow_nan: bool = True,
+    indent: int | None = None,
+    compact: bool = False,
+    strict: bool = False,
+) -> str:
+    """Serialize an object with Home Assistant objects to JSON.
+
+    With strict only the types of the json module are serialized.
+    """
+    return _BACKEND.dumps(
+        obj, allow_nan=allow_nan, indent=indent, compact=compact, strict=strict
+    )
+
+
+def json_loads(data: str | bytes) -> Any:
+    """Parse JSON."""
+    return _BACKEND.loads(data)
@@ -22,7 +22,7 @@ DATA_RESTORE_STATE_TASK = "restore_state_task"
 _LOGGER = logging.getLogger(__name__)
 
 STORAGE_KEY = "core.restore_state"
-STORAGE_VERSION = 1
+STORAGE_VERSION = 2
 
 # How long between periodically saving the current states to disk
 STATE_DUMP_INTERVAL = timedelta(minutes=15)
@@ -30,28 +30,91 @@ STATE_DUMP_INTERVAL = timedelta(minutes=15)
 # How long should a saved state be preserved if the entity no longer exists
 STATE_EXPIRATION = timedelta(days=7)
 
+# How long the last seen time of an unchanged state is kept when dumping
+STATE_LAST_SEEN_REFRESH_INTERVAL = timedelta(days=1)
+
 
 class StoredState:
-    """Object to represent a stored state."""
+    """Object to represent a stored state.
+
+    Stored states loaded from storage keep their JSON and are only decoded
+    when the state or last seen time is used.
+    """
+
+    __slots__ = ("_state", "_last_seen", "_json_dict")
 
-    def __init__(self, state: State, last_seen: datetime) -> None:
+    def __init__(
+        self,
+        state: State | None,
+        last_seen: datetime | None,
+        json_dict: dict | None = None,
+    ) -> None:
         """Initialize a new stored state."""
-        self.state = state
-        self.last_seen = last_seen
+        self._state = state
+        self._last_seen = last_seen
+        self._json_dict = json_dict
+
+    @property
+    def state(self) -> State:
+        """Return the stored state."""
+        if self._state is None and self._json_dict is not None:
+            self._state = State.from_dict(self._json_dict["state"])
+        return cast(State, self._state)
+
+    @property
+    def last_seen(self) -> datetime:
+        """Return when the state was last seen."""
+        if self._last_seen is None and self._json_dict is not None:
+            last_seen = self._json_dict["last_seen"]
+            if isinstance(last_seen, str):
+                last_seen = dt_util.parse_datetime(last_seen)
+            self._last_seen = last_seen
+        return cast(datetime, self._last_seen)
 
     def as_dict(self) -> dict[str, Any]:
         """Return a dict representation of the stored state."""
-        return {"state": self.state.as_dict(), "last_seen": self.last_seen}
+        if self._json_dict is not None:
+            # Stored again as it was loaded
+            return self._json_dict
+        return {
+            "entity_id": self.state.entity_id,
+            "state": self.state.as_dict(),
+            "last_seen": self.last_seen,
+        }
 
     @classmethod
     def from_dict(cls, json_dict: dict) -> StoredState:
-        """Initialize a stored state from a dict."""
-        last_seen = json_dict["last_seen"]
+        """Initialize a stored state from a dict without decoding it."""
+        return cls(None, None, json_dict)
+
+
+class RestoreStateStore(Store):
+    """Store the stored states.
 
-        if isinstance(last_seen, str):
-            last_seen = dt_util.parse_datetime(last_seen)
+    The states are journaled by entity_id, so a dump only writes the states
+    that changed since the last dump.
+    """
 
-        return cls(State.from_dict(json_dict["state"]), last_seen)
+    def __init__(self, hass: HomeAssistant) -> None:
+        """Initialize the store."""
+        super().__init__(
+            hass,
+            STORAGE_VERSION,
+            STORAGE_KEY,
+            encoder=JSONEncoder,
+            journal={"states": "entity_id"},
+        )
+
+    async def _async_migrate_func(self, old_version, old_data):
+        """Migrate to the new version.
+
+        Version 1 stored a list of states without their entity_id.
+        """
+        return {
+            "states": [
+                {"entity_id": item["state"]["entity_id"], **item} for item in old_data
+            ]
+        }
 
 
 class RestoreStateData:
@@ -75,7 +138,7 @@ class RestoreStateData:
         else:
             data.last_states = {
                 item["state"]["entity_id"]: StoredState.from_dict(item)
-                for item in stored_states
+                for item in stored_states["states"]
                 if valid_entity_id(item["state"]["entity_id"])
             }
             _LOGGER.debug("Created cache with %s", list(data.last_states))
@@ -97,11 +160,11 @@ class RestoreStateData:
     def __init__(self, hass: HomeAssistant) -> None:
         """Initialize the restore state data class."""
         self.hass: HomeAssistant = hass
-        self.store: Store = Store(
-            hass, STORAGE_VERSION, STORAGE_KEY, encoder=JSONEncoder
-        )
+        self.store: Store = RestoreStateStore(hass)
         self.last_states: dict[str, StoredState] = {}
         self.entity_ids: set[str] = set()
+        # The state and the entry written for it by the last dump
+        self._last_dump_entries: dict[str, tuple[State, dict[str, Any]]] = {}
 
     @callback
     def async_get_stored_states(self) -> list[StoredState]:
@@ -112,6 +175,14 @@ class RestoreStateData:
         entities on this run, and have not expired.
         """
         now = dt_util.utcnow()
+        return [
+            source if isinstance(source, StoredState) else StoredState(source, now)
+            for source in self._async_get_dump_sources(now).values()
+        ]
+
+    @callback
+    def _async_get_dump_sources(self, now: datetime) -> dict[str, State | StoredState]:
+        """Return the current states and old stored states to store."""
         all_states = self.hass.states.async_all()
         # Entities currently backed by an entity object
         current_entity_ids = {
@@ -121,13 +192,13 @@ class RestoreStateData:
         }
 
         # Start with the currently registered states
-        stored_states = [
-            StoredState(state, now)
+        sources: dict[str, State | StoredState] = {
+            state.entity_id: state
             for state in all_states
             if state.entity_id in self.entity_ids and
             # Ignore all states that are entity registry placeholders
             not state.attributes.get(entity_registry.ATTR_RESTORED)
-        ]
+        }
         expiration_time = now - STATE_EXPIRATION
 
         for entity_id, stored_state in self.last_states.items():
@@ -141,22 +212,48 @@ class RestoreStateData:
             if stored_state.last_seen < expiration_time:
                 continue
 
-            stored_states.append(stored_state)
+            sources[entity_id] = stored_state
 
-        return stored_states
+        return sources
 
     async def async_dump_states(self) -> None:
-        """Save the current state machine to storage."""
+        """Save the current state machine to storage.
+
+        The entry of a state that is the same object as in the last dump is
+        saved again as it was, so the store only writes the changed states.
+        Its last seen time is refreshed once it is a day old.
+        """
         _LOGGER.debug("Dumping states")
+        now = dt_util.utcnow()
+        refresh_time = now - STATE_LAST_SEEN_REFRESH_INTERVAL
+        entries: list[dict[str, Any]] = []
+        dump_entries: dict[str, tuple[State, dict[str, Any]]] = {}
+        for entity_id, source in self._async_get_dump_sources(now).items():
+            if isinstance(source, StoredState):
+                entries.append(source.as_dict())
+                continue
+            last_dump = self._last_dump_entries.get(entity_id)
+            if (
+                last_dump is None
+                or last_dump[0] is not source
+                or last_dump[1]["last_seen"] <= refresh_time
+            ):
+                entry = {
+                    "entity_id": entity_id,
+                    "state": source.as_dict(),
+                    "last_seen": now,
+                }
+                last_dump = (source, entry)
+            entries.append(last_dump[1])
+            dump_entries[entity_id] = last_dump
+
         try:
-            await self.store.async_save(
-                [
-                    stored_state.as_dict()
-                    for stored_state in self.async_get_stored_states()
-                ]
-            )
+            await self.store.async_save({"states": entries})
         except HomeAssistantError as exc:
             _LOGGER.error("Error saving current states", exc_info=exc)
+            return
+
+        self._last_dump_entries = dump_entries
 
     @callback
     def async_setup_dump(self, *args: Any) -> None:
@@ -50,7 +50,10 @@ from homeassistant.util.yaml.loader import JSON_TYPE
 
 if TYPE_CHECKING:
     from homeassistant.helpers.entity import Entity
-    from homeassistant.helpers.entity_platform import EntityPlatform
+    from homeassistant.helpers.entity_platform import (
+        BatchServiceHandler,
+        EntityPlatform,
+    )
 
 
 CONF_SERVICE_ENTITY_ID = "entity_id"
@@ -60,6 +63,9 @@ _LOGGER = logging.getLogger(__name__)
 
 SERVICE_DESCRIPTION_CACHE = "service_description_cache"
 
+# Entities called at the same time by an entity service call
+MAX_PARALLEL_ENTITY_CALLS = 32
+
 
 class ServiceParams(TypedDict):
     """Type for service call parameters."""
@@ -355,26 +361,28 @@ async def async_extract_referenced_entity_ids(
 
     # Find devices for this area
     selected.referenced_devices.update(selector.device_ids)
-    for device_entry in dev_reg.devices.values():
-        if device_entry.area_id in selector.area_ids:
-            selected.referenced_devices.add(device_entry.id)
+    for area_id in selector.area_ids:
+        selected.referenced_devices.update(dev_reg.async_device_ids_for_area(area_id))
 
     if not selector.area_ids and not selected.referenced_devices:
         return selected
 
-    for ent_entry in ent_reg.entities.values():
-        if (
-            # when area matches the target area
-            ent_entry.area_id in selector.area_ids
-            # when device matches a referenced devices with no explicitly set area
-            or (
-                not ent_entry.area_id
-                and ent_entry.device_id in selected.referenced_devices
-            )
-            # when device matches target device
-            or ent_entry.device_id in selector.device_ids
-        ):
-            selected.indirectly_referenced.add(ent_entry.entity_id)
+    # Entities with the target area
+    for area_id in selector.area_ids:
+        selected.indirectly_referenced.update(
+            ent_reg.async_entity_ids_for_area(area_id)
+        )
+
+    entities = ent_reg.entities
+    for device_id in selected.referenced_devices:
+        for entity_id in ent_reg.async_entity_ids_for_device(device_id):
+            if (
+                # when device matches target device
+                device_id in selector.device_ids
+                # when device matches a referenced devices with no explicitly set area
+                or not entities[entity_id].area_id
+            ):
+                selected.indirectly_referenced.add(entity_id)
 
     return selected
 
@@ -526,7 +534,9 @@ async def entity_service_call(
 ) -> None:
     """Handle an entity service call.
 
-    Calls all platforms simultaneously.
+    Calls all platforms simultaneously. Platforms with a batch handler for
+    the service get all their entities in one call, the other entities are
+    called one by one with a limited number at the same time.
     """
     if call.context.user_id:
         user = await hass.auth.async_get_user(call.context.user_id)
@@ -643,36 +653,107 @@ async def entity_service_call(
     if not entities:
         return
 
-    done, pending = await asyncio.wait(
-        [
-            asyncio.create_task(
-                entity.async_request_call(
-                    _handle_entity_call(hass, entity, func, data, call.context)
-                )
+    single_entities: list[Entity] = []
+    platform_entities: dict[EntityPlatform, list[Entity]] = {}
+    for entity in entities:
+        if entity.platform is None:
+            single_entities.append(entity)
+        else:
+            platform_entities.setdefault(entity.platform, []).append(entity)
+
+    batch_calls = []
+    for platform, batch in platform_entities.items():
+        handler = platform.async_get_batch_service_handler(call.domain, call.service)
+        if handler is None:
+            single_entities.extend(batch)
+        else:
+            batch_calls.append(
+                _handle_batch_call(hass, handler, batch, func, data, call)
             )
-            for entity in entities
-        ]
-    )
-    assert not pending
-    for future in done:
-        future.result()  # pop exception if have
 
-    tasks = []
+    _raise_first_exception(
+        await asyncio.gather(
+            *batch_calls,
+            _handle_entity_calls(hass, single_entities, func, data, call.context),
+            return_exceptions=True,
+        )
+    )
 
-    for entity in entities:
-        if not entity.should_poll:
-            continue
+    polling_entities = [entity for entity in entities if entity.should_poll]
+    if not polling_entities:
+        return
 
+    for entity in polling_entities:
         # Context expires if the turn on commands took a long time.
         # Set context again so it's there when we update
         entity.async_set_context(call.context)
-        tasks.append(asyncio.create_task(entity.async_update_ha_state(True)))
 
-    if tasks:
-        done, pending = await asyncio.wait(tasks)
-        assert not pending
-        for future in done:
-            future.result()  # pop exception if have
+    results = await gather_with_concurrency(
+        MAX_PARALLEL_ENTITY_CALLS,
+        *(entity.async_device_update() for entity in polling_entities),
+        return_exceptions=True,
+    )
+
+    # Write the updated states together so the state_changed events
+    # are fired as one batch
+    with hass.states.async_batch():
+        for entity, result in zip(polling_entities, results):
+            if isinstance(result, Exception):
+                _LOGGER.error(
+                    "Update for %s fails", entity.entity_id, exc_info=result
+                )
+                continue
+            if isinstance(result, BaseException):
+                raise result
+            entity.async_write_ha_state()
+
+
+async def _handle_batch_call(
+    hass: HomeAssistant,
+    handler: BatchServiceHandler,
+    entities: list[Entity],
+    func: str | Callable[..., Any],
+    data: dict | ServiceCall,
+    call: ServiceCall,
+) -> None:
+    """Call the batch handler of a platform and the entities it left."""
+    for entity in entities:
+        entity.async_set_context(call.context)
+
+    if unhandled := await handler(entities, call):
+        await _handle_entity_calls(hass, list(unhandled), func, data, call.context)
+
+
+async def _handle_entity_calls(
+    hass: HomeAssistant,
+    entities: list[Entity],
+    func: str | Callable[..., Any],
+    data: dict | ServiceCall,
+    context: Context,
+) -> None:
+    """Call the service method of entities one by one."""
+    if not entities:
+        return
+
+    _raise_first_exception(
+        await gather_with_concurrency(
+            MAX_PARALLEL_ENTITY_CALLS,
+            *(
+                entity.async_request_call(
+                    _handle_entity_call(hass, entity, func, data, context)
+                )
+                for entity in entities
+            ),
+            return_exceptions=True,
+        )
+    )
+
+
+def _raise_first_exception(results: list[Any]) -> None:
+    """Raise the first exception of gathered results once all are done."""
+    for result in results:
+        if isinstance(result, BaseException):
+            raise result
 
 
 async def _handle_entity_call(
@@ -4,6 +4,9 @@ from __future__ import annotations
 import asyncio
 from collections.abc import Callable
 from contextlib import suppress
+from copy import Error as CopyError, deepcopy
+from functools import partial
+import json
 from json import JSONEncoder
 import logging
 import os
@@ -12,6 +15,7 @@ from typing import Any
 from homeassistant.const import EVENT_HOMEASSISTANT_FINAL_WRITE
 from homeassistant.core import CALLBACK_TYPE, CoreState, Event, HomeAssistant, callback
 from homeassistant.helpers.event import async_call_later
+from homeassistant.helpers.json import json_dumps
 from homeassistant.loader import MAX_LOAD_CONCURRENTLY, bind_hass
 from homeassistant.util import json as json_util
 
@@ -22,6 +26,16 @@ STORAGE_DIR = ".storage"
 _LOGGER = logging.getLogger(__name__)
 
 STORAGE_SEMAPHORE = "storage_semaphore"
+STORAGE_WRITER = "storage_writer"
+
+# Seconds a delayed write is brought forward to share the write of another store
+DEFAULT_FLUSH_WINDOW = 1.0
+# Journal records after which the document is written again in full
+JOURNAL_MAX_RECORDS = 100
+
+# Stores without a custom encoder use the shared JSON backend, like the
+# json module it raises for types that are not JSON serializable
+_STORE_DUMP = partial(json_dumps, indent=4, strict=True)
 
 
 @bind_hass
@@ -66,6 +80,21 @@ async def async_migrator(
     return config
 
 
+@callback
+def async_enable_write_batching(
+    hass: HomeAssistant, flush_window: float = DEFAULT_FLUSH_WINDOW
+) -> None:
+    """Write the data of all stores in batches.
+
+    Delayed writes are written when they are due, in a single executor job
+    with the delayed writes of other stores that come due within the flush
+    window. Other writes take the pending data of all stores along. Stores
+    created with a journal append the entries that changed instead of
+    writing the whole document.
+    """
+    hass.data[STORAGE_WRITER] = _StoreWriter(hass, flush_window)
+
+
 @bind_hass
 class Store:
     """Class to help storing data."""
@@ -78,8 +107,13 @@ class Store:
         private: bool = False,
         *,
         encoder: type[JSONEncoder] | None = None,
+        journal: dict[str, str] | None = None,
     ) -> None:
-        """Initialize storage class."""
+        """Initialize storage class.
+
+        journal maps the lists in the data that can be journaled to the key
+        that identifies their entries. It is only used with write batching.
+        """
         self.version = version
         self.key = key
         self.hass = hass
@@ -90,6 +124,7 @@ class Store:
         self._write_lock = asyncio.Lock()
         self._load_task: asyncio.Future | None = None
         self._encoder = encoder
+        self._journal = None if journal is None else _StoreJournal(self, journal)
 
     @property
     def path(self):
@@ -130,6 +165,10 @@ class Store:
             # If we didn't generate data yet, do it now.
             if "data_func" in data:
                 data["data"] = data.pop("data_func")()
+        elif self._journal is not None:
+            data = await self.hass.async_add_executor_job(
+                self._journal.load, self.path
+            )
         else:
             data = await self.hass.async_add_executor_job(
                 json_util.load_json, self.path
@@ -174,6 +213,8 @@ class Store:
         self._unsub_delay_listener = async_call_later(
             self.hass, delay, self._async_callback_delayed_write
         )
+        if (writer := self.hass.data.get(STORAGE_WRITER)) is not None:
+            writer.async_delayed(self, delay)
 
     @callback
     def _async_ensure_final_write_listener(self) -> None:
@@ -203,6 +244,11 @@ class Store:
         if self.hass.state == CoreState.stopping:
             self._async_ensure_final_write_listener()
             return
+        if (writer := self.hass.data.get(STORAGE_WRITER)) is not None:
+            # The final write listener stays until the writer takes the data
+            self._unsub_delay_listener = None
+            writer.async_schedule(self)
+            return
         await self._async_handle_write_data()
 
     async def _async_callback_final_write(self, _event: Event) -> None:
@@ -214,33 +260,59 @@ class Store:
         """Handle writing the config."""
         async with self._write_lock:
             self._async_cleanup_delay_listener()
-            self._async_cleanup_final_write_listener()
 
-            if self._data is None:
-                # Another write already consumed the data
+            if (writer := self.hass.data.get(STORAGE_WRITER)) is not None:
+                await writer.async_write(self)
                 return
 
-            data = self._data
-
-            if "data_func" in data:
-                data["data"] = data.pop("data_func")()
-
-            self._data = None
+            if (data := self._async_take_data()) is None:
+                # Another write already consumed the data
+                return
 
             try:
                 await self.hass.async_add_executor_job(
-                    self._write_data, self.path, data
+                    self._write_pending_data, data, False
                 )
             except (json_util.SerializationError, json_util.WriteError) as err:
                 _LOGGER.error("Error writing config for %s: %s", self.key, err)
 
+    @callback
+    def _async_take_data(self) -> dict | None:
+        """Return the data to write and mark it as written."""
+        self._async_cleanup_final_write_listener()
+
+        if (data := self._data) is None:
+            return None
+
+        if "data_func" in data:
+            data["data"] = data.pop("data_func")()
+
+        self._data = None
+        return data
+
+    def _write_pending_data(self, data: dict, use_journal: bool) -> None:
+        """Write the data, appending to the journal when possible."""
+        journal = self._journal
+        if journal is None:
+            self._write_data(self.path, data)
+            return
+
+        if use_journal and journal.append(data):
+            return
+
+        self._write_data(self.path, journal.prepare_full_write(data))
+        journal.full_write_done(data)
+
     def _write_data(self, path: str, data: dict) -> None:
         """Write the data."""
         if not os.path.isdir(os.path.dirname(path)):
             os.makedirs(os.path.dirname(path))
 
         _LOGGER.debug("Writing data for %s to %s", self.key, path)
-        json_util.save_json(path, data, self._private, encoder=self._encoder)
+        if self._encoder is None:
+            json_util.save_json(path, data, self._private, dump=_STORE_DUMP)
+        else:
+            json_util.save_json(path, data, self._private, encoder=self._encoder)
 
     async def _async_migrate_func(self, old_version, old_data):
         """Migrate to the new version."""
@@ -251,5 +323,310 @@ class Store:
         self._async_cleanup_delay_listener()
         self._async_cleanup_final_write_listener()
 
+        if (writer := self.hass.data.get(STORAGE_WRITER)) is not None:
+            writer.async_discard(self)
+
         with suppress(FileNotFoundError):
             await self.hass.async_add_executor_job(os.unlink, self.path)
+
+        if self._journal is not None:
+            await self.hass.async_add_executor_job(self._journal.remove)
+
+
+class _StoreWriter:
+    """Write the pending data of many stores in one executor job."""
+
+    def __init__(self, hass: HomeAssistant, flush_window: float) -> None:
+        """Initialize the writer."""
+        self.hass = hass
+        self.flush_window = flush_window
+        self._pending: dict[Store, None] = {}
+        # Stores with a delayed write and the loop time it comes due
+        self._delayed: dict[Store, float] = {}
+        self._flush_lock = asyncio.Lock()
+        self._flush_scheduled = False
+
+    @callback
+    def async_delayed(self, store: Store, delay: float) -> None:
+        """Remember when the delayed write of a store comes due."""
+        self._delayed[store] = self.hass.loop.time() + delay
+
+    @callback
+    def async_schedule(self, store: Store) -> None:
+        """Write the data of a store that came due."""
+        self._delayed.pop(store, None)
+        self._pending[store] = None
+        if not self._flush_scheduled:
+            # Stores that come due at the same time are written together
+            self._flush_scheduled = True
+            self.hass.async_create_task(self._async_scheduled_flush())
+
+    @callback
+    def async_discard(self, store: Store) -> None:
+        """Do not write the data of a store with the next flush."""
+        self._delayed.pop(store, None)
+        self._pending.pop(store, None)
+
+    async def async_write(self, store: Store) -> None:
+        """Write the data of a store together with all pending data now."""
+        self._pending[store] = None
+        await self.async_flush()
+
+    async def _async_scheduled_flush(self) -> None:
+        """Flush the stores that came due."""
+        self._flush_scheduled = False
+        await self.async_flush()
+
+    async def async_flush(self) -> None:
+        """Write the data of all pending stores.
+
+        Delayed writes that come due within the flush window are written too.
+        """
+        async with self._flush_lock:
+            flush_until = self.hass.loop.time() + self.flush_window
+            for store, due in list(self._delayed.items()):
+                # pylint: disable=protected-access
+                if store._unsub_delay_listener is None:
+                    # Written or removed since it was delayed
+                    del self._delayed[store]
+                elif due <= flush_until:
+                    store._async_cleanup_delay_listener()
+                    del self._delayed[store]
+                    self._pending[store] = None
+
+            writes = []
+            for store in self._pending:
+                # pylint: disable=protected-access
+                if (data := store._async_take_data()) is not None:
+                    writes.append((store, data))
+            self._pending.clear()
+
+            if writes:
+                await self.hass.async_add_executor_job(_write_stores, writes)
+
+
+def _write_stores(writes: list[tuple[Store, dict]]) -> None:
+    """Write the data of stores, an error only affects its own store."""
+    for store, data in writes:
+        try:
+            store._write_pending_data(data, True)  # pylint: disable=protected-access
+        except (json_util.SerializationError, json_util.WriteError) as err:
+            _LOGGER.error("Error writing config for %s: %s", store.key, err)
+
+
+class _StoreJournal:
+    """Journal the changed entries of lists in the data of a store.
+
+    Each record is a line of JSON with a sequence number and the entries
+    that were set or removed per list. A full write of the document stores
+    the last sequence number it includes, so records that are left behind
+    when writing the journal is interrupted are skipped when loading.
+
+    The journal is compacted into the document after JOURNAL_MAX_RECORDS
+    records or once it is larger than the document. Anything in the data
+    besides the entries of the lists always causes a full write.
+
+    The data as last written is kept as a copy, so stores may change and
+    return the same objects on every save.
+
+    The methods run in the executor.
+    """
+
+    def __init__(self, store: Store, lists: dict[str, str]) -> None:
+        """Initialize the journal."""
+        self._store = store
+        self._lists = lists
+        self._seq = 0
+        self._records = 0
+        self._size = 0
+        self._document_size = 0
+        # Data as last written, the lists are keyed by entry id
+        self._version: int | None = None
+        self._entries: dict[str, dict[str, Any]] | None = None
+        self._other: dict[str, Any] | None = None
+
+    @property
+    def path(self) -> str:
+        """Return the path of the journal."""
+        return f"{self._store.path}.journal"
+
+    def load(self, path: str) -> dict:
+        """Load the document and apply the records of the journal."""
+        data = json_util.load_json(path)
+        if data == {}:
+            return data
+
+        data_seq = self._seq = data.pop("journal_seq", 0)
+        self._document_size = os.path.getsize(path)
+        self._records = self._size = 0
+        if not isinstance(stored := data["data"], dict):
+            self._entries = None
+            return data
+
+        try:
+            entries = self._index(stored)
+        except (KeyError, TypeError):
+            # The lists can not be journaled, they are written in full
+            self._entries = None
+            return data
+
+        with suppress(FileNotFoundError), open(self.path, encoding="utf-8") as fdesc:
+            for line in fdesc:
+                try:
+                    record = json.loads(line)
+                    if record["seq"] > data_seq:
+                        self._apply(entries, record["changes"])
+                except (ValueError, KeyError, TypeError, AttributeError):
+                    _LOGGER.warning(
+                        "Ignoring invalid journal record for %s", self._store.key
+                    )
+                    # Records can not be appended after it, write in full next
+                    self._records = JOURNAL_MAX_RECORDS
+                    break
+                self._size += len(line)
+                if record["seq"] <= data_seq:
+                    continue
+                self._seq = record["seq"]
+                self._records += 1
+
+        for name, list_entries in entries.items():
+            stored[name] = list(list_entries.values())
+        self._remember(data)
+        return data
+
+    def append(self, data: dict) -> bool:
+        """Append the changes since the last write, return False if not possible."""
+        if (
+            self._entries is None
+            or data["version"] != self._version
+            or not isinstance(stored := data["data"], dict)
+            or self._records >= JOURNAL_MAX_RECORDS
+            or self._size > self._document_size
+        ):
+            return False
+
+        other = {key: value for key, value in stored.items() if key not in self._lists}
+        if other != self._other:
+            return False
+
+        try:
+            entries = self._index(stored)
+        except (KeyError, TypeError):
+            return False
+
+        changes = {}
+        written: dict[str, dict[str, Any]] = {}
+        for name, list_entries in entries.items():
+            old_entries = self._entries.get(name, {})
+            changed = []
+            written[name] = {}
+            for entry_id, entry in list_entries.items():
+                if (old_entry := old_entries.get(entry_id)) == entry:
+                    written[name][entry_id] = old_entry
+                    continue
+                changed.append(entry)
+                try:
+                    written[name][entry_id] = deepcopy(entry)
+                except (CopyError, TypeError):
+                    return False
+            removed = [
+                entry_id for entry_id in old_entries if entry_id not in list_entries
+            ]
+            if changed or removed:
+                changes[name] = {"set": changed, "remove": removed}
+
+        if not changes:
+            return True
+
+        record = {"seq": self._seq + 1, "changes": changes}
+        try:
+            line = self._dump(record) + "\n"
+        except TypeError:
+            return False
+
+        _LOGGER.debug("Appending journal record for %s", self._store.key)
+        private = self._store._private  # pylint: disable=protected-access
+        try:
+            fd = os.open(
+                self.path,
+                os.O_WRONLY | os.O_APPEND | os.O_CREAT,
+                0o600 if private else 0o644,
+            )
+            with os.fdopen(fd, "w", encoding="utf-8") as fdesc:
+                fdesc.write(line)
+                fdesc.flush()
+                os.fsync(fdesc.fileno())
+        except OSError as err:
+            raise json_util.WriteError(err) from err
+
+        self._seq += 1
+        self._records += 1
+        self._size += len(line)
+        self._entries = written
+        return True
+
+    def prepare_full_write(self, data: dict) -> dict:
+        """Return the document to write in full."""
+        self._entries = None
+        if not self._seq:
+            # The journal was never used, keep the document as it always was
+            return data
+        return {**data, "journal_seq": self._seq}
+
+    def full_write_done(self, data: dict) -> None:
+        """Remember the written document and remove the journal."""
+        self.remove()
+        with suppress(OSError):
+            self._document_size = os.path.getsize(self._store.path)
+        if isinstance(data["data"], dict):
+            self._remember(data)
+
+    def remove(self) -> None:
+        """Remove the journal."""
+        with suppress(FileNotFoundError):
+            os.unlink(self.path)
+        self._records = self._size = 0
+
+    def _index(self, stored: dict) -> dict[str, dict[str, Any]]:
+        """Return the entries of the lists keyed by id."""
+        return {
+            name: {entry[key]: entry for entry in stored.get(name, ())}
+            for name, key in self._lists.items()
+        }
+
+    def _apply(
+        self, entries: dict[str, dict[str, Any]], changes: dict[str, Any]
+    ) -> None:
+        """Apply the changes of a record to the entries.
+
+        The entries are only changed once all changes are known to be valid.
+        """
+        applied = {}
+        for name, list_changes in changes.items():
+            list_entries = dict(entries.get(name, {}))
+            for entry_id in list_changes["remove"]:
+                list_entries.pop(entry_id, None)
+            for entry in list_changes["set"]:
+                list_entries[entry[self._lists[name]]] = entry
+            applied[name] = list_entries
+        entries.update(applied)
+
+    def _remember(self, data: dict) -> None:
+        """Remember data as last written."""
+        stored = data["data"]
+        self._version = data["version"]
+        try:
+            self._entries = deepcopy(self._index(stored))
+            self._other = deepcopy(
+                {key: value for key, value in stored.items() if key not in self._lists}
+            )
+        except (CopyError, KeyError, TypeError):
+            # The lists can not be journaled, they are written in full
+            self._entries = None
+
+    def _dump(self, record: dict) -> str:
+        """Serialize a record."""
+        encoder = self._store._encoder  # pylint: disable=protected-access
+        if encoder is None:
+            return json_dumps(record, compact=True, strict=True)
+        return json.dumps(record, cls=encoder, separators=(",", ":"))
@@ -209,6 +209,40 @@ def _false(arg: str) -> bool:
     return False
 
 
+class EntityReads:
+    """Parts of the state of an entity that were read during a render."""
+
+    __slots__ = ("properties", "attributes")
+
+    def __init__(self) -> None:
+        """Initialise."""
+        # Properties of the state, reading "attributes" covers all attributes
+        self.properties: set[str] = set()
+        # Attributes read by key
+        self.attributes: set[str] = set()
+
+    def __repr__(self) -> str:
+        """Representation of EntityReads."""
+        return (
+            f"<EntityReads properties={self.properties}"
+            f" attributes={self.attributes}>"
+        )
+
+    def changed(self, old_state: State, new_state: State) -> bool:
+        """Return if a part that was read differs between two states."""
+        for prop in self.properties:
+            if getattr(old_state, prop) != getattr(new_state, prop):
+                return True
+        old_attributes = old_state.attributes
+        new_attributes = new_state.attributes
+        for attribute in self.attributes:
+            if old_attributes.get(attribute, _SENTINEL) != new_attributes.get(
+                attribute, _SENTINEL
+            ):
+                return True
+        return False
+
+
 class RenderInfo:
     """Holds information about a template render."""
 
@@ -226,6 +260,7 @@ class RenderInfo:
         self.domains: collections.abc.Set[str] = set()
         self.domains_lifecycle: collections.abc.Set[str] = set()
         self.entities: collections.abc.Set[str] = set()
+        self.entity_reads: dict[str, EntityReads] = {}
         self.rate_limit: timedelta | None = None
         self.has_time = False
 
@@ -247,6 +282,21 @@ class RenderInfo:
         """Template should re-render if the entity is added or removed with domains watched."""
         return split_entity_id(entity_id)[0] in self.domains_lifecycle
 
+    def state_change_affects_render(
+        self, entity_id: str, old_state: State | None, new_state: State | None
+    ) -> bool:
+        """Return if a state change can change the result of the render.
+
+        Only the parts of the state that the template read are compared.
+        Entities that were added or removed, entities that were matched
+        without reading their state and failed renders always count.
+        """
+        if old_state is None or new_state is None or self.exception is not None:
+            return True
+        if (reads := self.entity_reads.get(entity_id)) is None:
+            return True
+        return reads.changed(old_state, new_state)
+
     def result(self) -> str:
         """Results of the template computation."""
         if self.exception is not None:
@@ -574,8 +624,6 @@ class Template:
         self, limited: bool = False, strict: bool = False
     ) -> jinja2.Template:
         """Bind a template to a specific hass instance."""
-        self.ensure_valid()
-
         assert self.hass is not None, "hass variable not set on template"
         assert (
             self._limited is None or self._limited == limited
@@ -589,11 +637,15 @@ class Template:
         self._strict = strict
         env = self._env
 
-        self._compiled = jinja2.Template.from_code(
-            env, self._compiled_code, env.globals, None
-        )
+        # Templates with the same source share the bound template
+        if (compiled := env.bound_cache.get(self.template)) is None:
+            self.ensure_valid()
+            compiled = env.bound_cache[self.template] = jinja2.Template.from_code(
+                env, self._compiled_code, env.globals, None
+            )
 
-        return self._compiled
+        self._compiled = compiled
+        return compiled
 
     def __eq__(self, other):
         """Compare template with another."""
@@ -720,18 +772,33 @@ class TemplateState(State):
         self._state = state
         self._collect = collect
 
-    def _collect_state(self) -> None:
-        if self._collect and _RENDER_INFO in self._hass.data:
-            self._hass.data[_RENDER_INFO].entities.add(self._state.entity_id)
+    def _entity_reads(self, collect: bool = True) -> EntityReads | None:
+        """Return where to record what the render reads from the state."""
+        if (render_info := self._hass.data.get(_RENDER_INFO)) is None:
+            return None
+        entity_id = self._state.entity_id
+        if collect and self._collect:
+            render_info.entities.add(entity_id)
+        if (reads := render_info.entity_reads.get(entity_id)) is None:
+            reads = render_info.entity_reads[entity_id] = EntityReads()
+        return reads
+
+    def _collect_state(self, *properties: str) -> None:
+        if (reads := self._entity_reads()) is not None:
+            reads.properties.update(properties)
+
+    def _read_attribute(self, name: str) -> Any:
+        """Return a single attribute and only record that key as read."""
+        if (reads := self._entity_reads()) is not None:
+            reads.attributes.add(name)
+        return self._state.attributes.get(name)
 
     # Jinja will try __getitem__ first and it avoids the need
     # to call is_safe_attribute
     def __getitem__(self, item):
         """Return a property as an attribute for jinja."""
         if item in _COLLECTABLE_STATE_ATTRIBUTES:
-            # _collect_state inlined here for performance
-            if self._collect and _RENDER_INFO in self._hass.data:
-                self._hass.data[_RENDER_INFO].entities.add(self._state.entity_id)
+            self._collect_state(item)
             return getattr(self._state, item)
         if item == "entity_id":
             return self._state.entity_id
@@ -750,65 +817,68 @@ class TemplateState(State):
     @property
     def state(self):
         """Wrap State.state."""
-        self._collect_state()
+        self._collect_state("state")
         return self._state.state
 
     @property
     def attributes(self):
         """Wrap State.attributes."""
-        self._collect_state()
+        self._collect_state("attributes")
         return self._state.attributes
 
     @property
     def last_changed(self):
         """Wrap State.last_changed."""
-        self._collect_state()
+        self._collect_state("last_changed")
         return self._state.last_changed
 
     @property
     def last_updated(self):
         """Wrap State.last_updated."""
-        self._collect_state()
+        self._collect_state("last_updated")
         return self._state.last_updated
 
     @property
     def context(self):
         """Wrap State.context."""
-        self._collect_state()
+        self._collect_state("context")
         return self._state.context
 
     @property
     def domain(self):
         """Wrap State.domain."""
-        self._collect_state()
+        self._collect_state("domain")
         return self._state.domain
 
     @property
     def object_id(self):
         """Wrap State.object_id."""
-        self._collect_state()
+        self._collect_state("object_id")
         return self._state.object_id
 
     @property
     def name(self):
         """Wrap State.name."""
-        self._collect_state()
+        self._collect_state("name")
         return self._state.name
 
     @property
     def state_with_unit(self) -> str:
         """Return the state concatenated with the unit if available."""
-        self._collect_state()
-        unit = self._state.attributes.get(ATTR_UNIT_OF_MEASUREMENT)
+        self._collect_state("state")
+        unit = self._read_attribute(ATTR_UNIT_OF_MEASUREMENT)
         return f"{self._state.state} {unit}" if unit else self._state.state
 
     def __eq__(self, other: Any) -> bool:
         """Ensure we collect on equality check."""
-        self._collect_state()
+        self._collect_state("state", "attributes", "context")
         return self._state.__eq__(other)
 
     def __repr__(self) -> str:
         """Representation of Template State."""
+        # Not collected, but the output still depends on the state
+        if (reads := self._entity_reads(collect=False)) is not None:
+            reads.properties.update(("state", "attributes", "last_changed"))
         return f"<template TemplateState({self._state.__repr__()})>"
 
 
@@ -1182,10 +1252,115 @@ def state_attr(hass: HomeAssistant, entity_id: str, name: str) -> Any:
     """Get a specific attribute from a state."""
     state_obj = _get_state(hass, entity_id)
     if state_obj is not None:
-        return state_obj.attributes.get(name)
+        return state_obj._read_attribute(name)  # pylint: disable=protected-access
     return None
 
 
+def _aggregated_states(
+    hass: HomeAssistant, target: Any, attribute: str | None = None
+) -> list[State]:
+    """Return the states of a domain or of entities to aggregate.
+
+    The states are read from the state machine without wrapping them. Each
+    entity is collected with only the state or attribute that is aggregated,
+    and a domain only collects the lifecycle of its entities.
+    """
+    render_info: RenderInfo | None = hass.data.get(_RENDER_INFO)
+    states: list[State] = []
+
+    if isinstance(target, str) and "." not in target:
+        if not valid_entity_id(f"{target}.entity"):
+            raise TemplateError(f"Invalid domain name '{target}'")  # type: ignore
+        if render_info is not None:
+            render_info.domains_lifecycle.add(target)
+        states = hass.states.async_all(target)
+    else:
+        if isinstance(target, (str, State)):
+            target = [target]
+        elif not isinstance(target, collections.abc.Iterable):
+            raise TemplateError(  # type: ignore
+                f"Expected a domain or entities, got '{target}'"
+            )
+        for entity in target:
+            if isinstance(entity, State):
+                entity_id = entity.entity_id
+            elif isinstance(entity, str):
+                entity_id = entity
+            else:
+                continue
+            if (state := hass.states.get(entity_id)) is not None:
+                states.append(state)
+            elif render_info is not None:
+                # Collected so the entity being added renders again
+                render_info.entities.add(entity_id)
+
+    if render_info is not None:
+        entity_reads = render_info.entity_reads
+        for state in states:
+            entity_id = state.entity_id
+            render_info.entities.add(entity_id)
+            if (reads := entity_reads.get(entity_id)) is None:
+                reads = entity_reads[entity_id] = EntityReads()
+            if attribute is None:
+                reads.properties.add("state")
+            else:
+                reads.attributes.add(attribute)
+
+    return states
+
+
+def _aggregated_values(
+    hass: HomeAssistant, target: Any, attribute: str | None
+) -> list[float]:
+    """Return the numeric states or attributes to aggregate."""
+    values = []
+    for state in _aggregated_states(hass, target, attribute):
+        value = state.state if attribute is None else state.attributes.get(attribute)
+        try:
+            values.append(float(value))
+        except (ValueError, TypeError):
+            # Unknown, unavailable and other non numeric values are skipped
+            continue
+    return values
+
+
+def count_states(hass: HomeAssistant, target: Any, *states: str) -> int:
+    """Count the entities of a domain or list, optionally only those in states."""
+    if not states:
+        return len(_aggregated_states(hass, target))
+    return sum(
+        1 for state in _aggregated_states(hass, target) if state.state in states
+    )
+
+
+def sum_states(hass: HomeAssistant, target: Any, attribute: str | None = None) -> float:
+    """Sum the numeric states or an attribute of a domain or list of entities."""
+    return sum(_aggregated_values(hass, target, attribute))
+
+
+def average_states(
+    hass: HomeAssistant, target: Any, attribute: str | None = None, default=None
+) -> Any:
+    """Average the numeric states or an attribute of a domain or list of entities."""
+    if not (values := _aggregated_values(hass, target, attribute)):
+        return default
+    return sum(values) / len(values)
+
+
+def min_states(
+    hass: HomeAssistant, target: Any, attribute: str | None = None, default=None
+) -> Any:
+    """Return the lowest numeric state or attribute of a domain or list of entities."""
+    return min(_aggregated_values(hass, target, attribute), default=default)
+
+
+def max_states(
+    hass: HomeAssistant, target: Any, attribute: str | None = None, default=None
+) -> Any:
+    """Return the highest numeric state or attribute of a domain or list of entities."""
+    return max(_aggregated_values(hass, target, attribute), default=default)
+
+
 def now(hass: HomeAssistant) -> datetime:
     """Record fetching now."""
     render_info = hass.data.get(_RENDER_INFO)
@@ -1657,6 +1832,9 @@ class TemplateEnvironment(ImmutableSandboxedEnvironment):
         super().__init__(undefined=undefined)
         self.hass = hass
         self.template_cache = weakref.WeakValueDictionary()
+        self.bound_cache: weakref.WeakValueDictionary[
+            str, jinja2.Template
+        ] = weakref.WeakValueDictionary()
         self.filters["round"] = forgiving_round
         self.filters["multiply"] = multiply
         self.filters["log"] = logarithm
@@ -1776,8 +1954,16 @@ class TemplateEnvironment(ImmutableSandboxedEnvironment):
                 "device_id",
                 "area_id",
                 "area_name",
+                *_AGGREGATE_FUNCTIONS,
+            ]
+            hass_filters = [
+                "closest",
+                "expand",
+                "device_id",
+                "area_id",
+                "area_name",
+                *_AGGREGATE_FUNCTIONS,
             ]
-            hass_filters = ["closest", "expand", "device_id", "area_id", "area_name"]
             for glob in hass_globals:
                 self.globals[glob] = unsupported(glob)
             for filt in hass_filters:
@@ -1795,6 +1981,9 @@ class TemplateEnvironment(ImmutableSandboxedEnvironment):
         self.globals["states"] = AllStates(hass)
         self.globals["utcnow"] = hassfunction(utcnow)
         self.globals["now"] = hassfunction(now)
+        for name, func in _AGGREGATE_FUNCTIONS.items():
+            self.globals[name] = hassfunction(func)
+            self.filters[name] = pass_context(self.globals[name])
 
     def is_safe_callable(self, obj):
         """Test if callback is safe."""
@@ -1831,4 +2020,12 @@ class TemplateEnvironment(ImmutableSandboxedEnvironment):
         return cached
 
 
+_AGGREGATE_FUNCTIONS = {
+    "count_states": count_states,
+    "sum_states": sum_states,
+    "average_states": average_states,
+    "min_states": min_states,
+    "max_states": max_states,
+}
+
 _NO_HASS_ENV = TemplateEnvironment(None)  # type: ignore[no-untyped-call]
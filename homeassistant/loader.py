@@ -13,9 +13,20 @@ import importlib
 import json
 import logging
 import pathlib
+import stat
 import sys
 from types import ModuleType
-from typing import TYPE_CHECKING, Any, Callable, Dict, TypedDict, TypeVar, cast
+from typing import (
+    TYPE_CHECKING,
+    Any,
+    Callable,
+    Dict,
+    List,
+    Optional,
+    TypedDict,
+    TypeVar,
+    cast,
+)
 
 from awesomeversion import (
     AwesomeVersion,
@@ -23,6 +34,7 @@ from awesomeversion import (
     AwesomeVersionStrategy,
 )
 
+from homeassistant.const import __version__
 from homeassistant.generated.dhcp import DHCP
 from homeassistant.generated.mqtt import MQTT
 from homeassistant.generated.ssdp import SSDP
@@ -45,6 +57,7 @@ _LOGGER = logging.getLogger(__name__)
 DATA_COMPONENTS = "components"
 DATA_INTEGRATIONS = "integrations"
 DATA_CUSTOM_COMPONENTS = "custom_components"
+DATA_MANIFEST_CACHE = "manifest_cache"
 PACKAGE_CUSTOM_COMPONENTS = "custom_components"
 PACKAGE_BUILTIN = "homeassistant.components"
 CUSTOM_WARNING = (
@@ -58,6 +71,10 @@ _UNDEF = object()  # Internal; not helpers.typing.UNDEFINED due to circular depe
 
 MAX_LOAD_CONCURRENTLY = 4
 
+MANIFEST_CACHE_STORAGE_KEY = "core.manifest_cache"
+MANIFEST_CACHE_STORAGE_VERSION = 1
+MANIFEST_CACHE_SAVE_DELAY = 60
+
 
 class Manifest(TypedDict, total=False):
     """
@@ -100,6 +117,165 @@ def manifest_from_legacy_module(domain: str, module: ModuleType) -> Manifest:
     }
 
 
+class ManifestCache:
+    """Parsed manifests and resolved dependencies kept across restarts.
+
+    A manifest is reused while its manifest.json keeps the same
+    modification time and size, and the sub directories of a path while
+    the directory keeps its modification time. Everything is dropped when
+    the Home Assistant version changes.
+
+    Lookups run in the executor. Only what was used during this run is
+    saved, so entries of removed integrations do not pile up.
+    """
+
+    def __init__(self, hass: HomeAssistant, store: Any, data: Any) -> None:
+        """Initialize the cache from stored data."""
+        self.hass = hass
+        self._store = store
+        self._stored_manifests: dict[str, dict[str, Any]] = {}
+        self._stored_directories: dict[str, dict[str, Any]] = {}
+        if isinstance(data, dict) and data.get("ha_version") == __version__:
+            self._stored_manifests = data["manifests"]
+            self._stored_directories = data["directories"]
+        # Entries used during this run
+        self._manifests: dict[str, dict[str, Any]] = {}
+        self._directories: dict[str, dict[str, Any]] = {}
+        self._dirty = False
+
+    def get_sub_directories(self, path: pathlib.Path) -> list[str] | None:
+        """Return the names of the sub directories of a path."""
+        try:
+            mtime = path.stat().st_mtime_ns
+        except OSError:
+            return None
+        key = str(path)
+        entry = self._directories.get(key) or self._stored_directories.get(key)
+        if entry is None or entry["mtime"] != mtime:
+            entry = {
+                "mtime": mtime,
+                "entries": [child.name for child in path.iterdir() if child.is_dir()],
+            }
+            self._mark_dirty()
+        self._directories[key] = entry
+        return cast(List[str], entry["entries"])
+
+    def get_manifest(
+        self, manifest_path: pathlib.Path, file_stat: list[int]
+    ) -> Manifest | None:
+        """Return a copy of a cached manifest if the file did not change."""
+        key = str(manifest_path)
+        entry = self._manifests.get(key) or self._stored_manifests.get(key)
+        if entry is None or entry["stat"] != file_stat:
+            return None
+        self._manifests[key] = entry
+        return cast(Manifest, dict(entry["manifest"]))
+
+    def set_manifest(
+        self, manifest_path: pathlib.Path, file_stat: list[int], manifest: Manifest
+    ) -> None:
+        """Store a parsed manifest."""
+        self._manifests[str(manifest_path)] = {
+            "stat": file_stat,
+            "manifest": dict(manifest),
+        }
+        self._mark_dirty()
+
+    def get_dependencies(self, manifest_path: pathlib.Path) -> dict[str, Any] | None:
+        """Return the cached dependencies of an integration.
+
+        Maps each dependency to the path and stat of its manifest at the
+        time the dependencies were resolved.
+        """
+        entry = self._manifests.get(str(manifest_path))
+        if entry is None:
+            return None
+        return cast(Optional[Dict[str, Any]], entry.get("dependencies"))
+
+    def set_dependencies(
+        self, manifest_path: pathlib.Path, dependencies: dict[str, Any]
+    ) -> None:
+        """Store the resolved dependencies of an integration."""
+        if (entry := self._manifests.get(str(manifest_path))) is None:
+            return
+        self._manifests[str(manifest_path)] = {**entry, "dependencies": dependencies}
+        self._mark_dirty()
+
+    def get_stat(self, manifest_path: pathlib.Path) -> list[int] | None:
+        """Return the stat of a manifest seen during this run."""
+        if (entry := self._manifests.get(str(manifest_path))) is None:
+            return None
+        return cast(List[int], entry["stat"])
+
+    def _mark_dirty(self) -> None:
+        """Schedule a save of the cache, safe to call from any thread."""
+        if self._dirty:
+            return
+        self._dirty = True
+        self.hass.loop.call_soon_threadsafe(self._async_schedule_save)
+
+    def _async_schedule_save(self) -> None:
+        """Schedule a save of the cache."""
+        self._store.async_delay_save(self._data_to_save, MANIFEST_CACHE_SAVE_DELAY)
+
+    def _data_to_save(self) -> dict[str, Any]:
+        """Return the data to store."""
+        self._dirty = False
+        return {
+            "ha_version": __version__,
+            "manifests": dict(self._manifests),
+            "directories": dict(self._directories),
+        }
+
+
+async def async_setup_manifest_cache(hass: HomeAssistant) -> None:
+    """Load the manifest cache used to resolve integrations."""
+    # pylint: disable=import-outside-toplevel
+    from homeassistant.exceptions import HomeAssistantError
+    from homeassistant.helpers.storage import Store
+
+    store = Store(hass, MANIFEST_CACHE_STORAGE_VERSION, MANIFEST_CACHE_STORAGE_KEY)
+    try:
+        data = await store.async_load()
+    except HomeAssistantError as err:
+        _LOGGER.warning("Ignoring invalid manifest cache: %s", err)
+        data = None
+    hass.data[DATA_MANIFEST_CACHE] = ManifestCache(hass, store, data)
+
+
+def _file_stat(path: pathlib.Path) -> list[int] | None:
+    """Return modification time and size of a file, None if it is no file."""
+    try:
+        file_stat = path.stat()
+    except OSError:
+        return None
+    if not stat.S_ISREG(file_stat.st_mode):
+        return None
+    return [file_stat.st_mtime_ns, file_stat.st_size]
+
+
+def _load_manifest(hass: HomeAssistant, manifest_path: pathlib.Path) -> Manifest | None:
+    """Load a manifest.json file, from the manifest cache if it is unchanged."""
+    if (file_stat := _file_stat(manifest_path)) is None:
+        return None
+
+    cache: ManifestCache | None = hass.data.get(DATA_MANIFEST_CACHE)
+    if cache is not None and (
+        manifest := cache.get_manifest(manifest_path, file_stat)
+    ):
+        return manifest
+
+    try:
+        manifest = json.loads(manifest_path.read_text())
+    except ValueError as err:
+        _LOGGER.error("Error parsing manifest.json file at %s: %s", manifest_path, err)
+        return None
+
+    if cache is not None:
+        cache.set_manifest(manifest_path, file_stat, manifest)
+    return cast(Manifest, manifest)
+
+
 async def _async_get_custom_components(
     hass: HomeAssistant,
 ) -> dict[str, Integration]:
@@ -112,13 +288,21 @@ async def _async_get_custom_components(
     except ImportError:
         return {}
 
+    cache: ManifestCache | None = hass.data.get(DATA_MANIFEST_CACHE)
+
     def get_sub_directories(paths: list[str]) -> list[pathlib.Path]:
         """Return all sub directories in a set of paths."""
+        if cache is None:
+            return [
+                entry
+                for path in paths
+                for entry in pathlib.Path(path).iterdir()
+                if entry.is_dir()
+            ]
         return [
-            entry
+            pathlib.Path(path) / name
             for path in paths
-            for entry in pathlib.Path(path).iterdir()
-            if entry.is_dir()
+            for name in cache.get_sub_directories(pathlib.Path(path)) or ()
         ]
 
     dirs = await hass.async_add_executor_job(
@@ -300,15 +484,7 @@ class Integration:
         for base in root_module.__path__:  # type: ignore
             manifest_path = pathlib.Path(base) / domain / "manifest.json"
 
-            if not manifest_path.is_file():
-                continue
-
-            try:
-                manifest = json.loads(manifest_path.read_text())
-            except ValueError as err:
-                _LOGGER.error(
-                    "Error parsing manifest.json file at %s: %s", manifest_path, err
-                )
+            if (manifest := _load_manifest(hass, manifest_path)) is None:
                 continue
 
             integration = cls(
@@ -492,6 +668,11 @@ class Integration:
         if self._all_dependencies_resolved is not None:
             return self._all_dependencies_resolved
 
+        if (dependencies := await self._async_get_cached_dependencies()) is not None:
+            self._all_dependencies = dependencies
+            self._all_dependencies_resolved = True
+            return True
+
         try:
             dependencies = await _async_component_dependencies(
                 self.hass, self.domain, self, set(), set()
@@ -499,6 +680,7 @@ class Integration:
             dependencies.discard(self.domain)
             self._all_dependencies = dependencies
             self._all_dependencies_resolved = True
+            self._async_cache_dependencies(dependencies)
         except IntegrationNotFound as err:
             _LOGGER.error(
                 "Unable to resolve dependencies for %s:  we are unable to resolve (sub)dependency %s",
@@ -517,6 +699,49 @@ class Integration:
 
         return self._all_dependencies_resolved
 
+    async def _async_get_cached_dependencies(self) -> set[str] | None:
+        """Return the cached dependencies if none of their manifests changed.
+
+        The dependencies only follow from the manifests of the integrations
+        involved, so they still hold while every dependency resolves to the
+        same unchanged manifest.
+        """
+        cache: ManifestCache | None = self.hass.data.get(DATA_MANIFEST_CACHE)
+        if cache is None or self.file_path is None:
+            return None
+        cached = cache.get_dependencies(self.file_path / "manifest.json")
+        if cached is None:
+            return None
+
+        integrations = await asyncio.gather(
+            *(async_get_integration(self.hass, domain) for domain in cached),
+            return_exceptions=True,
+        )
+        for integration, (path, file_stat) in zip(integrations, cached.values()):
+            if not isinstance(integration, Integration) or not integration.file_path:
+                return None
+            manifest_path = integration.file_path / "manifest.json"
+            if str(manifest_path) != path or cache.get_stat(manifest_path) != file_stat:
+                return None
+        return set(cached)
+
+    def _async_cache_dependencies(self, dependencies: set[str]) -> None:
+        """Store resolved dependencies in the manifest cache."""
+        cache: ManifestCache | None = self.hass.data.get(DATA_MANIFEST_CACHE)
+        if cache is None or self.file_path is None:
+            return
+        integrations = self.hass.data[DATA_INTEGRATIONS]
+        cached: dict[str, Any] = {}
+        for domain in dependencies:
+            integration = integrations.get(domain)
+            if not isinstance(integration, Integration) or not integration.file_path:
+                return
+            manifest_path = integration.file_path / "manifest.json"
+            if (file_stat := cache.get_stat(manifest_path)) is None:
+                return
+            cached[domain] = [str(manifest_path), file_stat]
+        cache.set_dependencies(self.file_path / "manifest.json", cached)
+
     def get_component(self) -> ModuleType:
         """Return the component."""
         cache = self.hass.data.setdefault(DATA_COMPONENTS, {})
@@ -3,8 +3,11 @@ from __future__ import annotations
 
 import asyncio
 from collections.abc import Iterable
+from contextlib import suppress
 import logging
 import os
+import stat
+import sys
 from typing import Any, cast
 
 from homeassistant.core import HomeAssistant, callback
@@ -22,6 +25,9 @@ DATA_PKG_CACHE = "pkg_cache"
 DATA_INTEGRATIONS_WITH_REQS = "integrations_with_reqs"
 DATA_INSTALL_FAILURE_HISTORY = "install_failure_history"
 CONSTRAINT_FILE = "package_constraints.txt"
+REQUIREMENTS_CACHE_STORAGE_KEY = "core.requirements"
+REQUIREMENTS_CACHE_STORAGE_VERSION = 1
+REQUIREMENTS_CACHE_SAVE_DELAY = 60
 DISCOVERY_INTEGRATIONS: dict[str, Iterable[str]] = {
     "dhcp": ("dhcp",),
     "mqtt": ("mqtt",),
@@ -41,6 +47,122 @@ class RequirementsNotFound(HomeAssistantError):
         self.requirements = requirements
 
 
+class RequirementsCache:
+    """Requirements known to be installed, kept across restarts.
+
+    The stored requirements are only trusted while none of the directories
+    on sys.path changed since they were checked. Installing or removing a
+    package changes the directory its metadata lives in.
+    """
+
+    def __init__(
+        self, store: Any, fingerprint: dict[str, int], data: Any | None
+    ) -> None:
+        """Initialize the cache from stored data."""
+        self._store = store
+        self._fingerprint = fingerprint
+        self._installed: set[str] = set()
+        if isinstance(data, dict) and data.get("fingerprint") == fingerprint:
+            self._installed.update(data["installed"])
+
+    def __contains__(self, requirement: object) -> bool:
+        """Return if a requirement is known to be installed."""
+        return requirement in self._installed
+
+    @callback
+    def async_add(self, requirements: Iterable[str]) -> None:
+        """Remember installed requirements."""
+        count = len(self._installed)
+        self._installed.update(requirements)
+        if self._store is not None and len(self._installed) != count:
+            self._store.async_delay_save(
+                self._data_to_save, REQUIREMENTS_CACHE_SAVE_DELAY
+            )
+
+    @callback
+    def _data_to_save(self) -> dict[str, Any]:
+        """Return the data to store.
+
+        Packages installed during this run changed the directories, so the
+        requirements are checked again on the next start.
+        """
+        return {"fingerprint": self._fingerprint, "installed": sorted(self._installed)}
+
+
+async def async_setup_requirements_cache(hass: HomeAssistant) -> None:
+    """Load the requirements that were installed at the last run."""
+    # pylint: disable=import-outside-toplevel
+    from homeassistant.helpers.storage import Store
+
+    store = Store(
+        hass, REQUIREMENTS_CACHE_STORAGE_VERSION, REQUIREMENTS_CACHE_STORAGE_KEY
+    )
+    try:
+        data = await store.async_load()
+    except HomeAssistantError as err:
+        _LOGGER.warning("Ignoring invalid requirements cache: %s", err)
+        data = None
+    fingerprint = await hass.async_add_executor_job(_package_dirs_fingerprint)
+    hass.data[DATA_PKG_CACHE] = RequirementsCache(store, fingerprint, data)
+
+
+def _package_dirs_fingerprint() -> dict[str, int]:
+    """Return the modification times of the directories on sys.path."""
+    fingerprint = {}
+    for path in sys.path:
+        with suppress(OSError):
+            path_stat = os.stat(path)
+            if stat.S_ISDIR(path_stat.st_mode):
+                fingerprint[path] = path_stat.st_mtime_ns
+    return fingerprint
+
+
+async def async_verify_requirements(
+    hass: HomeAssistant, integrations: Iterable[Integration]
+) -> None:
+    """Check the requirements of integrations in one pass ahead of their setup.
+
+    Installed requirements are remembered so the setups skip them. Missing
+    requirements start installing in the background right away.
+    """
+    if hass.config.skip_pip or (cache := hass.data.get(DATA_PKG_CACHE)) is None:
+        return
+
+    integrations = [
+        integration for integration in integrations if integration.requirements
+    ]
+    to_check = {
+        req
+        for integration in integrations
+        for req in integration.requirements
+        if req not in cache
+    }
+    if not to_check:
+        return
+
+    installed = await hass.async_add_executor_job(_installed_requirements, to_check)
+    cache.async_add(installed)
+
+    if not (missing := to_check - installed):
+        return
+
+    _LOGGER.info("Installing missing requirements: %s", ", ".join(sorted(missing)))
+
+    async def _async_install_missing() -> None:
+        """Install the missing requirements, setups report failures."""
+        for integration in integrations:
+            if reqs := [req for req in integration.requirements if req in missing]:
+                with suppress(RequirementsNotFound):
+                    await async_process_requirements(hass, integration.domain, reqs)
+
+    hass.async_create_task(_async_install_missing())
+
+
+def _installed_requirements(requirements: set[str]) -> set[str]:
+    """Return the requirements that are installed."""
+    return {req for req in requirements if pkg_util.is_installed(req)}
+
+
 async def async_get_integration_with_requirements(
     hass: HomeAssistant, domain: str, done: set[str] | None = None
 ) -> Integration:
@@ -178,6 +300,10 @@ async def _async_process_requirements(
     kwargs: Any,
 ) -> None:
     """Install a requirement and save failures."""
+    cache: RequirementsCache | None = hass.data.get(DATA_PKG_CACHE)
+    if cache is not None and req in cache:
+        return
+
     if req in install_failure_history:
         _LOGGER.info(
             "Multiple attempts to install %s failed, install will be retried after next configuration check or restart",
@@ -186,6 +312,8 @@ async def _async_process_requirements(
         raise RequirementsNotFound(name, [req])
 
     if pkg_util.is_installed(req):
+        if cache is not None:
+            cache.async_add([req])
         return
 
     def _install(req: str, kwargs: dict[str, Any]) -> bool:
@@ -194,6 +322,8 @@ async def _async_process_requirements(
 
     for _ in range(MAX_INSTALL_FAILURES):
         if await hass.async_add_executor_job(_install, req, kwargs):
+            if cache is not None:
+                cache.async_add([req])
             return
 
     install_failure_history.add(req)
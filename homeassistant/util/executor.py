@@ -62,6 +62,10 @@ def join_or_interrupt_threads(
 class InterruptibleThreadPoolExecutor(ThreadPoolExecutor):
     """A ThreadPoolExecutor instance that will not deadlock on shutdown."""
 
+    def queue_depth(self) -> int:
+        """Return the number of jobs waiting for a thread."""
+        return self._work_queue.qsize()
+
     def shutdown(self, *args, **kwargs) -> None:  # type: ignore
         """Shutdown backport from cpython 3.9 with interrupt support added."""
         with self._shutdown_lock:  # type: ignore[attr-defined]
@@ -49,13 +49,20 @@ def save_json(
     private: bool = False,
     *,
     encoder: type[json.JSONEncoder] | None = None,
+    dump: Callable[[Any], str] | None = None,
 ) -> None:
     """Save JSON data to a file.
 
+    The data is serialized with dump when given, otherwise with
+    json.dumps and the encoder.
+
     Returns True on success.
     """
     try:
-        json_data = json.dumps(data, indent=4, cls=encoder)
+        if dump is None:
+            json_data = json.dumps(data, indent=4, cls=encoder)
+        else:
+            json_data = dump(data)
     except TypeError as error:
         msg = f"Failed to serialize to JSON: {filename}. Bad data at {format_unserializable_data(find_paths_unserializable_data(data))}"
         _LOGGER.error(msg)
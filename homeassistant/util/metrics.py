@@ -0,0 +1,314 @@
+"""Counters, gauges and histograms to find slow paths under load."""
+from __future__ import annotations
+
+import asyncio
+from bisect import bisect_left
+from collections.abc import Callable
+import logging
+from typing import Any, Dict, Union
+
+_LOGGER = logging.getLogger(__name__)
+
+# Prefix of the metric names in the Prometheus text format
+PROMETHEUS_PREFIX = "homeassistant_"
+
+# Upper bounds in seconds of the histogram buckets
+DEFAULT_BUCKETS = (
+    0.0005,
+    0.001,
+    0.0025,
+    0.005,
+    0.01,
+    0.025,
+    0.05,
+    0.1,
+    0.25,
+    0.5,
+    1.0,
+    2.5,
+    5.0,
+    10.0,
+)
+
+GaugeValue = Union[float, Dict[str, float]]
+
+
+class Metric:
+    """A named metric with an optional label."""
+
+    kind = ""
+
+    def __init__(self, name: str, description: str, label: str | None) -> None:
+        """Initialize the metric."""
+        self.name = name
+        self.description = description
+        self.label = label
+
+    def samples(self) -> list[tuple[str | None, Any]]:
+        """Return the (label value, value) pairs of the metric."""
+        raise NotImplementedError
+
+
+class Counter(Metric):
+    """A value that only goes up."""
+
+    kind = "counter"
+
+    def __init__(
+        self, name: str, description: str, label: str | None = None
+    ) -> None:
+        """Initialize the counter."""
+        super().__init__(name, description, label)
+        self._values: dict[str | None, float] = {}
+
+    def inc(self, amount: float = 1, label: str | None = None) -> None:
+        """Increase the counter."""
+        self._values[label] = self._values.get(label, 0) + amount
+
+    def samples(self) -> list[tuple[str | None, Any]]:
+        """Return the (label value, value) pairs of the counter."""
+        return list(self._values.items())
+
+
+class Gauge(Metric):
+    """A value read when the metrics are collected.
+
+    The callback returns a number, or a dict of numbers by label value.
+    """
+
+    kind = "gauge"
+
+    def __init__(
+        self,
+        name: str,
+        description: str,
+        value: Callable[[], GaugeValue],
+        label: str | None = None,
+    ) -> None:
+        """Initialize the gauge."""
+        super().__init__(name, description, label)
+        self._value = value
+
+    def samples(self) -> list[tuple[str | None, Any]]:
+        """Return the (label value, value) pairs of the gauge."""
+        value = self._value()
+        if isinstance(value, dict):
+            return list(value.items())
+        return [(None, value)]
+
+
+class Histogram(Metric):
+    """The distribution of measured values, usually durations in seconds."""
+
+    kind = "histogram"
+
+    def __init__(
+        self,
+        name: str,
+        description: str,
+        label: str | None = None,
+        buckets: tuple[float, ...] = DEFAULT_BUCKETS,
+    ) -> None:
+        """Initialize the histogram."""
+        super().__init__(name, description, label)
+        self.buckets = buckets
+        # label value -> count per bucket, the last one is for larger values
+        self._counts: dict[str | None, list[int]] = {}
+        self._sums: dict[str | None, float] = {}
+
+    def observe(self, value: float, label: str | None = None) -> None:
+        """Add a measured value."""
+        if (counts := self._counts.get(label)) is None:
+            counts = self._counts[label] = [0] * (len(self.buckets) + 1)
+            self._sums[label] = 0.0
+        counts[bisect_left(self.buckets, value)] += 1
+        self._sums[label] += value
+
+    def samples(self) -> list[tuple[str | None, Any]]:
+        """Return the label values with the cumulative bucket counts."""
+        bounds = [f"{bound:g}" for bound in self.buckets]
+        bounds.append("+Inf")
+        samples: list[tuple[str | None, Any]] = []
+        for label, counts in list(self._counts.items()):
+            cumulative = 0
+            buckets = {}
+            for bound, count in zip(bounds, counts):
+                cumulative += count
+                buckets[bound] = cumulative
+            samples.append(
+                (
+                    label,
+                    {"buckets": buckets, "sum": self._sums[label], "count": cumulative},
+                )
+            )
+        return samples
+
+
+class MetricsRegistry:
+    """The metrics of a Home Assistant instance.
+
+    Counters and gauges are always kept as they cost next to nothing.
+    Measurements that add work to a hot path, like timing every event
+    listener, are only taken once the registry is enabled. That happens
+    the first time the metrics are read.
+
+    Metrics must be registered and read from the event loop. Counting
+    and measuring from other threads is fine, an update racing a read
+    only skews that read.
+    """
+
+    def __init__(self) -> None:
+        """Initialize the registry."""
+        self.enabled = False
+        self._metrics: dict[str, Metric] = {}
+        self._enable_listeners: list[Callable[[], None]] = []
+
+    def counter(
+        self, name: str, description: str, label: str | None = None
+    ) -> Counter:
+        """Return the counter with a name, add it if it does not exist."""
+        if (metric := self._metrics.get(name)) is None:
+            metric = self._metrics[name] = Counter(name, description, label)
+        assert isinstance(metric, Counter)
+        return metric
+
+    def histogram(
+        self,
+        name: str,
+        description: str,
+        label: str | None = None,
+        buckets: tuple[float, ...] = DEFAULT_BUCKETS,
+    ) -> Histogram:
+        """Return the histogram with a name, add it if it does not exist."""
+        if (metric := self._metrics.get(name)) is None:
+            metric = self._metrics[name] = Histogram(
+                name, description, label, buckets
+            )
+        assert isinstance(metric, Histogram)
+        return metric
+
+    def gauge(
+        self,
+        name: str,
+        description: str,
+        value: Callable[[], GaugeValue],
+        label: str | None = None,
+    ) -> Gauge:
+        """Add a gauge, replaces a gauge with the same name."""
+        gauge = self._metrics[name] = Gauge(name, description, value, label)
+        return gauge
+
+    def remove(self, name: str) -> None:
+        """Remove a metric."""
+        self._metrics.pop(name, None)
+
+    def listen_enable(self, listener: Callable[[], None]) -> None:
+        """Call a listener once the registry is enabled, now if it is."""
+        if self.enabled:
+            listener()
+        else:
+            self._enable_listeners.append(listener)
+
+    def enable(self) -> None:
+        """Start taking the measurements that add work to hot paths."""
+        if self.enabled:
+            return
+        self.enabled = True
+        listeners = self._enable_listeners
+        self._enable_listeners = []
+        for listener in listeners:
+            listener()
+
+    def _collect(self) -> list[tuple[Metric, list[tuple[str | None, Any]]]]:
+        """Return the metrics with their samples."""
+        collected = []
+        for metric in list(self._metrics.values()):
+            try:
+                samples = metric.samples()
+            except Exception:  # pylint: disable=broad-except
+                _LOGGER.exception("Error reading metric %s", metric.name)
+                continue
+            collected.append((metric, samples))
+        return collected
+
+    def as_dict(self) -> dict[str, dict[str, Any]]:
+        """Return the metrics as a JSON serializable dict, enables the registry."""
+        self.enable()
+        return {
+            metric.name: {
+                "type": metric.kind,
+                "description": metric.description,
+                "label": metric.label,
+                "samples": [
+                    {"label": label, "value": value} for label, value in samples
+                ],
+            }
+            for metric, samples in self._collect()
+        }
+
+    def render_prometheus(self) -> str:
+        """Return the metrics in the Prometheus text format, enables the registry."""
+        self.enable()
+        lines = []
+        for metric, samples in self._collect():
+            name = f"{PROMETHEUS_PREFIX}{metric.name}"
+            lines.append(f"# HELP {name} {_escape_help(metric.description)}")
+            lines.append(f"# TYPE {name} {metric.kind}")
+            for label, value in samples:
+                labels = []
+                if metric.label is not None and label is not None:
+                    labels.append(f'{metric.label}="{_escape_label(label)}"')
+                if metric.kind != "histogram":
+                    lines.append(f"{name}{_labels(labels)} {_number(value)}")
+                    continue
+                for bound, count in value["buckets"].items():
+                    bucket_labels = _labels([*labels, f'le="{bound}"'])
+                    lines.append(f"{name}_bucket{bucket_labels} {count}")
+                lines.append(f"{name}_sum{_labels(labels)} {_number(value['sum'])}")
+                lines.append(f"{name}_count{_labels(labels)} {value['count']}")
+        lines.append("")
+        return "\n".join(lines)
+
+
+def async_track_loop_lag(
+    loop: asyncio.AbstractEventLoop, histogram: Histogram, interval: float = 1.0
+) -> Callable[[], None]:
+    """Measure how late a timer of the event loop runs every interval.
+
+    Returns a function that stops the measuring.
+    """
+    handle: asyncio.TimerHandle | None = None
+
+    def _measure(expected: float) -> None:
+        nonlocal handle
+        now = loop.time()
+        histogram.observe(max(now - expected, 0.0))
+        handle = loop.call_at(now + interval, _measure, now + interval)
+
+    def _stop() -> None:
+        if handle is not None:
+            handle.cancel()
+
+    start = loop.time() + interval
+    handle = loop.call_at(start, _measure, start)
+    return _stop
+
+
+def _labels(labels: list[str]) -> str:
+    """Return the labels of a sample line."""
+    return f"{{{','.join(labels)}}}" if labels else ""
+
+
+def _number(value: float) -> str:
+    """Return a number of a sample line."""
+    return repr(float(value))
+
+
+def _escape_help(text: str) -> str:
+    """Escape the text of a help line."""
+    return text.replace("\\", r"\\").replace("\n", r"\n")
+
+
+def _escape_label(value: str) -> str:
+    """Escape a label value."""
+    return _escape_help(str(value)).replace('"', r"\"")
@@ -0,0 +1,236 @@
+"""Hierarchical timer wheel to run many timers from a single loop timer."""
+from __future__ import annotations
+
+import asyncio
+from collections.abc import Callable
+import heapq
+import time
+from typing import Any
+
+# Width in seconds of the slots on each level of the wheel. A timer is put
+# on the lowest level where its slot is less than a level above away, and
+# moves down one level when its slot comes up.
+LEVEL_SLOT_SECONDS = (1.0, 64.0, 4096.0, 262144.0)
+
+_LAST_LEVEL = len(LEVEL_SLOT_SECONDS) - 1
+
+
+class TimerWheelHandle:
+    """A callback scheduled on a timer wheel."""
+
+    __slots__ = ("when", "cancelled", "_wheel", "_callback", "_args", "_level", "_slot")
+
+    def __init__(
+        self,
+        wheel: TimerWheel,
+        when: float,
+        callback: Callable[..., Any],
+        args: tuple[Any, ...],
+    ) -> None:
+        """Initialize the handle."""
+        self.when = when
+        self.cancelled = False
+        self._wheel = wheel
+        self._callback = callback
+        self._args = args
+        # Position on the wheel, None once the timer is due
+        self._level: int | None = None
+        self._slot = 0
+
+    def cancel(self) -> None:
+        """Cancel the timer, does nothing if it already ran."""
+        if self.cancelled:
+            return
+        self.cancelled = True
+        if self._level is not None:
+            self._wheel._remove(self)  # pylint: disable=protected-access
+
+    def __repr__(self) -> str:
+        """Return the representation."""
+        return f"<TimerWheelHandle when={self.when} callback={self._callback}>"
+
+
+class TimerWheel:
+    """Run callbacks at points in time from a single loop timer.
+
+    The slots of each level are kept by absolute slot number, which makes
+    adding and cancelling a timer a dict operation. A heap only holds the
+    occupied slots, and timers in the same slot share one wakeup. Timers
+    on the first level still run at their exact time.
+
+    The clock decides which timers are due and defaults to time.time.
+    Wakeups are always scheduled with the wall clock.
+
+    This class must only be used from the event loop.
+    """
+
+    def __init__(
+        self,
+        loop: asyncio.AbstractEventLoop,
+        clock: Callable[[], float] = time.time,
+    ) -> None:
+        """Initialize the wheel."""
+        self._loop = loop
+        self._clock = clock
+        # level -> slot number -> timers in the slot
+        self._slots: list[dict[int, dict[TimerWheelHandle, None]]] = [
+            {} for _ in LEVEL_SLOT_SECONDS
+        ]
+        # Earliest time of a timer in each slot of the first level
+        self._first_level_due: dict[int, float] = {}
+        # (wakeup time, level, slot number) of the occupied slots
+        self._heap: list[tuple[float, int, int]] = []
+        self._count = 0
+        self._running = False
+        self._handle: asyncio.TimerHandle | None = None
+        self._armed_at: float | None = None
+
+    def __len__(self) -> int:
+        """Return the number of scheduled timers."""
+        return self._count
+
+    def async_schedule(
+        self, when: float, callback: Callable[..., Any], *args: Any
+    ) -> TimerWheelHandle:
+        """Schedule callback(*args) to run at a timestamp of the clock."""
+        timer = TimerWheelHandle(self, when, callback, args)
+        self._count += 1
+        wakeup = self._add(timer, _LAST_LEVEL, time.time())
+        if (
+            wakeup is not None
+            and not self._running
+            and (self._armed_at is None or wakeup < self._armed_at)
+        ):
+            self._arm(wakeup)
+        return timer
+
+    def _add(self, timer: TimerWheelHandle, max_level: int, now: float) -> float | None:
+        """Put a timer in its slot and return a new wakeup time if one is needed."""
+        delta = timer.when - now
+        level = 0
+        while level < max_level and delta >= LEVEL_SLOT_SECONDS[level + 1]:
+            level += 1
+
+        slot_seconds = LEVEL_SLOT_SECONDS[level]
+        slot_number = int(timer.when // slot_seconds)
+        timer._level = level  # pylint: disable=protected-access
+        timer._slot = slot_number  # pylint: disable=protected-access
+
+        wakeup: float | None = None
+        slots = self._slots[level]
+        if (slot := slots.get(slot_number)) is None:
+            slot = slots[slot_number] = {}
+            wakeup = timer.when if level == 0 else slot_number * slot_seconds
+        elif level == 0 and timer.when < self._first_level_due[slot_number]:
+            wakeup = timer.when
+        slot[timer] = None
+
+        if wakeup is not None:
+            if level == 0:
+                self._first_level_due[slot_number] = wakeup
+            heapq.heappush(self._heap, (wakeup, level, slot_number))
+        return wakeup
+
+    def _remove(self, timer: TimerWheelHandle) -> None:
+        """Remove a cancelled timer from its slot."""
+        level = timer._level  # pylint: disable=protected-access
+        slot_number = timer._slot  # pylint: disable=protected-access
+        assert level is not None
+        timer._level = None  # pylint: disable=protected-access
+        self._count -= 1
+        slots = self._slots[level]
+        slot = slots[slot_number]
+        del slot[timer]
+        if not slot:
+            # The heap entry is dropped when it comes up
+            del slots[slot_number]
+            if level == 0:
+                del self._first_level_due[slot_number]
+        if not self._count and self._handle is not None:
+            self._handle.cancel()
+            self._handle = None
+            self._armed_at = None
+
+    def _arm(self, wakeup: float) -> None:
+        """Schedule the loop timer to run the wheel at a wakeup time."""
+        if self._handle is not None:
+            self._handle.cancel()
+        self._armed_at = wakeup
+        self._handle = self._loop.call_later(wakeup - time.time(), self._run)
+
+    def _run(self) -> None:
+        """Run the due timers and schedule the next wakeup."""
+        self._handle = None
+        self._armed_at = None
+        now = self._clock()
+        heap = self._heap
+        due: list[TimerWheelHandle] = []
+
+        while heap and heap[0][0] <= now:
+            _, level, slot_number = heapq.heappop(heap)
+            if (slot := self._slots[level].pop(slot_number, None)) is None:
+                continue
+
+            if level:
+                # Move the timers of the slot down a level
+                for timer in slot:
+                    self._add(timer, level - 1, now)
+                continue
+
+            del self._first_level_due[slot_number]
+            remaining: dict[TimerWheelHandle, None] = {}
+            for timer in slot:
+                if timer.when <= now:
+                    timer._level = None  # pylint: disable=protected-access
+                    due.append(timer)
+                else:
+                    remaining[timer] = None
+            if remaining:
+                # Fired early, wait for the rest of the slot
+                earliest = min(timer.when for timer in remaining)
+                self._slots[0][slot_number] = remaining
+                self._first_level_due[slot_number] = earliest
+                heapq.heappush(heap, (earliest, 0, slot_number))
+
+        self._count -= len(due)
+        due.sort(key=_timer_when)
+        self._running = True
+        try:
+            for timer in due:
+                # An earlier callback may have cancelled the timer
+                if timer.cancelled:
+                    continue
+                try:
+                    timer._callback(*timer._args)  # pylint: disable=protected-access
+                except Exception as exc:  # pylint: disable=broad-except
+                    self._loop.call_exception_handler(
+                        {
+                            "message": f"Exception in timer {timer}",
+                            "exception": exc,
+                        }
+                    )
+        finally:
+            self._running = False
+            self._arm_next()
+
+    def _arm_next(self) -> None:
+        """Schedule the loop timer for the earliest occupied slot."""
+        heap = self._heap
+        while heap:
+            wakeup, level, slot_number = heap[0]
+            if slot_number in self._slots[level] and (
+                level or self._first_level_due[slot_number] == wakeup
+            ):
+                break
+            # The slot was emptied or got an earlier entry
+            heapq.heappop(heap)
+
+        if not heap:
+            return
+        if (wakeup := heap[0][0]) != self._armed_at:
+            self._arm(wakeup)
+
+
+def _timer_when(timer: TimerWheelHandle) -> float:
+    """Return the time of a timer for sorting."""
+    return timer.when
@@ -416,6 +416,20 @@ async def test_api_error_log(
     assert resp.status == 401
 
 
+async def test_api_metrics(hass, mock_api_client, hass_admin_user):
+    """Test the metrics are returned in the Prometheus text format."""
+    resp = await mock_api_client.get(const.URL_API_METRICS)
+    assert resp.status == 200
+    assert resp.headers["Content-Type"].startswith("text/plain; version=0.0.4")
+    text = await resp.text()
+    assert "# TYPE homeassistant_executor_queue_depth gauge" in text
+    assert hass.metrics.enabled
+
+    hass_admin_user.groups = []
+    resp = await mock_api_client.get(const.URL_API_METRICS)
+    assert resp.status == 401
+
+
 async def test_api_fire_event_context(hass, mock_api_client, hass_access_token):
     """Test if the API sets right context if we fire an event."""
     test_value = []
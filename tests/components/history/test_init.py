@@ -4,10 +4,12 @@ from datetime import timedelta
 import json
 from unittest.mock import patch, sentinel
 
+from aiohttp import ClientError
 import pytest
 from pytest import approx
 
 from homeassistant.components import history, recorder
+from homeassistant.components.recorder import history as recorder_history
 from homeassistant.components.recorder.history import get_significant_states
 from homeassistant.components.recorder.models import process_timestamp
 import homeassistant.core as ha
@@ -589,6 +591,250 @@ async def test_fetch_period_api(hass, hass_client):
     assert response.status == 200
 
 
+async def test_fetch_period_api_stream(hass, hass_client):
+    """Test the fetch period view streams the same history."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    start = dt_util.utcnow()
+    hass.states.async_set("light.kitchen", "on", {"brightness": 10})
+    hass.states.async_set("light.kitchen", "off")
+    hass.states.async_set("switch.fan", "on")
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_client()
+    response = await client.get(f"/api/history/period/{start.isoformat()}")
+    assert response.status == 200
+    expected = await response.json()
+
+    response = await client.get(f"/api/history/period/{start.isoformat()}?stream")
+    assert response.status == 200
+    streamed = await response.json()
+    assert len(streamed) == 2
+    assert sorted(streamed, key=lambda states: states[0]["entity_id"]) == sorted(
+        expected, key=lambda states: states[0]["entity_id"]
+    )
+
+
+async def test_fetch_period_api_stream_error(hass, hass_client):
+    """Test a stream that fails is cut off instead of ending as valid json."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_client()
+    with patch.object(
+        recorder_history,
+        "stream_significant_states_with_session",
+        side_effect=ValueError,
+    ), pytest.raises(ClientError):
+        response = await client.get(
+            f"/api/history/period/{dt_util.utcnow().isoformat()}?stream"
+        )
+        await response.read()
+
+
+async def test_fetch_period_api_columnar(hass, hass_client):
+    """Test the fetch period view in the columnar format."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    start = dt_util.utcnow()
+    hass.states.async_set("light.kitchen", "on", {"brightness": 10})
+    hass.states.async_set("light.kitchen", "off", {"brightness": 10})
+    hass.states.async_set("light.kitchen", "on", {"brightness": 20})
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_client()
+    response = await client.get(
+        f"/api/history/period/{start.isoformat()}", params={"format": "columnar"}
+    )
+    assert response.status == 200
+    result = await response.json()
+    columns = result["light.kitchen"]
+    assert columns["state"] == ["on", "off", "on"]
+    assert len(columns["time"]) == 3
+    assert columns["attributes"] == [[0, {"brightness": 10}], [2, {"brightness": 20}]]
+
+    response = await client.get(
+        f"/api/history/period/{start.isoformat()}", params={"format": "bogus"}
+    )
+    assert response.status == 400
+
+
+async def test_history_during_period_pages(hass, hass_ws_client):
+    """Test fetching history a page at a time."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    start = dt_util.utcnow()
+    for state in range(5):
+        hass.states.async_set("sensor.test", state)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_ws_client()
+    message = {
+        "type": "history/history_during_period",
+        "start_time": start.isoformat(),
+        "entity_ids": ["sensor.test"],
+        "page_size": 2,
+    }
+    states = []
+    for msg_id in range(1, 5):
+        await client.send_json({"id": msg_id, **message})
+        response = await client.receive_json()
+        assert response["success"]
+        page = response["result"]
+        states.extend(page["states"].get("sensor.test", []))
+        if page["next"] is None:
+            break
+        message["after"] = page["next"]
+
+    assert [state["state"] for state in states] == ["0", "1", "2", "3", "4"]
+
+
+async def test_history_during_period_pages_start_time_state(hass, hass_ws_client):
+    """Test the start time states are kept on every page of history."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    for entity_id in ("sensor.a", "sensor.b", "sensor.c"):
+        hass.states.async_set(entity_id, "start")
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    start = dt_util.utcnow()
+    for state in range(3):
+        hass.states.async_set("sensor.a", state)
+        hass.states.async_set("sensor.c", state)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_ws_client()
+    message = {
+        "type": "history/history_during_period",
+        "start_time": start.isoformat(),
+        "entity_ids": ["sensor.a", "sensor.b", "sensor.c"],
+        "include_start_time_state": True,
+        "page_size": 2,
+    }
+    states = {}
+    for msg_id in range(1, 10):
+        await client.send_json({"id": msg_id, **message})
+        response = await client.receive_json()
+        assert response["success"]
+        page = response["result"]
+        for entity_id, entity_states in page["states"].items():
+            states.setdefault(entity_id, []).extend(entity_states)
+        if page["next"] is None:
+            break
+        message["after"] = page["next"]
+
+    assert page["next"] is None
+    assert {
+        entity_id: [state["state"] for state in entity_states]
+        for entity_id, entity_states in states.items()
+    } == {
+        "sensor.a": ["start", "0", "1", "2"],
+        "sensor.b": ["start"],
+        "sensor.c": ["start", "0", "1", "2"],
+    }
+
+
+async def test_history_during_period_pages_minimal_response(hass, hass_ws_client):
+    """Test minimal responses are the same when split into pages."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    hass.states.async_set("sensor.a", "start")
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    start = dt_util.utcnow()
+    for state in range(5):
+        hass.states.async_set("sensor.a", state)
+        hass.states.async_set("sensor.b", state)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_ws_client()
+    message = {
+        "type": "history/history_during_period",
+        "start_time": start.isoformat(),
+        "entity_ids": ["sensor.a", "sensor.b"],
+        "minimal_response": True,
+        "page_size": 2,
+    }
+    states = {}
+    with patch.object(
+        recorder_history,
+        "_get_states_with_session",
+        wraps=recorder_history._get_states_with_session,
+    ) as mock_get_states:
+        for msg_id in range(1, 10):
+            await client.send_json({"id": msg_id, **message})
+            response = await client.receive_json()
+            assert response["success"]
+            page = response["result"]
+            for entity_id, entity_states in page["states"].items():
+                states.setdefault(entity_id, []).extend(entity_states)
+            if page["next"] is None:
+                break
+            message["after"] = page["next"]
+
+    # The states at the start time are only fetched for the first page
+    assert msg_id > 2
+    assert mock_get_states.call_count == 1
+    # Only the first and the last state are full states
+    assert {
+        entity_id: [(state["state"], "entity_id" in state) for state in entity_states]
+        for entity_id, entity_states in states.items()
+    } == {
+        "sensor.a": [
+            ("start", True),
+            ("0", False),
+            ("1", False),
+            ("2", False),
+            ("3", False),
+            ("4", True),
+        ],
+        "sensor.b": [
+            ("0", True),
+            ("1", False),
+            ("2", False),
+            ("3", False),
+            ("4", True),
+        ],
+    }
+
+
+async def test_history_during_period_bad_start_time(hass, hass_ws_client):
+    """Test history_during_period with an invalid start time."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "history", {})
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_ws_client()
+    await client.send_json(
+        {"id": 1, "type": "history/history_during_period", "start_time": "cats"}
+    )
+    response = await client.receive_json()
+    assert not response["success"]
+    assert response["error"]["code"] == "invalid_start_time"
+
+
 async def test_fetch_period_api_with_use_include_order(hass, hass_client):
     """Test the fetch period view for history with include order."""
     await hass.async_add_executor_job(init_recorder_component, hass)
@@ -601,6 +847,50 @@ async def test_fetch_period_api_with_use_include_order(hass, hass_client):
     assert response.status == 200
 
 
+async def test_fetch_period_api_columnar_with_use_include_order(hass, hass_client):
+    """Test the columnar format keeps the include order and minimal response."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(
+        hass,
+        "history",
+        {
+            history.DOMAIN: {
+                history.CONF_ORDER: True,
+                history.CONF_INCLUDE: {
+                    history.CONF_ENTITIES: ["switch.fan", "light.kitchen"]
+                },
+            }
+        },
+    )
+    start = dt_util.utcnow()
+    hass.states.async_set("light.kitchen", "on", {"brightness": 10})
+    hass.states.async_set("light.kitchen", "on", {"brightness": 20})
+    hass.states.async_set("light.kitchen", "off", {"brightness": 30})
+    hass.states.async_set("switch.fan", "on")
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_client()
+    response = await client.get(
+        f"/api/history/period/{start.isoformat()}",
+        params={
+            "format": "columnar",
+            "minimal_response": "",
+            "significant_changes_only": "0",
+        },
+    )
+    assert response.status == 200
+    result = await response.json()
+    assert list(result) == ["switch.fan", "light.kitchen"]
+    assert result["light.kitchen"]["state"] == ["on", "off"]
+    assert result["light.kitchen"]["attributes"] == [
+        [0, {"brightness": 10}],
+        [1, {"brightness": 30}],
+    ]
+
+
 async def test_fetch_period_api_with_minimal_response(hass, hass_client):
     """Test the fetch period view for history with minimal_response."""
     await hass.async_add_executor_job(init_recorder_component, hass)
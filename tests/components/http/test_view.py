@@ -1,5 +1,5 @@
 """Tests for Home Assistant View."""
-from unittest.mock import AsyncMock, Mock
+from unittest.mock import AsyncMock, Mock, patch
 
 from aiohttp.web_exceptions import (
     HTTPBadRequest,
@@ -11,6 +11,7 @@ import voluptuous as vol
 
 from homeassistant.components.http.view import (
     HomeAssistantView,
+    JSONStreamWriter,
     request_handler_factory,
 )
 from homeassistant.exceptions import ServiceNotFound, Unauthorized
@@ -69,3 +70,23 @@ async def test_not_running(mock_request_with_stopping):
         Mock(requires_auth=False), AsyncMock(side_effect=Unauthorized)
     )(mock_request_with_stopping)
     assert response.status == 503
+
+
+async def test_json_stream_writer(hass):
+    """Test the JSON stream writer collects parts before writing them."""
+    response = Mock(write=AsyncMock())
+    writer = JSONStreamWriter(hass.loop, response)
+
+    def write_json(writer, count):
+        """Write the parts of the JSON."""
+        for _ in range(count):
+            writer.write("a" * 1000)
+
+    with patch("homeassistant.components.http.view.STREAM_WRITE_SIZE", 2500):
+        await hass.async_add_executor_job(writer.run, write_json, 7)
+
+    assert [call.args[0] for call in response.write.mock_calls] == [
+        b"a" * 3000,
+        b"a" * 3000,
+        b"a" * 1000,
+    ]
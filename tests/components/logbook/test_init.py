@@ -401,6 +401,47 @@ async def test_logbook_view_period_entity(hass, hass_client):
     assert response_json[0]["entity_id"] == entity_id_test
 
 
+async def test_logbook_view_stream_and_states_table(hass, hass_client):
+    """Test streamed entries and entries read from the states table match."""
+    await hass.async_add_executor_job(init_recorder_component, hass)
+    await async_setup_component(hass, "logbook", {})
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    context = ha.Context(user_id="b400facee45711eaa9308bfd3d19e474")
+    hass.states.async_set("switch.test", STATE_OFF, {"icon": "mdi:switch"})
+    hass.states.async_set("switch.test", STATE_ON, context=context)
+    hass.states.async_set("sensor.power", "10", {"unit_of_measurement": "W"})
+    hass.states.async_set("sensor.power", "20", {"unit_of_measurement": "W"})
+    hass.bus.async_fire(
+        logbook.EVENT_LOGBOOK_ENTRY, {"name": "Alarm", "domain": "switch"}
+    )
+    await hass.async_add_executor_job(trigger_db_commit, hass)
+    await hass.async_block_till_done()
+    await hass.async_add_executor_job(hass.data[recorder.DATA_INSTANCE].block_till_done)
+
+    client = await hass_client()
+    start = dt_util.utcnow().date()
+    url = f"/api/logbook/{datetime(start.year, start.month, start.day).isoformat()}"
+
+    response = await client.get(url)
+    assert response.status == 200
+    response_json = await response.json()
+    assert [entry.get("entity_id") for entry in response_json] == [
+        "switch.test",
+        None,
+    ]
+    assert response_json[0]["context_user_id"] == context.user_id
+
+    response = await client.get(f"{url}?stream")
+    assert response.status == 200
+    assert await response.json() == response_json
+
+    with patch.object(hass.data[recorder.DATA_INSTANCE], "logbook_states_since", None):
+        response = await client.get(url)
+    assert response.status == 200
+    assert await response.json() == response_json
+
+
 async def test_logbook_describe_event(hass, hass_client):
     """Test teaching logbook about a new event."""
     await hass.async_add_executor_job(init_recorder_component, hass)
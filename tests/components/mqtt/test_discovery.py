@@ -134,6 +134,66 @@ async def test_correct_config_discovery(hass, mqtt_mock, caplog):
     assert ("binary_sensor", "bla") in hass.data[ALREADY_DISCOVERED]
 
 
+async def test_retained_config_backlog(hass, mqtt_mock, caplog):
+    """Test retained configs are handled as a batch with the latest config."""
+    async_fire_mqtt_message(
+        hass,
+        "homeassistant/binary_sensor/bla/config",
+        '{ "name": "Milk", "state_topic": "test-topic" }',
+        retain=True,
+    )
+    async_fire_mqtt_message(
+        hass,
+        "homeassistant/sensor/bla/config",
+        '{ "name": "Wine", "state_topic": "test-topic" }',
+        retain=True,
+    )
+    async_fire_mqtt_message(
+        hass,
+        "homeassistant/binary_sensor/bla/config",
+        '{ "name": "Beer", "state_topic": "test-topic" }',
+        retain=True,
+    )
+    assert ("binary_sensor", "bla") not in hass.data[ALREADY_DISCOVERED]
+    await hass.async_block_till_done()
+
+    assert hass.states.get("binary_sensor.milk") is None
+    assert hass.states.get("binary_sensor.beer").name == "Beer"
+    assert hass.states.get("sensor.wine").name == "Wine"
+    assert ("binary_sensor", "bla") in hass.data[ALREADY_DISCOVERED]
+    assert ("sensor", "bla") in hass.data[ALREADY_DISCOVERED]
+
+
+async def test_retained_config_backlog_superseded(hass, mqtt_mock, caplog):
+    """Test a config received while the backlog is handled replaces it."""
+    forward_entry_setup = hass.config_entries.async_forward_entry_setup
+
+    async def async_forward_entry_setup(entry, component):
+        """Receive a newer config while the platform is set up."""
+        async_fire_mqtt_message(
+            hass,
+            "homeassistant/binary_sensor/bla/config",
+            '{ "name": "Beer", "state_topic": "test-topic" }',
+        )
+        return await forward_entry_setup(entry, component)
+
+    with patch.object(
+        hass.config_entries,
+        "async_forward_entry_setup",
+        side_effect=async_forward_entry_setup,
+    ):
+        async_fire_mqtt_message(
+            hass,
+            "homeassistant/binary_sensor/bla/config",
+            '{ "name": "Milk", "state_topic": "test-topic" }',
+            retain=True,
+        )
+        await hass.async_block_till_done()
+
+    assert hass.states.get("binary_sensor.milk") is None
+    assert hass.states.get("binary_sensor.beer").name == "Beer"
+
+
 async def test_discover_fan(hass, mqtt_mock, caplog):
     """Test discovering an MQTT fan."""
     async_fire_mqtt_message(
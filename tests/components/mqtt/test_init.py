@@ -702,6 +702,80 @@ async def test_not_calling_unsubscribe_with_active_subscribers(
     assert not mqtt_client_mock.unsubscribe.called
 
 
+async def test_exact_and_wildcard_subscriptions_on_same_topic(
+    hass, mqtt_client_mock, mqtt_mock
+):
+    """Test exact and wildcard subscriptions are called in subscription order."""
+    # Fake that the client is connected
+    mqtt_mock().connected = True
+    calls = []
+
+    def record(name):
+        @callback
+        def _record(msg):
+            calls.append((name, msg.payload))
+
+        return _record
+
+    unsub_wildcard = await mqtt.async_subscribe(hass, "test/+", record("wildcard"))
+    await mqtt.async_subscribe(hass, "test/state", record("exact"))
+    await mqtt.async_subscribe(hass, "test/#", record("subtree"))
+
+    async_fire_mqtt_message(hass, "test/state", "on")
+    await hass.async_block_till_done()
+    assert calls == [("wildcard", "on"), ("exact", "on"), ("subtree", "on")]
+
+    calls.clear()
+    unsub_wildcard()
+    await hass.async_block_till_done()
+    mqtt_client_mock.unsubscribe.assert_called_once_with("test/+")
+
+    async_fire_mqtt_message(hass, "test/state", "off")
+    async_fire_mqtt_message(hass, "test/other", "off")
+    await hass.async_block_till_done()
+    assert calls == [("exact", "off"), ("subtree", "off"), ("subtree", "off")]
+
+
+@pytest.mark.parametrize(
+    "mqtt_config",
+    [{mqtt.CONF_BROKER: "mock-broker", mqtt.CONF_COALESCE_WINDOW: 0.5}],
+)
+async def test_coalesce_messages(hass, mqtt_client_mock, mqtt_mock):
+    """Test coalescing subscriptions only get the latest message of a burst."""
+    coalesced = []
+    all_messages = []
+
+    @callback
+    def record_coalesced(msg):
+        coalesced.append((msg.topic, msg.payload))
+
+    @callback
+    def record_all(msg):
+        all_messages.append((msg.topic, msg.payload))
+
+    unsub = await mqtt.async_subscribe(hass, "test/+", record_coalesced, coalesce=True)
+    await mqtt.async_subscribe(hass, "test/a", record_all)
+
+    for payload in ("1", "2", "3"):
+        async_fire_mqtt_message(hass, "test/a", payload)
+    async_fire_mqtt_message(hass, "test/b", "1")
+    async_fire_mqtt_message(hass, "test/a", "4")
+    await hass.async_block_till_done()
+    assert coalesced == []
+    assert [payload for _, payload in all_messages] == ["1", "2", "3", "4"]
+
+    async_fire_time_changed(hass, utcnow() + timedelta(seconds=1))
+    await hass.async_block_till_done()
+    assert coalesced == [("test/b", "1"), ("test/a", "4")]
+
+    # Messages held for a removed subscription are dropped
+    async_fire_mqtt_message(hass, "test/a", "5")
+    unsub()
+    async_fire_time_changed(hass, utcnow() + timedelta(seconds=1))
+    await hass.async_block_till_done()
+    assert coalesced == [("test/b", "1"), ("test/a", "4")]
+
+
 @pytest.mark.parametrize(
     "mqtt_config",
     [{mqtt.CONF_BROKER: "mock-broker", mqtt.CONF_DISCOVERY: False}],
@@ -5,8 +5,11 @@ from datetime import timedelta
 import json
 from unittest.mock import patch, sentinel
 
+import pytest
+
 from homeassistant.components.recorder import history
 from homeassistant.components.recorder.models import process_timestamp
+from homeassistant.components.recorder.util import session_scope
 import homeassistant.core as ha
 from homeassistant.helpers.json import JSONEncoder
 import homeassistant.util.dt as dt_util
@@ -369,6 +372,91 @@ def test_get_significant_states_only(hass_recorder):
     assert states == hist[entity_id]
 
 
+@pytest.mark.parametrize("minimal_response", [False, True])
+def test_stream_significant_states(hass_recorder, minimal_response):
+    """Test streaming significant states in chunks matches the full result."""
+    hass = hass_recorder()
+    zero, four, _ = record_states(hass)
+    one_and_half = zero + timedelta(seconds=1.5)
+    hist = history.get_significant_states(
+        hass, one_and_half, four, minimal_response=minimal_response
+    )
+
+    streamed = {}
+    with session_scope(hass=hass) as session:
+        for entity_id, states, _ in history.stream_significant_states_with_session(
+            hass,
+            session,
+            one_and_half,
+            four,
+            minimal_response=minimal_response,
+            chunk_size=2,
+        ):
+            assert len(states) <= 2
+            assert entity_id not in streamed or list(streamed)[-1] == entity_id
+            streamed.setdefault(entity_id, []).extend(states)
+
+    assert streamed == hist
+
+
+def test_get_significant_states_columnar(hass_recorder):
+    """Test the columnar form holds the same states with attributes on change."""
+    hass = hass_recorder()
+    zero, four, _ = record_states(hass)
+    one_and_half = zero + timedelta(seconds=1.5)
+    hist = history.get_significant_states(hass, one_and_half, four)
+
+    with session_scope(hass=hass) as session:
+        columnar = history.get_significant_states_columnar_with_session(
+            hass, session, one_and_half, four
+        )
+
+    assert list(columnar) == list(hist)
+    for entity_id, states in hist.items():
+        columns = columnar[entity_id]
+        assert columns["state"] == [state.state for state in states]
+        assert columns["time"] == [state.last_updated.timestamp() for state in states]
+        changes = columns["attributes"]
+        assert changes[0][0] == 0
+        for index, attributes in changes:
+            assert states[index].attributes == attributes
+        changed = [
+            index
+            for index in range(1, len(states))
+            if states[index].attributes != states[index - 1].attributes
+        ]
+        assert set(changed).issubset(index for index, _ in changes)
+        # Unchanged attributes are not repeated, also not after the start state
+        assert all(index == 0 or index in changed for index, _ in changes)
+
+
+def test_get_significant_states_columnar_minimal_response(hass_recorder):
+    """Test the columnar form keeps the states of a minimal response."""
+    hass = hass_recorder()
+    zero, four, _ = record_states(hass)
+    one_and_half = zero + timedelta(seconds=1.5)
+    hist = history.get_significant_states(
+        hass, one_and_half, four, minimal_response=True
+    )
+
+    with session_scope(hass=hass) as session:
+        columnar = history.get_significant_states_columnar_with_session(
+            hass, session, one_and_half, four, minimal_response=True
+        )
+
+    assert list(columnar) == list(hist)
+    for entity_id, states in hist.items():
+        columns = columnar[entity_id]
+        assert columns["state"] == [
+            state["state"] if isinstance(state, dict) else state.state
+            for state in states
+        ]
+        # Only full states have attributes
+        assert {index for index, _ in columns["attributes"]}.issubset(
+            index for index, state in enumerate(states) if isinstance(state, ha.State)
+        )
+
+
 def record_states(hass):
     """Record some test states.
 
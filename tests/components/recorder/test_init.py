@@ -5,11 +5,13 @@ import sqlite3
 from unittest.mock import patch
 
 import pytest
+from sqlalchemy import text
 from sqlalchemy.exc import DatabaseError, OperationalError, SQLAlchemyError
 
 from homeassistant.components import recorder
 from homeassistant.components.recorder import (
     CONF_AUTO_PURGE,
+    CONF_BULK_INSERT,
     CONF_DB_URL,
     CONFIG_SCHEMA,
     DOMAIN,
@@ -27,7 +29,9 @@ from homeassistant.components.recorder import (
 from homeassistant.components.recorder.const import DATA_INSTANCE
 from homeassistant.components.recorder.models import (
     Events,
+    LogbookStates,
     RecorderRuns,
+    StateAttributes,
     States,
     StatisticsRuns,
     process_timestamp,
@@ -37,6 +41,7 @@ from homeassistant.const import (
     EVENT_HOMEASSISTANT_FINAL_WRITE,
     EVENT_HOMEASSISTANT_STARTED,
     EVENT_HOMEASSISTANT_STOP,
+    EVENT_STATE_CHANGED,
     MATCH_ALL,
     STATE_LOCKED,
     STATE_UNLOCKED,
@@ -147,6 +152,50 @@ async def test_saving_state(
     assert state == _state_empty_context(hass, entity_id)
 
 
+async def test_saving_state_bulk_insert(
+    hass: HomeAssistant, async_setup_recorder_instance: SetupRecorderInstanceT
+):
+    """Test saving states and events with the bulk insert write path."""
+    instance = await async_setup_recorder_instance(hass, {CONF_BULK_INSERT: True})
+    assert instance._bulk_writer is not None
+
+    entity_id = "test.recorder"
+    attributes = {"test_attr": 5, "test_attr_10": "nice"}
+
+    hass.states.async_set(entity_id, "on", attributes)
+    hass.states.async_set(entity_id, "off", attributes)
+    hass.bus.async_fire("custom_event", {"some": "data"})
+    hass.states.async_remove(entity_id)
+
+    await async_wait_recording_done(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        db_states = list(session.query(States).order_by(States.state_id))
+        assert [db_state.state for db_state in db_states] == ["on", "off", None]
+        assert db_states[0].old_state_id is None
+        assert db_states[1].old_state_id == db_states[0].state_id
+        assert db_states[2].old_state_id == db_states[1].state_id
+        for db_state in db_states:
+            db_event = (
+                session.query(Events)
+                .filter(Events.event_id == db_state.event_id)
+                .one()
+            )
+            assert db_event.event_type == EVENT_STATE_CHANGED
+            assert db_event.event_data == "{}"
+        native_state = db_states[1].to_native()
+        assert native_state.state == "off"
+        assert native_state.attributes == attributes
+
+        db_events = list(
+            session.query(Events).filter(Events.event_type == "custom_event")
+        )
+        assert len(db_events) == 1
+        assert db_events[0].to_native().data == {"some": "data"}
+
+    assert entity_id not in instance._bulk_writer.old_state_ids
+
+
 async def test_saving_many_states(
     hass: HomeAssistant, async_setup_recorder_instance: SetupRecorderInstanceT
 ):
@@ -173,6 +222,84 @@ async def test_saving_many_states(
         assert db_states[0].event_id > 0
 
 
+@pytest.mark.parametrize("bulk_insert", [False, True])
+async def test_saving_states_share_attributes(
+    hass: HomeAssistant,
+    async_setup_recorder_instance: SetupRecorderInstanceT,
+    bulk_insert,
+):
+    """Test states with the same attributes share one state_attributes row."""
+    instance = await async_setup_recorder_instance(
+        hass, {CONF_BULK_INSERT: bulk_insert}
+    )
+
+    entity_id = "test.recorder"
+    attributes = {"test_attr": 5, "test_attr_10": "nice"}
+    attributes2 = {"test_attr": 10, "test_attr_10": "mean"}
+
+    hass.states.async_set(entity_id, "on", attributes)
+    hass.states.async_set(entity_id, "off", attributes)
+    await async_wait_recording_done(hass, instance)
+    hass.states.async_set(entity_id, "on", attributes)
+    hass.states.async_set(entity_id, "on", attributes2)
+    await async_wait_recording_done(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        db_states = list(session.query(States).order_by(States.state_id))
+        assert len(db_states) == 4
+        assert all(db_state.attributes is None for db_state in db_states)
+        assert len({db_state.attributes_id for db_state in db_states[:3]}) == 1
+        assert db_states[3].attributes_id != db_states[0].attributes_id
+        assert session.query(StateAttributes).count() == 2
+        assert db_states[2].to_native().attributes == attributes
+        assert db_states[3].to_native().attributes == attributes2
+
+
+@pytest.mark.parametrize("bulk_insert", [False, True])
+async def test_saving_logbook_states(
+    hass: HomeAssistant,
+    async_setup_recorder_instance: SetupRecorderInstanceT,
+    bulk_insert,
+):
+    """Test only the state changes shown in the logbook get a logbook state."""
+    instance = await async_setup_recorder_instance(
+        hass, {CONF_BULK_INSERT: bulk_insert}
+    )
+    assert instance.logbook_states_since is not None
+
+    attributes = {"friendly_name": "Light", "icon": "mdi:lamp", "brightness": 5}
+    context = Context(user_id="user")
+    hass.states.async_set("light.kitchen", "on", attributes)
+    hass.states.async_set("sensor.temperature", "20", {"unit_of_measurement": "°C"})
+    hass.states.async_set("sensor.mode", "eco", {})
+    await async_wait_recording_done(hass, instance)
+    hass.states.async_set("light.kitchen", "off", attributes, context=context)
+    # Attribute changes are not shown
+    hass.states.async_set("light.kitchen", "off", {**attributes, "brightness": 2})
+    hass.states.async_set("sensor.temperature", "21", {"unit_of_measurement": "°C"})
+    hass.states.async_set("sensor.mode", "comfort", {})
+    await async_wait_recording_done(hass, instance)
+    hass.states.async_remove("sensor.mode")
+    await async_wait_recording_done(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        rows = list(
+            session.query(LogbookStates).order_by(LogbookStates.logbook_state_id)
+        )
+        assert [(row.entity_id, row.domain, row.state) for row in rows] == [
+            ("light.kitchen", "light", "off"),
+            ("sensor.mode", "sensor", "comfort"),
+        ]
+        assert rows[0].attributes == '{"friendly_name":"Light","icon":"mdi:lamp"}'
+        assert rows[0].context_id == context.id
+        assert rows[0].context_user_id == "user"
+        event = session.query(Events).filter_by(event_id=rows[0].event_id).one()
+        assert event.context_id == context.id
+        assert process_timestamp(rows[0].time_fired) == process_timestamp(
+            event.time_fired
+        )
+
+
 async def test_saving_state_with_intermixed_time_changes(
     hass: HomeAssistant, async_setup_recorder_instance: SetupRecorderInstanceT
 ):
@@ -1035,6 +1162,32 @@ def test_service_disable_run_information_recorded(tmpdir):
     hass.stop()
 
 
+def test_read_only_sessions_use_read_pool(tmpdir):
+    """Test reads of an sqlite database file use read only connections."""
+    test_db_file = tmpdir.mkdir("sqlite").join("test_read_pool.db")
+    dburl = f"{SQLITE_URL_PREFIX}//{test_db_file}"
+
+    hass = get_test_home_assistant()
+    setup_component(hass, DOMAIN, {DOMAIN: {CONF_DB_URL: dburl}})
+    hass.start()
+    hass.states.set("test.read_pool", "on")
+    wait_recording_done(hass)
+
+    instance = hass.data[DATA_INSTANCE]
+    assert instance.read_engine is not None
+    with session_scope(hass=hass, read_only=True) as session:
+        states = list(session.query(States).filter_by(entity_id="test.read_pool"))
+        assert len(states) == 1
+        assert states[0].state == "on"
+
+    with instance.read_engine.connect() as connection, pytest.raises(
+        OperationalError
+    ):
+        connection.execute(text("DELETE FROM states"))
+
+    hass.stop()
+
+
 class CannotSerializeMe:
     """A class that the JSONEncoder cannot serialize."""
 
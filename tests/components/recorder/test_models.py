@@ -2,13 +2,14 @@
 from datetime import datetime
 
 import pytest
-from sqlalchemy import create_engine
+from sqlalchemy import create_engine, inspect
 from sqlalchemy.orm import scoped_session, sessionmaker
 
 from homeassistant.components.recorder.models import (
     Base,
     Events,
     RecorderRuns,
+    StateAttributes,
     States,
     process_timestamp,
     process_timestamp_to_utc_isoformat,
@@ -139,6 +140,24 @@ def test_states_from_native_invalid_entity_id():
     assert state.entity_id == "test.invalid__id"
 
 
+def test_states_load_shared_attributes():
+    """Test the shared attributes are loaded together with the states."""
+    engine = create_engine("sqlite://")
+    Base.metadata.create_all(engine)
+    session = scoped_session(sessionmaker(bind=engine))
+
+    shared = StateAttributes(hash=1, shared_attrs='{"shared": true}')
+    session.add(
+        States(entity_id="sensor.temperature", state="20", state_attributes=shared)
+    )
+    session.commit()
+    session.expunge_all()
+
+    db_state = session.query(States).one()
+    assert "state_attributes" not in inspect(db_state).unloaded
+    assert db_state.to_native().attributes == {"shared": True}
+
+
 async def test_process_timestamp():
     """Test processing time stamp to UTC."""
     datetime_with_tzinfo = datetime(2016, 7, 9, 11, 0, 0, tzinfo=dt.UTC)
@@ -0,0 +1,153 @@
+"""Test daily partitions."""
+# pylint: disable=protected-access
+from datetime import date, datetime
+from unittest.mock import MagicMock, patch
+
+from homeassistant.components.recorder import partitions
+from homeassistant.components.recorder.models import (
+    TABLE_EVENTS,
+    TABLE_LOGBOOK_STATES,
+    TABLE_STATES,
+)
+from homeassistant.util import dt as dt_util
+
+from .common import async_recorder_block_till_done
+from .conftest import SetupRecorderInstanceT
+
+
+def _mock_session(bounds):
+    """Return a session with partitions of the given days and a catch all."""
+
+    def _execute(statement, params=None):
+        if "information_schema.PARTITIONS" not in str(statement):
+            return MagicMock()
+        if params["table"] not in bounds:
+            return []
+        return [
+            *(
+                (f"p{day:%Y%m%d}", str(day.toordinal() + 366))
+                for day in bounds[params["table"]]
+            ),
+            ("pmax", "MAXVALUE"),
+        ]
+
+    session = MagicMock()
+    session.execute.side_effect = _execute
+    return session
+
+
+def _statements(session):
+    """Return the statements other than partition lookups that were run."""
+    return [
+        str(call.args[0])
+        for call in session.execute.mock_calls
+        if "information_schema" not in str(call.args[0])
+    ]
+
+
+def test_to_days():
+    """Test days are counted like the MySQL TO_DAYS function."""
+    assert partitions._to_days(date(2007, 10, 7)) == 733321
+    assert partitions._from_days(733321) == date(2007, 10, 7)
+
+
+def test_create_future_partitions():
+    """Test the partitions for the next days are split off the catch all."""
+    session = _mock_session(
+        {table: [date(2021, 11, 1)] for table in partitions.PARTITIONED_TABLES}
+    )
+    with patch(
+        "homeassistant.components.recorder.partitions.dt_util.utcnow",
+        return_value=datetime(2021, 11, 2, 12, tzinfo=dt_util.UTC),
+    ):
+        partitions.create_future_partitions(session)
+
+    statements = _statements(session)
+    assert len(statements) == 3
+    assert statements[0] == (
+        "ALTER TABLE states REORGANIZE PARTITION pmax INTO ("
+        "PARTITION p20211102 VALUES LESS THAN (738462), "
+        "PARTITION p20211103 VALUES LESS THAN (738463), "
+        "PARTITION p20211104 VALUES LESS THAN (738464), "
+        "PARTITION p20211105 VALUES LESS THAN (738465), "
+        "PARTITION pmax VALUES LESS THAN MAXVALUE)"
+    )
+
+
+def test_setup_partitions():
+    """Test the tables are partitioned by day once."""
+    session = _mock_session({})
+    connection = session.connection.return_value
+
+    def _get_foreign_keys(table):
+        if table == TABLE_EVENTS:
+            return []
+        return [{"name": f"{table}_ibfk_1"}]
+
+    inspector = MagicMock()
+    inspector.get_foreign_keys.side_effect = _get_foreign_keys
+    with patch(
+        "homeassistant.components.recorder.partitions.sqlalchemy.inspect",
+        return_value=inspector,
+    ) as mock_inspect, patch(
+        "homeassistant.components.recorder.partitions.dt_util.utcnow",
+        return_value=datetime(2021, 11, 2, 12, tzinfo=dt_util.UTC),
+    ):
+        partitions.setup_partitions(session, 1)
+
+    mock_inspect.assert_called_with(connection)
+    statements = _statements(session)
+    assert statements[:2] == [
+        "ALTER TABLE states DROP FOREIGN KEY states_ibfk_1",
+        "ALTER TABLE logbook_states DROP FOREIGN KEY logbook_states_ibfk_1",
+    ]
+    assert statements[3] == (
+        "ALTER TABLE states DROP PRIMARY KEY, "
+        "ADD PRIMARY KEY (state_id, last_updated) "
+        "PARTITION BY RANGE (TO_DAYS(last_updated)) ("
+        "PARTITION p20211101 VALUES LESS THAN (738461), "
+        "PARTITION p20211102 VALUES LESS THAN (738462), "
+        "PARTITION p20211103 VALUES LESS THAN (738463), "
+        "PARTITION p20211104 VALUES LESS THAN (738464), "
+        "PARTITION p20211105 VALUES LESS THAN (738465), "
+        "PARTITION pmax VALUES LESS THAN MAXVALUE)"
+    )
+    assert len(statements) == 8
+
+    session = _mock_session(
+        {
+            TABLE_STATES: [date(2021, 11, 5)],
+            TABLE_LOGBOOK_STATES: [date(2021, 11, 5)],
+            TABLE_EVENTS: [date(2021, 11, 5)],
+        }
+    )
+    with patch(
+        "homeassistant.components.recorder.partitions.dt_util.utcnow",
+        return_value=datetime(2021, 11, 2, 12, tzinfo=dt_util.UTC),
+    ):
+        partitions.setup_partitions(session, 1)
+    assert _statements(session) == []
+
+
+def test_partitions_before():
+    """Test only partitions that end before the day of the cutoff are returned."""
+    session = _mock_session(
+        {TABLE_STATES: [date(2021, 11, 1), date(2021, 11, 2), date(2021, 11, 3)]}
+    )
+    before = datetime(2021, 11, 3, 4, 12, tzinfo=dt_util.UTC)
+    assert partitions.partitions_before(session, TABLE_STATES, before) == {
+        "p20211101": date(2021, 11, 2),
+        "p20211102": date(2021, 11, 3),
+    }
+    assert partitions.partitions_before(session, TABLE_EVENTS, dt_util.utcnow()) == {}
+
+
+async def test_partition_by_day_not_supported(
+    hass, async_setup_recorder_instance: SetupRecorderInstanceT, caplog
+):
+    """Test daily partitions are not used with SQLite."""
+    instance = await async_setup_recorder_instance(hass, {"partition_by_day": True})
+    await async_recorder_block_till_done(hass, instance)
+
+    assert "Daily partitions are not supported with sqlite" in caplog.text
+    assert instance._partitioned is False
@@ -10,12 +10,19 @@ from sqlalchemy.orm.session import Session
 from homeassistant.components import recorder
 from homeassistant.components.recorder import PurgeTask
 from homeassistant.components.recorder.const import MAX_ROWS_TO_PURGE
-from homeassistant.components.recorder.models import Events, RecorderRuns, States
+from homeassistant.components.recorder.models import (
+    Events,
+    LogbookStates,
+    RecorderRuns,
+    StateAttributes,
+    States,
+)
 from homeassistant.components.recorder.purge import purge_old_data
 from homeassistant.components.recorder.util import session_scope
-from homeassistant.const import EVENT_STATE_CHANGED
+from homeassistant.const import EVENT_HOMEASSISTANT_STOP, EVENT_STATE_CHANGED
 from homeassistant.core import HomeAssistant
 from homeassistant.helpers.typing import ConfigType
+from homeassistant.setup import async_setup_component
 from homeassistant.util import dt as dt_util
 
 from .common import (
@@ -85,6 +92,61 @@ async def test_purge_old_states(
         assert "test.recorder2" in instance._old_states
 
 
+async def test_purge_old_state_attributes(
+    hass: HomeAssistant, async_setup_recorder_instance: SetupRecorderInstanceT
+):
+    """Test deleting shared attributes no state refers to anymore."""
+    instance = await async_setup_recorder_instance(hass)
+    utcnow = dt_util.utcnow()
+    eleven_days_ago = utcnow - timedelta(days=11)
+
+    for timestamp, attributes in (
+        (eleven_days_ago, {"old": True}),
+        (eleven_days_ago, {"shared": True}),
+        (utcnow, {"shared": True}),
+    ):
+        with patch(
+            "homeassistant.components.recorder.dt_util.utcnow", return_value=timestamp
+        ):
+            hass.states.async_set("test.recorder2", "on", attributes)
+            await async_wait_recording_done(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        assert session.query(StateAttributes).count() == 2
+
+        purge_before = dt_util.utcnow() - timedelta(days=4)
+        finished = purge_old_data(instance, purge_before, repack=False)
+        assert not finished
+
+        assert session.query(States).count() == 1
+        state_attributes = session.query(StateAttributes)
+        assert state_attributes.count() == 1
+        assert json.loads(state_attributes[0].shared_attrs) == {"shared": True}
+
+
+async def test_purge_old_logbook_states(
+    hass: HomeAssistant, async_setup_recorder_instance: SetupRecorderInstanceT
+):
+    """Test deleting the logbook states of purged events."""
+    instance = await async_setup_recorder_instance(hass)
+
+    await _add_test_states(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        # The first state has no previous state to change from
+        logbook_states = session.query(LogbookStates)
+        assert logbook_states.count() == 5
+
+        purge_before = dt_util.utcnow() - timedelta(days=4)
+        finished = purge_old_data(instance, purge_before, repack=False)
+        assert not finished
+
+        assert {row.state for row in logbook_states} == {
+            "dontpurgeme_4",
+            "dontpurgeme_5",
+        }
+
+
 async def test_purge_old_states_encouters_database_corruption(
     hass: HomeAssistant, async_setup_recorder_instance: SetupRecorderInstanceT
 ):
@@ -442,6 +504,59 @@ async def test_purge_cutoff_date(
         assert events.filter(Events.event_type == "KEEP").count() == 1
 
 
+async def test_purge_old_data_off_recorder_thread(hass: HomeAssistant, tmp_path):
+    """Test the old data of a database file is purged off the recorder thread."""
+    db_url = f"sqlite:///{tmp_path / 'purge.db'}"
+    assert await async_setup_component(
+        hass, recorder.DOMAIN, {recorder.DOMAIN: {recorder.CONF_DB_URL: db_url}}
+    )
+    await hass.async_block_till_done()
+    instance = hass.data[recorder.DATA_INSTANCE]
+
+    eleven_days_ago = dt_util.utcnow() - timedelta(days=11)
+    with patch(
+        "homeassistant.components.recorder.dt_util.utcnow",
+        return_value=eleven_days_ago,
+    ):
+        hass.states.async_set("test.unchanged", "on")
+        await async_wait_recording_done(hass, instance)
+    await _add_test_states(hass, instance)
+
+    with patch.object(instance, "queue_purge_remaining") as queue_purge_remaining:
+        await hass.services.async_call(
+            recorder.DOMAIN, recorder.SERVICE_PURGE, {"keep_days": 4}
+        )
+        await hass.async_block_till_done()
+        await async_wait_purge_done(hass, instance)
+
+    assert queue_purge_remaining.call_count == 1
+
+    # The latest state of an entity is left for the recorder thread, since
+    # the next state of the entity links to it
+    with session_scope(hass=hass) as session:
+        assert {state.state for state in session.query(States)} == {
+            "on",
+            "dontpurgeme_4",
+            "dontpurgeme_5",
+        }
+        events = session.query(Events).filter(Events.event_type == EVENT_STATE_CHANGED)
+        assert events.count() == 3
+    assert "test.unchanged" in instance._old_states
+
+    instance.queue_purge_remaining(*queue_purge_remaining.call_args[0])
+    await async_wait_purge_done(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        assert {state.state for state in session.query(States)} == {
+            "dontpurgeme_4",
+            "dontpurgeme_5",
+        }
+    assert "test.unchanged" not in instance._old_states
+
+    hass.bus.async_fire(EVENT_HOMEASSISTANT_STOP)
+    await hass.async_block_till_done()
+
+
 async def test_purge_filtered_states(
     hass: HomeAssistant,
     async_setup_recorder_instance: SetupRecorderInstanceT,
@@ -587,6 +702,55 @@ async def test_purge_filtered_states(
         assert session.query(States).get(74).old_state_id == 62  # should have been kept
 
 
+async def test_purge_filtered_states_domain_and_glob(
+    hass: HomeAssistant,
+    async_setup_recorder_instance: SetupRecorderInstanceT,
+):
+    """Test states excluded by domain and glob are purged with a SQL predicate."""
+    config: ConfigType = {
+        "exclude": {"domains": ["binary_sensor"], "entity_globs": ["sensor.*_excluded"]}
+    }
+    instance = await async_setup_recorder_instance(hass, config)
+    assert instance.entity_filter.supports_sql
+
+    entity_ids = (
+        "binary_sensor.door",
+        "binaryxsensor.door",
+        "sensor.kitchen_excluded",
+        "sensor.kitchen_excluded_not",
+        "sensor.keep",
+    )
+
+    def _add_db_entries(hass: HomeAssistant) -> None:
+        with recorder.session_scope(hass=hass) as session:
+            timestamp = dt_util.utcnow() - timedelta(days=1)
+            for event_id, entity_id in enumerate(entity_ids, 1000):
+                _add_state_and_state_changed_event(
+                    session, entity_id, "state", timestamp, event_id
+                )
+
+    _add_db_entries(hass)
+
+    await hass.services.async_call(
+        recorder.DOMAIN, recorder.SERVICE_PURGE, {"keep_days": 10, "apply_filter": True}
+    )
+    await hass.async_block_till_done()
+    await async_recorder_block_till_done(hass, instance)
+    await async_wait_purge_done(hass, instance)
+
+    with session_scope(hass=hass) as session:
+        remaining = {state.entity_id for state in session.query(States)}
+        assert remaining == {
+            "binaryxsensor.door",
+            "sensor.kitchen_excluded_not",
+            "sensor.keep",
+        }
+        events_state_changed = session.query(Events).filter(
+            Events.event_type == EVENT_STATE_CHANGED
+        )
+        assert events_state_changed.count() == 3
+
+
 async def test_purge_filtered_events(
     hass: HomeAssistant,
     async_setup_recorder_instance: SetupRecorderInstanceT,
@@ -13,9 +13,11 @@ from homeassistant.components.recorder.models import (
     process_timestamp_to_utc_isoformat,
 )
 from homeassistant.components.recorder.statistics import (
+    ShortTermStatisticsSummary,
     get_last_statistics,
     statistics_during_period,
 )
+from homeassistant.components.recorder.util import session_scope
 from homeassistant.const import TEMP_CELSIUS
 from homeassistant.setup import setup_component
 import homeassistant.util.dt as dt_util
@@ -301,6 +303,106 @@ def test_statistics_duplicated(hass_recorder, caplog):
         caplog.clear()
 
 
+def test_statistics_states_match_database(hass_recorder):
+    """Test the states kept for compiling statistics match the database."""
+    hass = hass_recorder()
+    instance = hass.data[DATA_INSTANCE]
+    setup_component(hass, "sensor", {})
+    zero, four, _ = record_states(hass)
+    entity_ids = ["sensor.test1", "sensor.test2", "sensor.test3"]
+
+    def _states(result):
+        return {
+            entity_id: [(state.state, state.last_updated) for state in states]
+            for entity_id, states in result.items()
+        }
+
+    periods = (
+        (zero, four, entity_ids),
+        (zero + timedelta(seconds=10), four, ["sensor.test3"]),
+        (
+            zero + timedelta(seconds=100),
+            zero + timedelta(seconds=200),
+            ["sensor.test3"],
+        ),
+    )
+    with session_scope(hass=hass) as session:
+        for start, end, expected_missing in periods:
+            for significant_changes_only in (True, False):
+                kept, missing = instance.statistics_states.states_during_period(
+                    entity_ids, start, end, significant_changes_only
+                )
+                assert missing == expected_missing
+                assert len(kept) == 3 - len(missing)
+
+                database = history.get_significant_states_with_session(
+                    hass,
+                    session,
+                    start - timedelta.resolution,
+                    end,
+                    entity_ids=entity_ids,
+                    significant_changes_only=significant_changes_only,
+                )
+                states = history.get_statistics_states_with_session(
+                    hass, session, start, end, entity_ids, significant_changes_only
+                )
+                assert _states(states) == _states(database)
+
+    # Periods before the kept states are read from the database
+    instance.statistics_states.prune(four)
+    _, missing = instance.statistics_states.states_during_period(
+        entity_ids, zero + timedelta(seconds=10), four, True
+    )
+    assert missing == entity_ids
+
+
+def test_short_term_statistics_summary():
+    """Test summarizing the 5-minute statistics of an hour in memory."""
+    summary = ShortTermStatisticsSummary()
+    hour = dt_util.utcnow().replace(minute=0, second=0, microsecond=0)
+    for i in range(12):
+        start = hour + timedelta(minutes=5 * i)
+        assert summary.hourly_summary(start) is None
+        summary.add(
+            start,
+            [
+                (1, {"start": start, "mean": i, "min": i - 1, "max": i + 1}),
+                (2, {"start": start, "last_reset": None, "state": i, "sum": i * 2}),
+            ],
+        )
+
+    last_period = hour + timedelta(minutes=55)
+    assert summary.hourly_summary(last_period) == {
+        1: {
+            "start": hour,
+            "mean": 5.5,
+            "min": -1,
+            "max": 12,
+            "last_reset": None,
+            "state": None,
+            "sum": None,
+        },
+        2: {
+            "start": hour,
+            "mean": None,
+            "min": None,
+            "max": None,
+            "last_reset": None,
+            "state": 11,
+            "sum": 22,
+        },
+    }
+
+    # A period that was not saved is summarized by the database
+    summary.discard(hour + timedelta(minutes=5))
+    assert summary.hourly_summary(last_period) is None
+
+    # Periods of a new hour replace the old ones
+    summary.add(hour + timedelta(hours=1), [])
+    summary.add(hour + timedelta(minutes=5), [])
+    assert summary.hourly_summary(last_period) is None
+
+
 def record_states(hass):
     """Record some test states.
 
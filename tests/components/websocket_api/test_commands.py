@@ -1,13 +1,13 @@
 """Tests for WebSocket API commands."""
 import datetime
-from unittest.mock import ANY, patch
+from unittest.mock import ANY, Mock, patch
 
 from async_timeout import timeout
 import pytest
 import voluptuous as vol
 
 from homeassistant.bootstrap import SIGNAL_BOOTSTRAP_INTEGRATONS
-from homeassistant.components.websocket_api import const
+from homeassistant.components.websocket_api import broadcast, const
 from homeassistant.components.websocket_api.auth import (
     TYPE_AUTH,
     TYPE_AUTH_OK,
@@ -459,6 +459,30 @@ async def test_ping(websocket_client):
     assert msg["type"] == "pong"
 
 
+async def test_metrics(hass, websocket_client, hass_admin_user):
+    """Test the metrics command enables and returns the metrics."""
+    assert not hass.metrics.enabled
+    await websocket_client.send_json({"id": 5, "type": "metrics"})
+
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 5
+    assert msg["type"] == const.TYPE_RESULT
+    assert msg["success"]
+    assert hass.metrics.enabled
+    assert msg["result"]["executor_queue_depth"]["type"] == "gauge"
+    backlog = msg["result"]["websocket_send_backlog"]
+    assert backlog["label"] == "connection"
+    assert len(backlog["samples"]) == 1
+
+    hass_admin_user.groups = []
+    await websocket_client.send_json({"id": 6, "type": "metrics"})
+
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 6
+    assert not msg["success"]
+    assert msg["error"]["code"] == const.ERR_UNAUTHORIZED
+
+
 async def test_call_service_context_with_user(
     hass, hass_client_no_auth, hass_access_token
 ):
@@ -576,6 +600,105 @@ async def test_subscribe_unsubscribe_events_whitelist(
     assert event["origin"] == "LOCAL"
 
 
+async def test_supported_features_coalesce_messages(hass, websocket_client):
+    """Test pending messages are sent as one array once the client opts in."""
+    await websocket_client.send_json(
+        {
+            "id": 5,
+            "type": "supported_features",
+            "features": {const.FEATURE_COALESCE_MESSAGES: 1},
+        }
+    )
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 5
+    assert msg["success"]
+
+    await websocket_client.send_json(
+        {"id": 6, "type": "subscribe_events", "event_type": "test_event"}
+    )
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 6
+    assert msg["success"]
+
+    hass.bus.async_fire("test_event", {"count": 1})
+    hass.bus.async_fire("test_event", {"count": 2})
+
+    msg = await websocket_client.receive_json()
+    assert isinstance(msg, list)
+    assert [item["event"]["data"]["count"] for item in msg] == [1, 2]
+
+
+async def test_subscribe_events_shares_bus_listener(
+    hass, websocket_client, hass_ws_client
+):
+    """Test subscriptions of several connections share one bus listener."""
+    init_count = sum(hass.bus.async_listeners().values())
+    second_client = await hass_ws_client(hass)
+
+    for client, msg_id in (
+        (websocket_client, 5),
+        (websocket_client, 6),
+        (second_client, 5),
+    ):
+        await client.send_json(
+            {"id": msg_id, "type": "subscribe_events", "event_type": "state_changed"}
+        )
+        msg = await client.receive_json()
+        assert msg["success"]
+
+    assert sum(hass.bus.async_listeners().values()) == init_count + 1
+
+    hass.states.async_set_many([("light.one", "on", None), ("light.two", "on", None)])
+
+    received = []
+    for _ in range(4):
+        msg = await websocket_client.receive_json()
+        received.append((msg["id"], msg["event"]["data"]["entity_id"]))
+    assert sorted(received) == [
+        (5, "light.one"),
+        (5, "light.two"),
+        (6, "light.one"),
+        (6, "light.two"),
+    ]
+    for entity_id in ("light.one", "light.two"):
+        msg = await second_client.receive_json()
+        assert msg["id"] == 5
+        assert msg["event"]["data"]["entity_id"] == entity_id
+
+    for msg_id in (5, 6):
+        await websocket_client.send_json(
+            {"id": msg_id + 2, "type": "unsubscribe_events", "subscription": msg_id}
+        )
+        msg = await websocket_client.receive_json()
+        assert msg["success"]
+    assert sum(hass.bus.async_listeners().values()) == init_count + 1
+
+    await second_client.send_json(
+        {"id": 6, "type": "unsubscribe_events", "subscription": 5}
+    )
+    msg = await second_client.receive_json()
+    assert msg["success"]
+    assert sum(hass.bus.async_listeners().values()) == init_count
+
+
+async def test_subscribe_events_unsubscribe_twice(hass, hass_admin_user):
+    """Test removing a broadcast subscription twice does nothing."""
+    init_count = sum(hass.bus.async_listeners().values())
+    connection = Mock(user=hass_admin_user)
+    unsub = broadcast.async_subscribe_events(hass, connection, 5, "test_event")
+    unsub_other = broadcast.async_subscribe_events(hass, connection, 6, "test_event")
+    assert sum(hass.bus.async_listeners().values()) == init_count + 1
+
+    unsub()
+    unsub()
+    assert sum(hass.bus.async_listeners().values()) == init_count + 1
+
+    unsub_other()
+    unsub_other()
+    unsub()
+    assert sum(hass.bus.async_listeners().values()) == init_count
+
+
 async def test_subscribe_unsubscribe_events_state_changed(
     hass, websocket_client, hass_admin_user
 ):
@@ -602,6 +725,132 @@ async def test_subscribe_unsubscribe_events_state_changed(
     assert msg["event"]["data"]["entity_id"] == "light.permitted"
 
 
+async def test_subscribe_entities(hass, websocket_client, hass_admin_user):
+    """Test subscribe_entities sends a snapshot and then only the changes."""
+    hass_admin_user.groups = []
+    hass_admin_user.mock_policy(
+        {
+            "entities": {
+                "entity_ids": {
+                    "light.permitted": True,
+                    "light.kitchen": True,
+                    "sensor.hidden_permitted": True,
+                }
+            }
+        }
+    )
+    hass.states.async_set("light.permitted", "off", {"color": "red"})
+    hass.states.async_set("light.not_permitted", "off")
+    hass.states.async_set("switch.other", "off")
+
+    await websocket_client.send_json(
+        {
+            "id": 7,
+            "type": "subscribe_entities",
+            "entity_ids": ["light.*", "sensor.hidden_permitted"],
+        }
+    )
+
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 7
+    assert msg["type"] == const.TYPE_RESULT
+    assert msg["success"]
+
+    state = hass.states.get("light.permitted")
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 7
+    assert msg["type"] == "event"
+    assert msg["event"] == {
+        "a": {
+            "light.permitted": {
+                "s": "off",
+                "a": {"color": "red"},
+                "c": state.context.id,
+                "lc": state.last_changed.timestamp(),
+            }
+        }
+    }
+
+    hass.states.async_set("switch.other", "on")
+    hass.states.async_set("light.not_permitted", "on")
+    hass.states.async_set("light.permitted", "on", {"brightness": 100})
+
+    state = hass.states.get("light.permitted")
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 7
+    assert msg["event"] == {
+        "c": {
+            "light.permitted": {
+                "+": {
+                    "s": "on",
+                    "lc": state.last_changed.timestamp(),
+                    "c": state.context.id,
+                    "a": {"brightness": 100},
+                },
+                "-": {"a": ["color"]},
+            }
+        }
+    }
+
+    hass.states.async_set("sensor.hidden_permitted", "5")
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 7
+    assert list(msg["event"]) == ["a"]
+    assert msg["event"]["a"]["sensor.hidden_permitted"]["s"] == "5"
+
+    hass.states.async_remove("light.permitted")
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 7
+    assert msg["event"] == {"r": ["light.permitted"]}
+
+
+async def test_subscribe_entities_batch(hass, websocket_client):
+    """Test subscribe_entities sends one update per entity of a batch."""
+    hass.states.async_set("light.kitchen", "off", {"color": "red"})
+    hass.states.async_set("light.hall", "off")
+
+    await websocket_client.send_json(
+        {"id": 7, "type": "subscribe_entities", "entity_ids": ["light.*"]}
+    )
+    msg = await websocket_client.receive_json()
+    assert msg["success"]
+    msg = await websocket_client.receive_json()
+    assert list(msg["event"]["a"]) == ["light.kitchen", "light.hall"]
+
+    with hass.states.async_batch():
+        hass.states.async_set("light.kitchen", "on", {"color": "red"})
+        hass.states.async_set("light.kitchen", "on", {"brightness": 100})
+        hass.states.async_remove("light.hall")
+        hass.states.async_set("light.hall", "on")
+        hass.states.async_set("light.new", "on")
+        hass.states.async_remove("light.new")
+
+    kitchen = hass.states.get("light.kitchen")
+    hall = hass.states.get("light.hall")
+    msg = await websocket_client.receive_json()
+    assert msg["id"] == 7
+    assert msg["event"] == {
+        "c": {
+            "light.kitchen": {
+                "+": {
+                    "s": "on",
+                    "lc": kitchen.last_changed.timestamp(),
+                    "c": kitchen.context.id,
+                    "a": {"brightness": 100},
+                },
+                "-": {"a": ["color"]},
+            },
+            "light.hall": {
+                "+": {
+                    "s": "on",
+                    "lc": hall.last_changed.timestamp(),
+                    "c": hall.context.id,
+                },
+            },
+        }
+    }
+
+
 async def test_render_template_renders_template(hass, websocket_client):
     """Test simple template is rendered and updated."""
     hass.states.async_set("light.test", "on")
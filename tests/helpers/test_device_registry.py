@@ -389,6 +389,29 @@ async def test_removing_area_id(registry):
     assert entry_w_area != entry_wo_area
 
 
+async def test_entries_for_area(registry):
+    """Test looking up devices by area as they change."""
+    entry = registry.async_get_or_create(
+        config_entry_id="123",
+        identifiers={("bridgeid", "0123")},
+    )
+    registry.async_get_or_create(
+        config_entry_id="123",
+        identifiers={("bridgeid", "4567")},
+    )
+    assert device_registry.async_entries_for_area(registry, "12345A") == []
+
+    entry = registry.async_update_device(entry.id, area_id="12345A")
+    assert device_registry.async_entries_for_area(registry, "12345A") == [entry]
+
+    entry = registry.async_update_device(entry.id, area_id="67890B")
+    assert device_registry.async_entries_for_area(registry, "12345A") == []
+    assert registry.async_device_ids_for_area("67890B") == [entry.id]
+
+    registry.async_remove_device(entry.id)
+    assert registry.async_device_ids_for_area("67890B") == []
+
+
 async def test_deleted_device_removing_area_id(registry):
     """Make sure we can clear area id of deleted device."""
     entry = registry.async_get_or_create(
@@ -790,3 +790,50 @@ async def test_float_conversion(hass):
     state = hass.states.get("hello.world")
     assert state is not None
     assert state.state == "3.6"
+
+
+async def test_static_attributes(hass):
+    """Test static attributes are read once and unchanged attributes are shared."""
+
+    class StaticEntity(entity.Entity):
+        """Entity with static attributes."""
+
+        _static_attributes = True
+        name_calls = 0
+
+        @property
+        def name(self):
+            """Return the name and count the calls."""
+            self.name_calls += 1
+            return "Static"
+
+    ent = StaticEntity()
+    ent.hass = hass
+    ent.entity_id = "hello.world"
+    ent._attr_state = "1"
+    ent._attr_extra_state_attributes = {"dynamic": 1}
+    ent.async_write_ha_state()
+    first = hass.states.get("hello.world")
+    assert first.attributes == {"dynamic": 1, "friendly_name": "Static"}
+
+    ent._attr_state = "2"
+    ent.async_write_ha_state()
+    second = hass.states.get("hello.world")
+    assert second.state == "2"
+    assert second.attributes is first.attributes
+    assert ent.name_calls == 1
+
+    # Dynamic attributes changed in place are written
+    ent._attr_extra_state_attributes["dynamic"] = 2
+    ent.async_write_ha_state()
+    third = hass.states.get("hello.world")
+    assert third.attributes == {"dynamic": 2, "friendly_name": "Static"}
+    assert ent.name_calls == 1
+
+    # Attributes written by someone else are compared
+    hass.states.async_set("hello.world", "2", {"other": True})
+    ent.async_write_ha_state()
+    fourth = hass.states.get("hello.world")
+    assert fourth.attributes == {"dynamic": 2, "friendly_name": "Static"}
+    assert fourth.attributes is third.attributes
+    assert ent.name_calls == 1
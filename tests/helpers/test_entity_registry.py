@@ -352,6 +352,33 @@ async def test_removing_area_id(registry):
     assert entry_w_area != entry_wo_area
 
 
+async def test_entries_for_device_and_area(registry):
+    """Test looking up entities by device and area as they change."""
+    entry = registry.async_get_or_create("light", "hue", "1234", device_id="dev-1")
+    entry2 = registry.async_get_or_create("light", "hue", "5678", device_id="dev-1")
+    registry.async_update_entity(entry2.entity_id, disabled_by=er.DISABLED_USER)
+
+    assert [
+        entry.entity_id for entry in er.async_entries_for_device(registry, "dev-1")
+    ] == [entry.entity_id]
+    assert len(er.async_entries_for_device(registry, "dev-1", True)) == 2
+
+    registry.async_update_entity(entry.entity_id, device_id="dev-2", area_id="area")
+    assert registry.async_entity_ids_for_device("dev-1") == [entry2.entity_id]
+    assert registry.async_entity_ids_for_device("dev-2") == [entry.entity_id]
+    assert er.async_entries_for_area(registry, "area") == [
+        registry.async_get(entry.entity_id)
+    ]
+
+    registry.async_update_entity(entry.entity_id, new_entity_id="light.renamed")
+    assert registry.async_entity_ids_for_device("dev-2") == ["light.renamed"]
+    assert registry.async_entity_ids_for_area("area") == ["light.renamed"]
+
+    registry.async_remove("light.renamed")
+    assert registry.async_entity_ids_for_device("dev-2") == []
+    assert er.async_entries_for_area(registry, "area") == []
+
+
 @pytest.mark.parametrize("load_registries", [False])
 async def test_migration(hass):
     """Test migration from old data to new."""
@@ -1,4 +1,6 @@
 """The tests for the EntityFilter component."""
+from unittest.mock import patch
+
 from homeassistant.helpers.entityfilter import (
     FILTER_SCHEMA,
     INCLUDE_EXCLUDE_FILTER_SCHEMA,
@@ -248,3 +250,18 @@ def test_filter_schema_include_exclude():
     }
     filt = INCLUDE_EXCLUDE_FILTER_SCHEMA(conf)
     assert filt.config == conf
+
+
+def test_decisions_are_cached():
+    """Test the decision for an entity id is only made once."""
+    testfilter = generate_filter(
+        [], [], [], [], ["sensor.kitchen_*", "*.included"], ["*.excluded"]
+    )
+    assert testfilter("sensor.kitchen_temp")
+    assert testfilter("light.included")
+    assert testfilter("light.excluded") is False
+
+    with patch.object(testfilter, "_filter") as mock_filter:
+        assert testfilter("sensor.kitchen_temp")
+        assert testfilter("light.excluded") is False
+    assert not mock_filter.called
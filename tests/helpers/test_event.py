@@ -1355,6 +1355,40 @@ async def test_track_template_result_and_conditional(hass):
     assert specific_runs[2] == "on"
 
 
+async def test_track_template_result_skips_unread_changes(hass):
+    """Test changes to parts of a state the template did not read are skipped."""
+    hass.states.async_set("sensor.test", "on", {"brightness": 10, "other": 1})
+    template = Template(
+        "{{ states.sensor.test.state }} {{ state_attr('sensor.test', 'brightness') }}",
+        hass,
+    )
+    runs = []
+
+    @ha.callback
+    def run_callback(event, updates):
+        runs.append(updates.pop().result)
+
+    async_track_template_result(hass, [TrackTemplate(template, None)], run_callback)
+    await hass.async_block_till_done()
+
+    with patch.object(
+        Template, "async_render_to_info", wraps=template.async_render_to_info
+    ) as mock_render:
+        hass.states.async_set("sensor.test", "on", {"brightness": 10, "other": 2})
+        await hass.async_block_till_done()
+        assert mock_render.call_count == 0
+
+        hass.states.async_set("sensor.test", "on", {"brightness": 20, "other": 2})
+        await hass.async_block_till_done()
+        assert mock_render.call_count == 1
+
+        hass.states.async_set("sensor.test", "off", {"brightness": 20})
+        await hass.async_block_till_done()
+        assert mock_render.call_count == 2
+
+    assert runs == ["on 20", "off 20"]
+
+
 async def test_track_template_result_iterator(hass):
     """Test tracking template."""
     iterator_runs = []
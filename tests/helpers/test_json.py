@@ -4,7 +4,16 @@ from datetime import timedelta
 import pytest
 
 from homeassistant import core
-from homeassistant.helpers.json import ExtendedJSONEncoder, JSONEncoder
+from homeassistant.helpers.json import (
+    ExtendedJSONEncoder,
+    JSONBackend,
+    JSONEncoder,
+    get_json_backend,
+    json_dumps,
+    json_encoder_default,
+    json_loads,
+    set_json_backend,
+)
 from homeassistant.util import dt as dt_util
 
 
@@ -63,3 +72,62 @@ def test_trace_json_encoder(hass):
     # Default method falls back to repr(o)
     o = object()
     assert ha_json_enc.default(o) == {"__type": str(type(o)), "repr": repr(o)}
+
+
+def test_json_dumps(hass):
+    """Test serializing Home Assistant objects with json_dumps."""
+    state = core.State("test.test", "hello")
+    event = core.Event("test_event", {"hello": "world"})
+    now = dt_util.utcnow()
+
+    assert json_loads(json_dumps({"state": state, "event": event, "now": now})) == {
+        "state": json_loads(json_dumps(state.as_dict())),
+        "event": json_loads(json_dumps(event.as_dict())),
+        "now": now.isoformat(),
+    }
+    assert json_dumps({"a": [1, 2]}) == '{"a": [1, 2]}'
+    assert json_dumps({"a": [1, 2]}, compact=True) == '{"a":[1,2]}'
+    assert json_dumps({"a": 1}, indent=4) == '{\n    "a": 1\n}'
+    assert json_dumps(float("NaN")) == "NaN"
+
+    with pytest.raises(ValueError):
+        json_dumps(float("NaN"), allow_nan=False)
+
+    with pytest.raises(TypeError):
+        json_dumps(object())
+
+    assert json_dumps({"a": [1, 2]}, strict=True) == '{"a": [1, 2]}'
+    with pytest.raises(TypeError):
+        json_dumps({"now": now}, strict=True)
+    with pytest.raises(TypeError):
+        json_dumps({"milk", "beer"}, strict=True)
+
+    with pytest.raises(TypeError):
+        json_encoder_default(1)
+
+
+def test_set_json_backend():
+    """Test plugging in a different JSON backend."""
+
+    class MockJSONBackend(JSONBackend):
+        """Mock JSON backend."""
+
+        name = "mock"
+
+        def dumps(self, obj, **kwargs):
+            """Mock serializing."""
+            return "dumped"
+
+        def loads(self, data):
+            """Mock parsing."""
+            return "loaded"
+
+    original = get_json_backend()
+    set_json_backend(MockJSONBackend())
+    try:
+        assert json_dumps({"a": 1}) == "dumped"
+        assert json_loads("{}") == "loaded"
+    finally:
+        set_json_backend(original)
+
+    assert json_dumps({"a": 1}) == '{"a": 1}'
@@ -29,7 +29,9 @@ async def test_caching_data(hass):
 
     data = await RestoreStateData.async_get_instance(hass)
     await hass.async_block_till_done()
-    await data.store.async_save([state.as_dict() for state in stored_states])
+    await data.store.async_save(
+        {"states": [state.as_dict() for state in stored_states]}
+    )
 
     # Emulate a fresh load
     hass.data.pop(DATA_RESTORE_STATE_TASK)
@@ -56,7 +58,7 @@ async def test_periodic_write(hass):
     """Test that we write periodiclly but not after stop."""
     data = await RestoreStateData.async_get_instance(hass)
     await hass.async_block_till_done()
-    await data.store.async_save([])
+    await data.store.async_save({"states": []})
 
     # Emulate a fresh load
     hass.data.pop(DATA_RESTORE_STATE_TASK)
@@ -102,7 +104,7 @@ async def test_save_persistent_states(hass):
     """Test that we cancel the currently running job, save the data, and verify the perdiodic job continues."""
     data = await RestoreStateData.async_get_instance(hass)
     await hass.async_block_till_done()
-    await data.store.async_save([])
+    await data.store.async_save({"states": []})
 
     # Emulate a fresh load
     hass.data.pop(DATA_RESTORE_STATE_TASK)
@@ -167,7 +169,9 @@ async def test_hass_starting(hass):
 
     data = await RestoreStateData.async_get_instance(hass)
     await hass.async_block_till_done()
-    await data.store.async_save([state.as_dict() for state in stored_states])
+    await data.store.async_save(
+        {"states": [state.as_dict() for state in stored_states]}
+    )
 
     # Emulate a fresh load
     hass.state = CoreState.not_running
@@ -243,7 +247,7 @@ async def test_dump_data(hass):
 
     assert mock_write_data.called
     args = mock_write_data.mock_calls[0][1]
-    written_states = args[0]
+    written_states = args[0]["states"]
 
     # b0 should not be written, since it didn't extend RestoreEntity
     # b1 should be written, since it is present in the current run
@@ -269,7 +273,7 @@ async def test_dump_data(hass):
 
     assert mock_write_data.called
     args = mock_write_data.mock_calls[0][1]
-    written_states = args[0]
+    written_states = args[0]["states"]
     assert len(written_states) == 2
     assert written_states[0]["state"]["entity_id"] == "input_boolean.b3"
     assert written_states[0]["state"]["state"] == "off"
@@ -277,6 +281,80 @@ async def test_dump_data(hass):
     assert written_states[1]["state"]["state"] == "off"
 
 
+async def test_dump_reuses_unchanged_entries(hass):
+    """Test dumps store unchanged states as the entries of the last dump."""
+    entity = RestoreEntity()
+    entity.hass = hass
+    entity.entity_id = "input_boolean.b1"
+    await entity.async_internal_added_to_hass()
+    hass.states.async_set("input_boolean.b1", "on")
+
+    data = await RestoreStateData.async_get_instance(hass)
+    await hass.async_block_till_done()
+    data.last_states = {
+        "input_boolean.b2": StoredState.from_dict(
+            {
+                "entity_id": "input_boolean.b2",
+                "state": {"entity_id": "input_boolean.b2", "state": "off"},
+                "last_seen": dt_util.utcnow().isoformat(),
+            }
+        )
+    }
+
+    with patch(
+        "homeassistant.helpers.restore_state.Store.async_save"
+    ) as mock_write_data:
+        await data.async_dump_states()
+        await data.async_dump_states()
+        first, second = (call[1][0]["states"] for call in mock_write_data.mock_calls)
+        assert first[0]["entity_id"] == "input_boolean.b1"
+        assert second[0] is first[0]
+
+        # Old states are stored without decoding them
+        assert second[1] is data.last_states["input_boolean.b2"].as_dict()
+        assert data.last_states["input_boolean.b2"]._state is None
+
+        hass.states.async_set("input_boolean.b1", "off")
+        await data.async_dump_states()
+        third = mock_write_data.mock_calls[2][1][0]["states"]
+        assert third[0] is not second[0]
+        assert third[0]["state"]["state"] == "off"
+
+        # The last seen time of unchanged states is refreshed after a day
+        now = dt_util.utcnow() + timedelta(days=1)
+        with patch("homeassistant.util.dt.utcnow", return_value=now):
+            await data.async_dump_states()
+        fourth = mock_write_data.mock_calls[3][1][0]["states"]
+        assert fourth[0] is not third[0]
+        assert fourth[0]["last_seen"] == now
+
+    assert data.last_states["input_boolean.b2"].state.state == "off"
+
+
+async def test_load_version_1(hass, hass_storage):
+    """Test loading the states stored as a list."""
+    entity = RestoreEntity()
+    entity.hass = hass
+    entity.entity_id = "input_boolean.b1"
+    hass_storage[STORAGE_KEY] = {
+        "version": 1,
+        "key": STORAGE_KEY,
+        "data": [
+            {
+                "state": {"entity_id": "input_boolean.b1", "state": "on"},
+                "last_seen": dt_util.utcnow().isoformat(),
+            }
+        ],
+    }
+
+    state = await entity.async_get_last_state()
+    assert state.state == "on"
+
+    data = await RestoreStateData.async_get_instance(hass)
+    stored_state = data.last_states["input_boolean.b1"]
+    assert stored_state.as_dict()["entity_id"] == "input_boolean.b1"
+
+
 async def test_dump_error(hass):
     """Test that we cache data."""
     states = [
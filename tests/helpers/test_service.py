@@ -15,6 +15,7 @@ from homeassistant.const import (
     ATTR_ENTITY_ID,
     ENTITY_MATCH_ALL,
     ENTITY_MATCH_NONE,
+    EVENT_STATE_CHANGED,
     STATE_OFF,
     STATE_ON,
 )
@@ -29,6 +30,7 @@ from homeassistant.setup import async_setup_component
 
 from tests.common import (
     MockEntity,
+    MockEntityPlatform,
     get_test_home_assistant,
     mock_device_registry,
     mock_registry,
@@ -483,6 +485,66 @@ async def test_call_with_required_features(hass, mock_entities):
     assert all(entity in actual for entity in expected)
 
 
+async def test_call_with_batch_handler(hass, mock_entities):
+    """Test a platform batch handler gets all its entities in one call."""
+    platform = MockEntityPlatform(hass)
+    kitchen = mock_entities["light.kitchen"]
+    bedroom = mock_entities["light.bedroom"]
+    kitchen.platform = platform
+    bedroom.platform = platform
+    batch_calls = []
+
+    async def handle_batch(entities, call):
+        batch_calls.append((entities, call))
+        # The bedroom needs the regular call
+        return [bedroom]
+
+    platform.async_register_batch_service_handler(
+        "test_service", handle_batch, "test_domain"
+    )
+    test_service_mock = AsyncMock(return_value=None)
+    service_call = ha.ServiceCall("test_domain", "test_service", {"entity_id": "all"})
+    await service.entity_service_call(
+        hass, [Mock(entities=mock_entities)], test_service_mock, service_call
+    )
+
+    assert batch_calls == [([kitchen, bedroom], service_call)]
+    assert {call[0][0].entity_id for call in test_service_mock.call_args_list} == {
+        "light.living_room",
+        "light.bedroom",
+        "light.bathroom",
+    }
+
+
+async def test_call_writes_polled_states_in_batch(hass):
+    """Test the states of polling entities are written as one batch."""
+    platform = MockEntityPlatform(hass)
+    entities = [
+        MockEntity(entity_id="test_domain.one", state=STATE_ON),
+        MockEntity(entity_id="test_domain.two", state=STATE_ON),
+    ]
+    await platform.async_add_entities(entities)
+    batches = []
+    hass.bus.async_listen_batch(EVENT_STATE_CHANGED, batches.append)
+
+    async def turn_off(entity, call):
+        entity._values["state"] = STATE_OFF
+
+    await service.entity_service_call(
+        hass,
+        [platform],
+        turn_off,
+        ha.ServiceCall("test_domain", "test_service", {"entity_id": "all"}),
+    )
+    await hass.async_block_till_done()
+
+    assert len(batches) == 1
+    assert [event.data["new_state"].state for event in batches[0]] == [
+        STATE_OFF,
+        STATE_OFF,
+    ]
+
+
 async def test_call_with_both_required_features(hass, mock_entities):
     """Test service calls invoked only if entity has both features."""
     test_service_mock = AsyncMock(return_value=None)
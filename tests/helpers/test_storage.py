@@ -2,6 +2,7 @@
 import asyncio
 from datetime import timedelta
 import json
+import os
 from unittest.mock import Mock, patch
 
 import pytest
@@ -12,6 +13,7 @@ from homeassistant.const import (
 )
 from homeassistant.core import CoreState
 from homeassistant.helpers import storage
+from homeassistant.helpers.json import JSONEncoder
 from homeassistant.util import dt
 
 from tests.common import async_fire_time_changed
@@ -21,6 +23,11 @@ MOCK_KEY = "storage-test"
 MOCK_DATA = {"hello": "world"}
 MOCK_DATA2 = {"goodbye": "cruel world"}
 
+# The hass fixture mocks how stores use their files
+REAL_ASYNC_LOAD = storage.Store._async_load
+REAL_WRITE_DATA = storage.Store._write_data
+REAL_ASYNC_REMOVE = storage.Store.async_remove
+
 
 @pytest.fixture
 def store(hass):
@@ -28,6 +35,16 @@ def store(hass):
     yield storage.Store(hass, MOCK_VERSION, MOCK_KEY)
 
 
+@pytest.fixture
+def real_storage(hass, tmp_path):
+    """Fixture to read and write the files of the stores in a temporary dir."""
+    hass.config.config_dir = str(tmp_path)
+    with patch.object(storage.Store, "_async_load", REAL_ASYNC_LOAD), patch.object(
+        storage.Store, "_write_data", REAL_WRITE_DATA
+    ), patch.object(storage.Store, "async_remove", REAL_ASYNC_REMOVE):
+        yield
+
+
 async def test_loading(hass, store):
     """Test we can save and load data."""
     await store.async_save(MOCK_DATA)
@@ -279,3 +296,179 @@ async def test_migrator_transforming_config(hass, store, hass_storage):
         "version": MOCK_VERSION,
         "data": data,
     }
+
+
+async def test_saving_unserializable_data(hass, real_storage, caplog):
+    """Test stores without an encoder only write JSON types."""
+    store = storage.Store(hass, MOCK_VERSION, MOCK_KEY)
+    await store.async_save({"now": dt.utcnow()})
+    assert not os.path.exists(store.path)
+    assert "Error writing config for storage-test" in caplog.text
+
+
+async def test_write_batching(hass, hass_storage):
+    """Test delayed writes of stores due in the same window are written together."""
+    storage.async_enable_write_batching(hass, 5)
+    store = storage.Store(hass, MOCK_VERSION, MOCK_KEY)
+    store2 = storage.Store(hass, MOCK_VERSION, "storage-test-2")
+    store3 = storage.Store(hass, MOCK_VERSION, "storage-test-3")
+    now = dt.utcnow()
+
+    with patch(
+        "homeassistant.helpers.storage._write_stores", wraps=storage._write_stores
+    ) as mock_write_stores:
+        store.async_delay_save(lambda: MOCK_DATA, 1)
+        store2.async_delay_save(lambda: MOCK_DATA2, 1.5)
+        store3.async_delay_save(lambda: MOCK_DATA, 10)
+
+        # The due write is not held back, the one due within the window joins it
+        async_fire_time_changed(hass, now + timedelta(seconds=1.1))
+        await hass.async_block_till_done()
+        assert len(mock_write_stores.mock_calls) == 1
+        assert hass_storage[store.key]["data"] == MOCK_DATA
+        assert hass_storage[store2.key]["data"] == MOCK_DATA2
+        assert store3.key not in hass_storage
+
+        async_fire_time_changed(hass, now + timedelta(seconds=1.6))
+        await hass.async_block_till_done()
+        assert len(mock_write_stores.mock_calls) == 1
+
+        async_fire_time_changed(hass, now + timedelta(seconds=10.1))
+        await hass.async_block_till_done()
+        assert len(mock_write_stores.mock_calls) == 2
+        assert hass_storage[store3.key]["data"] == MOCK_DATA
+
+        # A save writes the delayed writes due within the window along
+        store2.async_delay_save(lambda: MOCK_DATA, 3)
+        await store.async_save(MOCK_DATA2)
+        assert len(mock_write_stores.mock_calls) == 3
+
+        async_fire_time_changed(hass, now + timedelta(seconds=14))
+        await hass.async_block_till_done()
+        assert len(mock_write_stores.mock_calls) == 3
+
+    assert hass_storage[store.key]["data"] == MOCK_DATA2
+    assert hass_storage[store2.key]["data"] == MOCK_DATA
+
+
+async def test_write_batching_remove(hass, real_storage):
+    """Test removing a store drops its data pending in the batch."""
+    storage.async_enable_write_batching(hass, 5)
+    store = storage.Store(hass, MOCK_VERSION, MOCK_KEY)
+    now = dt.utcnow()
+
+    store.async_delay_save(lambda: MOCK_DATA, 1)
+    await store.async_remove()
+
+    async_fire_time_changed(hass, now + timedelta(seconds=6))
+    await hass.async_block_till_done()
+    assert not os.path.exists(store.path)
+
+
+async def test_write_batching_journal(hass, real_storage):
+    """Test changed entries are appended to a journal and compacted."""
+    storage.async_enable_write_batching(hass)
+    store = storage.Store(hass, MOCK_VERSION, MOCK_KEY, journal={"items": "id"})
+    journal_path = f"{store.path}.journal"
+
+    await store.async_save({"items": [{"id": "a", "v": 1}, {"id": "b", "v": 1}]})
+    with open(store.path, encoding="utf-8") as fdesc:
+        document = fdesc.read()
+    assert not os.path.exists(journal_path)
+
+    data = {"items": [{"id": "a", "v": 2}, {"id": "c", "v": 1}]}
+    await store.async_save(data)
+    with open(store.path, encoding="utf-8") as fdesc:
+        assert fdesc.read() == document
+    with open(journal_path, encoding="utf-8") as fdesc:
+        records = [json.loads(line) for line in fdesc]
+    assert records == [
+        {
+            "seq": 1,
+            "changes": {
+                "items": {
+                    "set": [{"id": "a", "v": 2}, {"id": "c", "v": 1}],
+                    "remove": ["b"],
+                }
+            },
+        }
+    ]
+
+    # An interrupted record is ignored
+    with open(journal_path, "a", encoding="utf-8") as fdesc:
+        fdesc.write('{"seq": 2, "chan')
+    assert await storage.Store(
+        hass, MOCK_VERSION, MOCK_KEY, journal={"items": "id"}
+    ).async_load() == data
+
+    # A record that does not match the lists stops the replay
+    with open(journal_path, "w", encoding="utf-8") as fdesc:
+        fdesc.write(json.dumps(records[0]) + "\n")
+        fdesc.write('{"seq": 2, "changes": {"unknown": {"set": [], "remove": []}}}\n')
+        fdesc.write('{"seq": 3, "changes": {"items": {"set": [{"id": "d"}]}}}\n')
+    assert await storage.Store(
+        hass, MOCK_VERSION, MOCK_KEY, journal={"items": "id"}
+    ).async_load() == data
+
+    # Changes outside of the lists write the document again
+    data = {"items": [{"id": "c", "v": 1}], "other": True}
+    await store.async_save(data)
+    assert not os.path.exists(journal_path)
+    with open(store.path, encoding="utf-8") as fdesc:
+        assert json.load(fdesc)["journal_seq"] == 1
+
+    assert await storage.Store(
+        hass, MOCK_VERSION, MOCK_KEY, journal={"items": "id"}
+    ).async_load() == data
+
+    # The journal is compacted after a number of records
+    with patch.object(storage, "JOURNAL_MAX_RECORDS", 1):
+        await store.async_save({"items": [], "other": True})
+        assert os.path.exists(journal_path)
+        await store.async_save({"items": [{"id": "d"}], "other": True})
+        assert not os.path.exists(journal_path)
+
+    # Entries that are changed in place and saved again are journaled
+    data = {"items": [{"id": "d", "v": 1}], "other": True}
+    await store.async_save(data)
+    data["items"][0]["v"] = 2
+    await store.async_save(data)
+    data["items"][0]["v"] = 3
+    await store.async_save(data)
+    with open(journal_path, encoding="utf-8") as fdesc:
+        records = [json.loads(line) for line in fdesc]
+    assert [record["changes"]["items"]["set"] for record in records] == [
+        [{"id": "d", "v": 1}],
+        [{"id": "d", "v": 2}],
+        [{"id": "d", "v": 3}],
+    ]
+    assert await storage.Store(
+        hass, MOCK_VERSION, MOCK_KEY, journal={"items": "id"}
+    ).async_load() == {"items": [{"id": "d", "v": 3}], "other": True}
+
+
+async def test_write_batching_journal_uncopyable(hass, real_storage):
+    """Test entries that can not be copied are written in full."""
+
+    class Uncopyable:
+        """Object that is serialized with as_dict but can not be copied."""
+
+        def as_dict(self):
+            """Return the object as a dict."""
+            return {"uncopyable": True}
+
+        def __deepcopy__(self, memo):
+            """Fail to copy."""
+            raise TypeError
+
+    storage.async_enable_write_batching(hass)
+    store = storage.Store(
+        hass, MOCK_VERSION, MOCK_KEY, encoder=JSONEncoder, journal={"items": "id"}
+    )
+    await store.async_save({"items": [{"id": "a", "value": Uncopyable()}]})
+    await store.async_save({"items": [{"id": "b", "value": Uncopyable()}]})
+    assert not os.path.exists(f"{store.path}.journal")
+    with open(store.path, encoding="utf-8") as fdesc:
+        assert json.load(fdesc)["data"] == {
+            "items": [{"id": "b", "value": {"uncopyable": True}}]
+        }
@@ -2693,6 +2693,117 @@ async def test_cache_garbage_collection():
     )  # pylint: disable=protected-access
 
 
+async def test_compiled_template_shared(hass):
+    """Test templates with the same source share the compiled template."""
+    template_string = "{{ 1 + 1 }}"
+    tpl = template.Template(template_string, hass)
+    tpl2 = template.Template(template_string, hass)
+
+    assert tpl.async_render() == 2
+    assert tpl2.async_render() == 2
+    assert tpl._compiled is tpl2._compiled  # pylint: disable=protected-access
+
+    # Limited templates are bound to another environment
+    tpl3 = template.Template(template_string, hass)
+    assert tpl3.async_render(limited=True) == 2
+    assert tpl3._compiled is not tpl._compiled  # pylint: disable=protected-access
+
+
+async def test_render_info_entity_reads(hass):
+    """Test the parts of a state read during a render are recorded."""
+    hass.states.async_set("sensor.test", "23", {"unit": "beers", "other": 1})
+    hass.states.async_set("light.test", "on", {"brightness": 100})
+    old_sensor = hass.states.get("sensor.test")
+    old_light = hass.states.get("light.test")
+
+    info = template.Template(
+        "{{ states.sensor.test.state }}"
+        " {{ state_attr('light.test', 'brightness') }}",
+        hass,
+    ).async_render_to_info()
+    assert info.result() == "23 100"
+    assert info.entity_reads["sensor.test"].properties == {"state"}
+    assert info.entity_reads["light.test"].attributes == {"brightness"}
+
+    hass.states.async_set("sensor.test", "23", {"unit": "beers", "other": 2})
+    hass.states.async_set("light.test", "on", {"brightness": 100, "color": "red"})
+    new_sensor = hass.states.get("sensor.test")
+    new_light = hass.states.get("light.test")
+    assert not info.state_change_affects_render("sensor.test", old_sensor, new_sensor)
+    assert not info.state_change_affects_render("light.test", old_light, new_light)
+    assert info.state_change_affects_render("sensor.test", old_sensor, None)
+    assert info.state_change_affects_render("sensor.other", old_sensor, new_sensor)
+
+    hass.states.async_set("light.test", "on", {"brightness": 50})
+    assert info.state_change_affects_render(
+        "light.test", new_light, hass.states.get("light.test")
+    )
+
+    # Reading all attributes compares all of them
+    info = template.Template(
+        "{{ states.sensor.test.attributes.unit }}", hass
+    ).async_render_to_info()
+    assert info.entity_reads["sensor.test"].properties == {"attributes"}
+    assert info.state_change_affects_render("sensor.test", old_sensor, new_sensor)
+
+
+async def test_aggregate_states(hass):
+    """Test the aggregation functions and filters over states."""
+    hass.states.async_set("light.kitchen", "on", {"brightness": 100})
+    hass.states.async_set("light.hallway", "off", {"brightness": 0})
+    hass.states.async_set("light.porch", "on", {"brightness": 50})
+    hass.states.async_set("sensor.one", "2")
+    hass.states.async_set("sensor.two", "4.5")
+    hass.states.async_set("sensor.three", "unavailable")
+
+    for tpl, result in (
+        ("{{ count_states('light') }}", 3),
+        ("{{ count_states('light', 'on') }}", 2),
+        ("{{ 'light' | count_states('on', 'off') }}", 3),
+        ("{{ count_states(['light.kitchen', 'light.missing'], 'on') }}", 1),
+        ("{{ sum_states('sensor') }}", 6.5),
+        ("{{ sum_states('light', 'brightness') }}", 150.0),
+        ("{{ average_states('light', 'brightness') }}", 50.0),
+        ("{{ ['sensor.one', 'sensor.two'] | average_states }}", 3.25),
+        ("{{ min_states('sensor') }}", 2.0),
+        ("{{ max_states('light', 'brightness') }}", 100.0),
+        ("{{ max_states('switch') }}", None),
+        ("{{ average_states('switch', default=0) }}", 0),
+        ("{{ expand('light.porch') | sum_states('brightness') }}", 50.0),
+    ):
+        assert template.Template(tpl, hass).async_render() == result
+
+    with pytest.raises(TemplateError):
+        template.Template("{{ count_states('bad domain') }}", hass).async_render()
+
+
+async def test_aggregate_states_render_info(hass):
+    """Test the aggregation functions collect the entities they read."""
+    hass.states.async_set("light.kitchen", "on", {"brightness": 100})
+    hass.states.async_set("light.hallway", "off")
+
+    info = template.Template(
+        "{{ count_states('light', 'on') }}", hass
+    ).async_render_to_info()
+    assert_result_info(info, 1, ["light.kitchen", "light.hallway"], [])
+    assert info.domains_lifecycle == {"light"}
+    assert info.entity_reads["light.kitchen"].properties == {"state"}
+    assert info.rate_limit == template.DOMAIN_STATES_RATE_LIMIT
+
+    info = template.Template(
+        "{{ max_states(['light.kitchen', 'light.missing'], 'brightness') }}", hass
+    ).async_render_to_info()
+    assert_result_info(info, 100.0, ["light.kitchen", "light.missing"])
+    assert not info.domains_lifecycle
+    assert info.entity_reads["light.kitchen"].attributes == {"brightness"}
+    assert info.rate_limit is None
+
+    with pytest.raises(TemplateError):
+        template.Template("{{ count_states('light') }}", hass).async_render(
+            limited=True
+        )
+
+
 def test_is_template_string():
     """Test is template string."""
     assert template.is_template_string("{{ x }}") is True
@@ -11,6 +11,7 @@ from homeassistant import bootstrap, core, runner
 from homeassistant.bootstrap import SIGNAL_BOOTSTRAP_INTEGRATONS
 import homeassistant.config as config_util
 from homeassistant.exceptions import HomeAssistantError
+from homeassistant.helpers import storage
 from homeassistant.helpers.dispatcher import async_dispatcher_connect
 import homeassistant.util.dt as dt_util
 
@@ -96,6 +97,7 @@ async def test_empty_setup(hass):
     await bootstrap.async_from_config_dict({}, hass)
     for domain in bootstrap.CORE_INTEGRATIONS:
         assert domain in hass.config.components, domain
+    assert storage.STORAGE_WRITER in hass.data
 
 
 async def test_core_failure_loads_safe_mode(hass, caplog):
@@ -213,6 +215,103 @@ async def test_setup_after_deps_in_stage_1_ignored(hass):
     assert order == ["cloud", "an_after_dep", "normal_integration"]
 
 
+@pytest.mark.parametrize("load_registries", [False])
+async def test_setup_stage_1_does_not_wait_for_stage_2_after_deps(hass):
+    """Test stage 1 does not wait for an after dependency in stage 2."""
+    # This test relies on this
+    assert "cloud" in bootstrap.STAGE_1_INTEGRATIONS
+    order = []
+    cloud_done = asyncio.Event()
+
+    async def async_setup_cloud(hass, config):
+        order.append("cloud")
+        cloud_done.set()
+        return True
+
+    async def async_setup_normal_integration(hass, config):
+        await cloud_done.wait()
+        order.append("normal_integration")
+        return True
+
+    mock_integration(
+        hass,
+        MockModule(
+            domain="cloud",
+            async_setup=async_setup_cloud,
+            partial_manifest={"after_dependencies": ["normal_integration"]},
+        ),
+    )
+    mock_integration(
+        hass,
+        MockModule(
+            domain="normal_integration",
+            async_setup=async_setup_normal_integration,
+        ),
+    )
+
+    await bootstrap._async_set_up_integrations(
+        hass, {"cloud": {}, "normal_integration": {}}
+    )
+
+    assert order == ["cloud", "normal_integration"]
+    assert hass.data[bootstrap.DATA_SETUP_CRITICAL_PATH]["cloud"]["gated_by"] is None
+
+
+@pytest.mark.parametrize("load_registries", [False])
+async def test_setup_stage_2_does_not_wait_for_stage_1(hass):
+    """Test stage 2 only waits for the stage 1 integrations it comes after."""
+    # This test relies on this
+    assert "cloud" in bootstrap.STAGE_1_INTEGRATIONS
+    order = []
+    normal_integration_done = asyncio.Event()
+
+    def gen_domain_setup(domain):
+        async def async_setup(hass, config):
+            if domain == "cloud":
+                await normal_integration_done.wait()
+            order.append(domain)
+            if domain == "normal_integration":
+                normal_integration_done.set()
+            return True
+
+        return async_setup
+
+    mock_integration(
+        hass,
+        MockModule(domain="cloud", async_setup=gen_domain_setup("cloud")),
+    )
+    mock_integration(
+        hass,
+        MockModule(
+            domain="normal_integration",
+            async_setup=gen_domain_setup("normal_integration"),
+        ),
+    )
+    mock_integration(
+        hass,
+        MockModule(
+            domain="after_cloud",
+            async_setup=gen_domain_setup("after_cloud"),
+            partial_manifest={"after_dependencies": ["cloud"]},
+        ),
+    )
+
+    await bootstrap._async_set_up_integrations(
+        hass, {"cloud": {}, "normal_integration": {}, "after_cloud": {}}
+    )
+
+    assert order == ["normal_integration", "cloud", "after_cloud"]
+    critical_path = hass.data[bootstrap.DATA_SETUP_CRITICAL_PATH]
+    assert critical_path["normal_integration"]["gated_by"] is None
+    assert critical_path["cloud"]["gated_by"] is None
+    assert critical_path["after_cloud"]["gated_by"] == "cloud"
+    assert critical_path["after_cloud"]["ready"] >= critical_path["cloud"]["done"]
+    assert bootstrap._critical_path(critical_path, "after_cloud") == [
+        "cloud",
+        "after_cloud",
+    ]
+
+
 @pytest.mark.parametrize("load_registries", [False])
 async def test_setup_after_deps_via_platform(hass):
     """Test after_dependencies set up via platform."""
@@ -431,6 +431,146 @@ async def test_eventbus_filtered_listener(hass):
     unsub()
 
 
+async def test_eventbus_keyed_listener(hass):
+    """Test we can listen for events indexed by an event data value."""
+    calls = []
+    init_count = sum(hass.bus.async_listeners().values())
+
+    @ha.callback
+    def listener(event):
+        """Mock listener."""
+        calls.append(event)
+
+    unsub = hass.bus.async_listen_keyed(
+        "test", "entity_id", ["light.kitchen", "light.hall"], listener
+    )
+    assert sum(hass.bus.async_listeners().values()) == init_count + 1
+
+    hass.bus.async_fire("test", {"entity_id": "light.kitchen"})
+    hass.bus.async_fire("test", {"entity_id": "light.hall"})
+    hass.bus.async_fire("test", {"entity_id": "light.other"})
+    hass.bus.async_fire("test", {"entity_id": ["light.kitchen"]})
+    hass.bus.async_fire("test")
+    hass.bus.async_fire("other", {"entity_id": "light.kitchen"})
+    await hass.async_block_till_done()
+
+    assert [event.data["entity_id"] for event in calls] == [
+        "light.kitchen",
+        "light.hall",
+    ]
+    assert "light.kitchen" in hass.bus.async_keyed_listeners("test", "entity_id")
+
+    unsub()
+    assert sum(hass.bus.async_listeners().values()) == init_count
+    assert "light.kitchen" not in hass.bus.async_keyed_listeners("test", "entity_id")
+
+    hass.bus.async_fire("test", {"entity_id": "light.kitchen"})
+    await hass.async_block_till_done()
+    assert len(calls) == 2
+
+    # Should do nothing now
+    unsub()
+
+    with pytest.raises(ha.HomeAssistantError):
+        hass.bus.async_listen_keyed(MATCH_ALL, "entity_id", ["light.a"], listener)
+
+
+async def test_eventbus_keyed_listener_order(hass, caplog):
+    """Test keyed listeners run in the order listeners were added."""
+    calls = []
+    entity_ids = ["light.kitchen"]
+
+    def record(name):
+        """Return a listener that records its name."""
+        return ha.callback(lambda event: calls.append(name))
+
+    @ha.callback
+    def failing_listener(event):
+        """Mock listener that raises."""
+        raise ValueError("boom")
+
+    hass.bus.async_listen("test", record("first"))
+    hass.bus.async_listen_keyed("test", "entity_id", entity_ids, record("a"))
+    hass.bus.async_listen("test", record("second"))
+    hass.bus.async_listen_keyed("test", "entity_id", entity_ids, failing_listener)
+    hass.bus.async_listen_keyed("test", "entity_id", entity_ids, record("b"))
+
+    hass.bus.async_fire("test", {"entity_id": "light.kitchen"})
+    await hass.async_block_till_done()
+
+    assert calls == ["first", "a", "b", "second"]
+    assert "Error while processing test event for light.kitchen" in caplog.text
+
+
+async def test_eventbus_match_all_exclude_event_types(hass):
+    """Test MATCH_ALL listeners can exclude event types."""
+    calls = []
+
+    @ha.callback
+    def listener(event):
+        """Mock listener."""
+        calls.append(event.event_type)
+
+    unsub = hass.bus.async_listen(
+        MATCH_ALL, listener, exclude_event_types=["excluded", "excluded_too"]
+    )
+    unsub_excluded = hass.bus.async_listen("excluded", lambda event: None)
+
+    hass.bus.async_fire("test")
+    hass.bus.async_fire("excluded")
+    hass.bus.async_fire("excluded_too")
+    await hass.async_block_till_done()
+    assert calls == ["test"]
+
+    unsub_excluded()
+    hass.bus.async_fire("excluded")
+    await hass.async_block_till_done()
+    assert calls == ["test"]
+
+    unsub()
+    hass.bus.async_fire("test")
+    await hass.async_block_till_done()
+    assert calls == ["test"]
+
+    with pytest.raises(ha.HomeAssistantError):
+        hass.bus.async_listen("test", listener, exclude_event_types=["excluded"])
+
+
+async def test_eventbus_match_all_dispatch_updates(hass):
+    """Test MATCH_ALL listeners added later reach existing event types."""
+    calls = []
+
+    @ha.callback
+    def listener(event):
+        """Mock listener."""
+        calls.append(("specific", event.event_type))
+
+    @ha.callback
+    def match_all_listener(event):
+        """Mock listener."""
+        calls.append(("all", event.event_type))
+
+    unsub = hass.bus.async_listen("test", listener)
+    unsub_all = hass.bus.async_listen(MATCH_ALL, match_all_listener)
+
+    hass.bus.async_fire("test")
+    hass.bus.async_fire(EVENT_HOMEASSISTANT_CLOSE)
+    await hass.async_block_till_done()
+    assert calls == [("all", "test"), ("specific", "test")]
+
+    calls.clear()
+    unsub()
+    hass.bus.async_fire("test")
+    await hass.async_block_till_done()
+    assert calls == [("all", "test")]
+
+    calls.clear()
+    unsub_all()
+    hass.bus.async_fire("test")
+    await hass.async_block_till_done()
+    assert calls == []
+
+
 async def test_eventbus_unsubscribe_listener(hass):
     """Test unsubscribe listener from returned function."""
     calls = []
@@ -665,6 +805,31 @@ async def test_statemachine_entity_ids(hass):
     assert states == ["light.bowl", "switch.ac"]
 
 
+async def test_statemachine_domain_lookups(hass):
+    """Test looking up and counting the entities of domains."""
+    hass.states.async_set("light.bowl", "on")
+    hass.states.async_set("switch.ac", "off")
+    hass.states.async_set("light.ceiling", "off")
+    hass.states.async_set("light.bowl", "off")
+
+    assert hass.states.async_entity_ids("light") == ["light.bowl", "light.ceiling"]
+    assert hass.states.async_entity_ids("LIGHT") == ["light.bowl", "light.ceiling"]
+    assert hass.states.async_entity_ids(["switch", "light", "switch"]) == [
+        "switch.ac",
+        "light.bowl",
+        "light.ceiling",
+    ]
+    assert [state.state for state in hass.states.async_all("light")] == ["off", "off"]
+    assert hass.states.async_entity_ids_count("light") == 2
+    assert hass.states.async_entity_ids_count(["light", "switch"]) == 3
+    assert hass.states.async_entity_ids("sensor") == []
+    assert hass.states.async_entity_ids_count("sensor") == 0
+
+    hass.states.async_remove("switch.ac")
+    assert hass.states.async_all("switch") == []
+    assert "switch" not in hass.states._domain_index
+
+
 async def test_statemachine_remove(hass):
     """Test remove method."""
     hass.states.async_set("light.bowl", "on", {})
@@ -728,6 +893,116 @@ async def test_statemachine_force_update(hass):
     assert len(events) == 1
 
 
+async def test_statemachine_shares_unchanged_attributes(hass):
+    """Test passing the current attributes shares them with the new state."""
+    hass.states.async_set("light.bowl", "on", {"brightness": 100})
+    old_state = hass.states.get("light.bowl")
+    events = async_capture_events(hass, EVENT_STATE_CHANGED)
+
+    hass.states.async_set("light.bowl", "on", old_state.attributes)
+    await hass.async_block_till_done()
+    assert len(events) == 0
+
+    hass.states.async_set("light.bowl", "off", old_state.attributes)
+    await hass.async_block_till_done()
+    assert len(events) == 1
+    new_state = hass.states.get("light.bowl")
+    assert new_state.attributes is old_state.attributes
+
+
+async def test_statemachine_set_many(hass):
+    """Test setting many states delivers one batch to batch listeners."""
+    hass.states.async_set("light.bowl", "on", {})
+    events = async_capture_events(hass, EVENT_STATE_CHANGED)
+    batches = []
+
+    @ha.callback
+    def batch_listener(batch):
+        """Mock batch listener."""
+        batches.append([event.data["entity_id"] for event in batch])
+
+    unsub = hass.bus.async_listen_batch(EVENT_STATE_CHANGED, batch_listener)
+
+    hass.states.async_set_many(
+        [
+            ("light.bowl", "off", None),
+            ("light.kitchen", "on", {"brightness": 100}),
+            ("light.unchanged", "on", None),
+        ]
+    )
+    await hass.async_block_till_done()
+
+    assert [event.data["entity_id"] for event in events] == [
+        "light.bowl",
+        "light.kitchen",
+        "light.unchanged",
+    ]
+    assert events[0].data["old_state"].state == "on"
+    assert batches == [["light.bowl", "light.kitchen", "light.unchanged"]]
+    assert hass.states.get("light.kitchen").attributes == {"brightness": 100}
+
+    hass.states.async_set("light.bowl", "on")
+    await hass.async_block_till_done()
+    assert batches[-1] == ["light.bowl"]
+
+    unsub()
+    hass.states.async_set_many([("light.bowl", "off", None)])
+    await hass.async_block_till_done()
+    assert len(batches) == 2
+    assert len(events) == 5
+
+
+async def test_statemachine_batch(hass):
+    """Test state changes inside a batch are held back until it exits."""
+    hass.states.async_set("light.bowl", "on")
+    events = async_capture_events(hass, EVENT_STATE_CHANGED)
+    batches = []
+
+    @ha.callback
+    def batch_listener(batch):
+        """Mock batch listener."""
+        batches.append(batch)
+
+    hass.bus.async_listen_batch(EVENT_STATE_CHANGED, batch_listener)
+
+    with hass.states.async_batch():
+        hass.states.async_set("light.bowl", "off")
+        with hass.states.async_batch():
+            hass.states.async_set("light.kitchen", "on")
+        hass.states.async_remove("light.bowl")
+        # States are applied right away
+        assert hass.states.get("light.kitchen").state == "on"
+        assert events == []
+
+    await hass.async_block_till_done()
+    assert [
+        (event.data["entity_id"], event.data["new_state"] is None) for event in events
+    ] == [("light.bowl", False), ("light.kitchen", False), ("light.bowl", True)]
+    assert len(batches) == 1
+    assert batches[0] == events
+
+
+async def test_statemachine_batch_other_tasks(hass):
+    """Test a batch held across an await only holds back its own task."""
+    events = async_capture_events(hass, EVENT_STATE_CHANGED)
+
+    async def set_other():
+        """Set a state from another task."""
+        hass.states.async_set("light.other", "on")
+
+    with hass.states.async_batch():
+        hass.states.async_set("light.bowl", "on")
+        await hass.async_create_task(set_other())
+        await asyncio.sleep(0)
+        assert [event.data["entity_id"] for event in events] == ["light.other"]
+
+    await hass.async_block_till_done()
+    assert [event.data["entity_id"] for event in events] == [
+        "light.other",
+        "light.bowl",
+    ]
+
+
 def test_service_call_repr():
     """Test ServiceCall repr."""
     call = ha.ServiceCall("homeassistant", "start")
@@ -1151,6 +1426,63 @@ def test_timer_out_of_sync(mock_monotonic, loop):
     assert abs(target - 14.2) < 0.001
 
 
+@patch("homeassistant.core.monotonic")
+def test_timer_idles_without_time_listeners(mock_monotonic, loop):
+    """Test the timer only ticks while time changed is listened to."""
+    hass = MagicMock()
+    hass.bus.async_has_listeners.return_value = False
+    mock_monotonic.side_effect = 10.2, 11.3
+
+    with patch(
+        "homeassistant.core.dt_util.utcnow",
+        return_value=datetime(2018, 12, 31, 3, 4, 5, 333333),
+    ):
+        ha._async_create_timer(hass)
+
+    assert len(hass.loop.call_later.mock_calls) == 0
+    time_listener_added = hass.bus.async_set_time_listener_added.mock_calls[0][1][0]
+
+    # A listener that does not receive time changed events was added
+    time_listener_added()
+    assert len(hass.loop.call_later.mock_calls) == 0
+
+    hass.bus.async_has_listeners.return_value = True
+    with patch(
+        "homeassistant.core.dt_util.utcnow",
+        return_value=datetime(2018, 12, 31, 3, 4, 5, 333333),
+    ):
+        time_listener_added()
+    assert len(hass.loop.call_later.mock_calls) == 1
+    _, callback, target = hass.loop.call_later.mock_calls[0][1]
+
+    # Ticking a second time does not schedule another tick
+    time_listener_added()
+    assert len(hass.loop.call_later.mock_calls) == 1
+
+    # The last listener went away before the tick
+    hass.bus.async_has_listeners.return_value = False
+    callback(target)
+    assert len(hass.bus.async_fire.mock_calls) == 0
+    assert len(hass.loop.call_later.mock_calls) == 1
+
+
+async def test_event_bus_has_listeners(hass):
+    """Test checking if events of a type reach any listener."""
+    assert not hass.bus.async_has_listeners("test_event")
+
+    unsub = hass.bus.async_listen(
+        MATCH_ALL, lambda _: None, exclude_event_types=["test_event"]
+    )
+    assert not hass.bus.async_has_listeners("test_event")
+    assert hass.bus.async_has_listeners("other_event")
+    unsub()
+
+    unsub = hass.bus.async_listen_batch("test_event", lambda _: None)
+    assert hass.bus.async_has_listeners("test_event")
+    unsub()
+    assert not hass.bus.async_has_listeners("test_event")
+
+
 async def test_hass_start_starts_the_timer(loop):
     """Test when hass starts, it starts the timer."""
     hass = ha.HomeAssistant()
@@ -1601,3 +1933,31 @@ async def test_state_change_events_match_state_time(hass):
     state = hass.states.get("light.bedroom")
 
     assert state.last_updated == events[0].time_fired
+
+
+async def test_event_listener_metrics(hass):
+    """Test callback listeners are timed once the metrics are enabled."""
+    calls = []
+
+    @ha.callback
+    def _event_listener(event):
+        calls.append(event)
+
+    hass.bus.async_listen("test_event", _event_listener)
+    hass.bus.async_fire("test_event")
+    await hass.async_block_till_done()
+    assert not hass.metrics.enabled
+    assert hass.metrics.as_dict()["event_listener_seconds"]["samples"] == []
+
+    hass.bus.async_fire("test_event")
+    await hass.async_block_till_done()
+    assert len(calls) == 2
+
+    result = hass.metrics.as_dict()
+    assert result["events_fired_total"]["samples"] == [
+        {"label": "test_event", "value": 1}
+    ]
+    samples = result["event_listener_seconds"]["samples"]
+    assert [sample["label"] for sample in samples] == ["test_event"]
+    assert samples[0]["value"]["count"] == 1
+    assert "loop_lag_seconds" in result
@@ -1,4 +1,5 @@
 """Test to verify that we can load components."""
+from datetime import timedelta
 from unittest.mock import patch
 
 import pytest
@@ -6,8 +7,15 @@ import pytest
 from homeassistant import core, loader
 from homeassistant.components import http, hue
 from homeassistant.components.hue import light as hue_light
+from homeassistant.const import __version__
+import homeassistant.util.dt as dt_util
 
-from tests.common import MockModule, async_mock_service, mock_integration
+from tests.common import (
+    MockModule,
+    async_fire_time_changed,
+    async_mock_service,
+    mock_integration,
+)
 
 
 async def test_component_dependencies(hass):
@@ -543,3 +551,52 @@ async def test_custom_integration_missing(hass, caplog):
 
         with pytest.raises(loader.IntegrationNotFound):
             await loader.async_get_integration(hass, "test1")
+
+
+async def test_manifest_cache(hass, hass_storage, enable_custom_integrations):
+    """Test manifests and dependencies are reused from the manifest cache."""
+    await loader.async_setup_manifest_cache(hass)
+    integration = await loader.async_get_integration(hass, "mobile_app")
+    assert await integration.resolve_dependencies()
+    custom = await loader.async_get_integration(hass, "test_package")
+
+    async_fire_time_changed(
+        hass,
+        dt_util.utcnow() + timedelta(seconds=loader.MANIFEST_CACHE_SAVE_DELAY + 1),
+    )
+    await hass.async_block_till_done()
+    stored = hass_storage[loader.MANIFEST_CACHE_STORAGE_KEY]["data"]
+    assert stored["ha_version"] == __version__
+
+    # Emulate a restart
+    hass.data.pop(loader.DATA_INTEGRATIONS)
+    hass.data.pop(loader.DATA_CUSTOM_COMPONENTS)
+    await loader.async_setup_manifest_cache(hass)
+
+    with patch("pathlib.Path.read_text", side_effect=AssertionError), patch(
+        "pathlib.Path.iterdir", side_effect=AssertionError
+    ), patch(
+        "homeassistant.loader._async_component_dependencies",
+        side_effect=AssertionError,
+    ):
+        cached = await loader.async_get_integration(hass, "mobile_app")
+        assert await cached.resolve_dependencies()
+        cached_custom = await loader.async_get_integration(hass, "test_package")
+
+    assert cached is not integration
+    assert cached.manifest == integration.manifest
+    assert cached.all_dependencies == integration.all_dependencies
+    assert cached_custom.manifest == custom.manifest
+
+    # The cache is dropped for another version
+    manifest_path = integration.file_path / "manifest.json"
+    file_stat = loader._file_stat(manifest_path)
+    cache = loader.ManifestCache(hass, None, stored)
+    assert cache.get_manifest(manifest_path, file_stat) is not None
+    cache = loader.ManifestCache(hass, None, {**stored, "ha_version": "0.1.0"})
+    assert cache.get_manifest(manifest_path, file_stat) is None
+
+    # A changed manifest is parsed again
+    file_stat = [file_stat[0] + 1, file_stat[1]]
+    cache = loader.ManifestCache(hass, None, stored)
+    assert cache.get_manifest(manifest_path, file_stat) is None
@@ -1,4 +1,5 @@
 """Test requirements module."""
+from datetime import timedelta
 import os
 from unittest.mock import call, patch
 
@@ -7,13 +8,19 @@ import pytest
 from homeassistant import loader, setup
 from homeassistant.requirements import (
     CONSTRAINT_FILE,
+    DATA_PKG_CACHE,
+    REQUIREMENTS_CACHE_SAVE_DELAY,
+    REQUIREMENTS_CACHE_STORAGE_KEY,
     RequirementsNotFound,
     async_clear_install_history,
     async_get_integration_with_requirements,
     async_process_requirements,
+    async_setup_requirements_cache,
+    async_verify_requirements,
 )
+import homeassistant.util.dt as dt_util
 
-from tests.common import MockModule, mock_integration
+from tests.common import MockModule, async_fire_time_changed, mock_integration
 
 
 def env_without_wheel_links():
@@ -483,3 +490,57 @@ async def test_discovery_requirements_dhcp(hass):
 
     assert len(mock_process.mock_calls) == 1  # dhcp does not depend on http
     assert mock_process.mock_calls[0][1][2] == dhcp.requirements
+
+
+async def test_verify_requirements(hass, hass_storage):
+    """Test requirements are checked up front and remembered across restarts."""
+    hass.config.skip_pip = False
+    await async_setup_requirements_cache(hass)
+    integration_1 = mock_integration(
+        hass, MockModule("comp_1", requirements=["installed==1.0", "missing==1.0"])
+    )
+    integration_2 = mock_integration(
+        hass, MockModule("comp_2", requirements=["installed==1.0"])
+    )
+
+    with patch(
+        "homeassistant.util.package.is_installed",
+        side_effect=lambda req: req == "installed==1.0",
+    ) as mock_is_installed, patch(
+        "homeassistant.util.package.install_package", return_value=True
+    ) as mock_install:
+        await async_verify_requirements(hass, [integration_1, integration_2])
+        await hass.async_block_till_done()
+
+        assert sorted(
+            mock_call[1][0] for mock_call in mock_is_installed.mock_calls
+        ) == ["installed==1.0", "missing==1.0"]
+        assert len(mock_install.mock_calls) == 1
+        assert mock_install.mock_calls[0][1][0] == "missing==1.0"
+
+        # The setups do not check the requirements again
+        mock_is_installed.reset_mock()
+        assert await setup.async_setup_component(hass, "comp_1", {})
+        assert await setup.async_setup_component(hass, "comp_2", {})
+        assert not mock_is_installed.mock_calls
+        assert len(mock_install.mock_calls) == 1
+
+    async_fire_time_changed(
+        hass, dt_util.utcnow() + timedelta(seconds=REQUIREMENTS_CACHE_SAVE_DELAY + 1)
+    )
+    await hass.async_block_till_done()
+    stored = hass_storage[REQUIREMENTS_CACHE_STORAGE_KEY]["data"]
+    assert stored["installed"] == ["installed==1.0", "missing==1.0"]
+
+    # Emulate a restart
+    hass.data.pop(DATA_PKG_CACHE)
+    await async_setup_requirements_cache(hass)
+    assert "installed==1.0" in hass.data[DATA_PKG_CACHE]
+
+    # Changed package directories are checked again
+    hass.data.pop(DATA_PKG_CACHE)
+    with patch(
+        "homeassistant.requirements._package_dirs_fingerprint", return_value={}
+    ):
+        await async_setup_requirements_cache(hass)
+    assert "installed==1.0" not in hass.data[DATA_PKG_CACHE]
@@ -0,0 +1,133 @@
+"""Tests for the metrics registry."""
+import json
+from unittest.mock import MagicMock
+
+import pytest
+
+from homeassistant.util import metrics
+
+
+def test_counter_and_gauge():
+    """Test counters add up and gauges are read when collected."""
+    registry = metrics.MetricsRegistry()
+    counter = registry.counter("events_total", "Events", "event_type")
+    assert registry.counter("events_total", "Events", "event_type") is counter
+    counter.inc(label="a")
+    counter.inc(2, label="a")
+    counter.inc(label="b")
+
+    depth = [3]
+    registry.gauge("queue_depth", "Queue depth", lambda: depth[0])
+    depth[0] = 5
+
+    assert registry.as_dict() == {
+        "events_total": {
+            "type": "counter",
+            "description": "Events",
+            "label": "event_type",
+            "samples": [{"label": "a", "value": 3}, {"label": "b", "value": 1}],
+        },
+        "queue_depth": {
+            "type": "gauge",
+            "description": "Queue depth",
+            "label": None,
+            "samples": [{"label": None, "value": 5}],
+        },
+    }
+
+    registry.remove("queue_depth")
+    assert list(registry.as_dict()) == ["events_total"]
+
+
+def test_histogram_buckets():
+    """Test the histogram buckets are cumulative and JSON serializable."""
+    registry = metrics.MetricsRegistry()
+    histogram = registry.histogram("seconds", "Seconds", buckets=(0.1, 1.0))
+    histogram.observe(0.05)
+    histogram.observe(0.1)
+    histogram.observe(0.5)
+    histogram.observe(20)
+
+    samples = registry.as_dict()["seconds"]["samples"]
+    assert samples == [
+        {
+            "label": None,
+            "value": {
+                "buckets": {"0.1": 2, "1": 3, "+Inf": 4},
+                "sum": pytest.approx(20.65),
+                "count": 4,
+            },
+        }
+    ]
+    json.dumps(samples)
+
+
+def test_enable_on_first_read():
+    """Test the enable listeners are called once on the first read."""
+    registry = metrics.MetricsRegistry()
+    listener = MagicMock()
+    registry.listen_enable(listener)
+    assert not registry.enabled
+    assert len(listener.mock_calls) == 0
+
+    registry.render_prometheus()
+    assert registry.enabled
+    assert len(listener.mock_calls) == 1
+
+    registry.as_dict()
+    assert len(listener.mock_calls) == 1
+
+    # Listeners added once enabled are called right away
+    registry.listen_enable(listener)
+    assert len(listener.mock_calls) == 2
+
+
+def test_render_prometheus():
+    """Test the Prometheus text format."""
+    registry = metrics.MetricsRegistry()
+    registry.counter("fired_total", "Fired\nevents", "event_type").inc(
+        label='say "hi"'
+    )
+    registry.histogram("lag_seconds", "Lag", buckets=(0.5,)).observe(0.25)
+
+    def fail():
+        raise ValueError
+
+    # A failing gauge is left out
+    registry.gauge("broken", "Broken", fail)
+
+    assert registry.render_prometheus() == "\n".join(
+        [
+            "# HELP homeassistant_fired_total Fired\\nevents",
+            "# TYPE homeassistant_fired_total counter",
+            'homeassistant_fired_total{event_type="say \\"hi\\""} 1.0',
+            "# HELP homeassistant_lag_seconds Lag",
+            "# TYPE homeassistant_lag_seconds histogram",
+            'homeassistant_lag_seconds_bucket{le="0.5"} 1',
+            'homeassistant_lag_seconds_bucket{le="+Inf"} 1',
+            "homeassistant_lag_seconds_sum 0.25",
+            "homeassistant_lag_seconds_count 1",
+            "",
+        ]
+    )
+
+
+def test_track_loop_lag():
+    """Test the loop lag is measured from the time the timer was due."""
+    loop = MagicMock()
+    loop.time.return_value = 100.0
+    histogram = metrics.Histogram("lag", "Lag", buckets=(0.1,))
+
+    stop = metrics.async_track_loop_lag(loop, histogram, 1.0)
+    when, measure, expected = loop.call_at.mock_calls[-1][1]
+    assert when == expected == 101.0
+
+    loop.time.return_value = 101.25
+    measure(expected)
+    assert histogram.samples() == [
+        (None, {"buckets": {"0.1": 0, "+Inf": 1}, "sum": 0.25, "count": 1})
+    ]
+    assert loop.call_at.mock_calls[-1][1][0] == 102.25
+
+    stop()
+    assert len(loop.call_at.return_value.cancel.mock_calls) == 1
@@ -0,0 +1,134 @@
+"""Tests for the timer wheel."""
+from unittest.mock import MagicMock, patch
+
+import pytest
+
+from homeassistant.util import timer_wheel
+
+
+@pytest.fixture
+def clock():
+    """Return a mutable clock used as both the wheel clock and wall time."""
+    now = [1000.0]
+    with patch("homeassistant.util.timer_wheel.time") as mock_time:
+        mock_time.time.side_effect = lambda: now[0]
+        yield now
+
+
+def _last_delay(loop):
+    """Return the delay of the last loop timer."""
+    return loop.call_later.mock_calls[-1][1][0]
+
+
+def _run(wheel, clock, now):
+    """Move the clock and run the wheel like the loop timer would."""
+    clock[0] = now
+    wheel._run()
+
+
+def test_runs_timers_in_order(clock):
+    """Test timers on different levels run at their time and in order."""
+    loop = MagicMock()
+    wheel = timer_wheel.TimerWheel(loop, lambda: clock[0])
+    calls = []
+
+    wheel.async_schedule(1100.0, calls.append, "later")
+    wheel.async_schedule(1000.5, calls.append, "first")
+    wheel.async_schedule(1000.7, calls.append, "second")
+    assert len(wheel) == 3
+    assert _last_delay(loop) == pytest.approx(0.5)
+
+    _run(wheel, clock, 1000.5)
+    assert calls == ["first"]
+    assert _last_delay(loop) == pytest.approx(0.2)
+
+    # Running early does not run the timer
+    _run(wheel, clock, 1000.6)
+    assert calls == ["first"]
+
+    _run(wheel, clock, 1000.7)
+    assert calls == ["first", "second"]
+
+    # The slot of the timer on the second level comes up before the timer
+    assert _last_delay(loop) == pytest.approx(1088.0 - 1000.7)
+    _run(wheel, clock, 1088.0)
+    assert calls == ["first", "second"]
+    assert _last_delay(loop) == pytest.approx(12.0)
+
+    _run(wheel, clock, 1100.0)
+    assert calls == ["first", "second", "later"]
+    assert len(wheel) == 0
+
+
+def test_late_run_fires_all_due_timers(clock):
+    """Test a late wakeup runs every due timer sorted by time."""
+    loop = MagicMock()
+    wheel = timer_wheel.TimerWheel(loop, lambda: clock[0])
+    calls = []
+
+    wheel.async_schedule(1000.0 + 5000, calls.append, 3)
+    wheel.async_schedule(1000.0 + 70, calls.append, 2)
+    wheel.async_schedule(1000.0 + 1, calls.append, 1)
+    wheel.async_schedule(1000.0 + 10 ** 6, calls.append, 4)
+
+    _run(wheel, clock, 1000.0 + 6000)
+    assert calls == [1, 2, 3]
+    assert len(wheel) == 1
+
+
+def test_cancel(clock):
+    """Test cancelled timers do not run."""
+    loop = MagicMock()
+    wheel = timer_wheel.TimerWheel(loop, lambda: clock[0])
+    calls = []
+
+    first = wheel.async_schedule(1001.0, calls.append, 1)
+    second = wheel.async_schedule(1001.5, calls.append, 2)
+
+    def cancel_second(_):
+        calls.append("cancel")
+        second.cancel()
+
+    wheel.async_schedule(1000.5, cancel_second, None)
+    first.cancel()
+    assert len(wheel) == 2
+
+    _run(wheel, clock, 1002.0)
+    assert calls == ["cancel"]
+    assert len(wheel) == 0
+
+    # Cancelling after the run does nothing
+    first.cancel()
+    second.cancel()
+
+
+def test_cancel_last_timer_stops_loop_timer(clock):
+    """Test the loop timer is cancelled when no timers are left."""
+    loop = MagicMock()
+    wheel = timer_wheel.TimerWheel(loop, lambda: clock[0])
+
+    timer = wheel.async_schedule(1010.0, lambda: None)
+    handle = loop.call_later.return_value
+    timer.cancel()
+
+    assert len(handle.cancel.mock_calls) == 1
+    assert len(wheel) == 0
+
+
+def test_exception_in_callback(clock):
+    """Test an exception is reported and does not stop the other timers."""
+    loop = MagicMock()
+    wheel = timer_wheel.TimerWheel(loop, lambda: clock[0])
+    calls = []
+
+    def fail():
+        raise ValueError("boom")
+
+    wheel.async_schedule(1000.1, fail)
+    wheel.async_schedule(1000.2, calls.append, 1)
+
+    _run(wheel, clock, 1000.2)
+    assert calls == [1]
+    assert len(loop.call_exception_handler.mock_calls) == 1
+    context = loop.call_exception_handler.mock_calls[0][1][0]
+    assert isinstance(context["exception"], ValueError)